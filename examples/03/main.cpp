@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+import typical.calculus;
+import typical.bytecode;
+
+using namespace typical;
+
+// ============================================================================
+// Bytecode VM vs compile-time evaluation
+// ============================================================================
+//
+// Usage: example_03 [samples]
+//
+// Evaluates the same formulas through the fused compile-time path
+// (evaluate<E>) and through the bytecode interpreter (Program::evaluate on
+// batches), and reports nanoseconds per sample and the slowdown of the VM.
+
+namespace {
+
+template <typename F>
+auto time_ns_per_sample(std::size_t samples, F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(samples);
+}
+
+template <typename E>
+void compare(const char* name, const std::vector<double>& xs) {
+    std::vector<double> fused(xs.size());
+    std::vector<double> vm(xs.size());
+    const auto program = compile<E>();
+
+    const double fused_ns = time_ns_per_sample(xs.size(), [&] {
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            fused[i] = evaluate<E>(xs[i]);
+        }
+    });
+    const double vm_ns = time_ns_per_sample(xs.size(), [&] { program.evaluate(xs, vm); });
+
+    double checksum = 0.0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        checksum += fused[i] - vm[i];
+    }
+
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << fused_ns << " ns" << std::setw(8) << vm_ns << " ns" << std::setw(8)
+              << vm_ns / fused_ns << "x" << std::setw(6) << program.instructions().size() << " ops"
+              << (checksum == 0.0 ? "" : "  (mismatch)") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 22;
+    std::vector<double> xs(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        xs[i] = 0.1 + 3.0 * static_cast<double>(i) / static_cast<double>(samples);
+    }
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Bytecode VM vs fused compile-time evaluation" << std::endl;
+    std::cout << "  " << samples << " samples, block " << Program::block << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  formula                      fused       vm   ratio" << std::endl;
+
+    compare<Add<Mul<C_<3>, X>, C_<1>>>("3x + 1", xs);
+    compare<Add<Sub<Mul<X, Mul<X, X>>, Mul<C_<2>, X>>, C_<5>>>("x^3 - 2x + 5 (as products)", xs);
+    compare<Div<Add<X, C_<1>>, Add<Mul<X, X>, C_<1>>>>("(x + 1) / (x^2 + 1)", xs);
+    compare<Mul<Sin<X>, Exp<Cos<X>>>>("sin x exp(cos x)", xs);
+    compare<derive_t<Mul<Sin<X>, Exp<Sin<X>>>>>("d/dx sin x exp(sin x)", xs);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+import typical.lambda;
+import typical.church;
+import typical.pool;
+import typical.reducer;
+
+using namespace typical;
+
+// ============================================================================
+// Parallel graph reduction scaling
+// ============================================================================
+//
+// Usage: example_04 [elements] [value]
+//
+// Normalizes Map (λn. n * n) over a Church list of numerals, a term whose
+// list elements are independent redexes, sequentially and then on pools of
+// 1, 2, 4, ... up to the number of hardware threads, and reports the time and
+// speedup of each run against the sequential reducer.
+
+namespace {
+
+auto church(TermGraph& g, std::size_t n) -> const TermNode* {
+    const TermNode* body = g.var(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        body = g.app(g.var(1), body);
+    }
+    return g.abs(g.abs(body));
+}
+
+auto squares(TermGraph& g, std::size_t count, std::size_t value) -> const TermNode* {
+    const TermNode* list = reify<Nil>(g);
+    const TermNode* cons = reify<Cons>(g);
+    for (std::size_t i = 0; i < count; ++i) {
+        list = g.app(g.app(cons, church(g, value)), list);
+    }
+    const TermNode* square = reify<Abs<App<App<Mul, Var<0>>, Var<0>>>>(g);
+    return g.app(g.app(reify<Map>(g), square), list);
+}
+
+template <typename F>
+auto time_ms(F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    const std::size_t value = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 24;
+    const std::size_t hardware = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Graph reduction: map square over " << elements << " numerals of " << value << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    TermGraph reference_graph;
+    GraphReducer reference(reference_graph);
+    const TermNode* expected = nullptr;
+    const double sequential_ms = time_ms([&] { expected = reference.normalize(squares(reference_graph, elements, value)); });
+    std::cout << "  sequential  " << std::fixed << std::setprecision(1) << std::setw(9) << sequential_ms << " ms"
+              << std::endl;
+
+    for (std::size_t threads = 1;; threads = std::min(threads * 2, hardware)) {
+        WorkStealingPool pool(threads);
+        TermGraph g;
+        GraphReducer reducer(g);
+        const TermNode* term = squares(g, elements, value);
+        const TermNode* result = nullptr;
+        const double ms = time_ms([&] { result = reducer.normalize(term, pool); });
+
+        std::cout << "  " << std::setw(3) << threads << " threads " << std::setw(9) << ms << " ms" << std::setw(7)
+                  << std::setprecision(2) << sequential_ms / ms << "x" << std::setprecision(1)
+                  << (term_equal(result, expected) ? "" : "  (mismatch)") << std::endl;
+        if (threads == hardware) {
+            break;
+        }
+    }
+    return 0;
+}
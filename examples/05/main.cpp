@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+
+import typical.lambda;
+import typical.church;
+import typical.reducer;
+import typical.serialize;
+
+using namespace typical;
+
+// ============================================================================
+// Term corpus loading
+// ============================================================================
+//
+// Usage: example_05 [terms] [value]
+//
+// Writes a corpus of Church numerals 0..value-1 paired with a shared numeral
+// of the given value, then times mapping the file, walking every term in place
+// with a cursor, reading the numerals in place with church_value, and building
+// heap graphs of every term with TermLoader for comparison.
+
+namespace {
+
+auto church(TermGraph& g, std::size_t n) -> const TermNode* {
+    const TermNode* body = g.var(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        body = g.app(g.var(1), body);
+    }
+    return g.abs(g.abs(body));
+}
+
+template <typename F>
+auto time_ms(F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* label, double ms) {
+    std::cout << "  " << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << ms << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t terms = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    const std::size_t value = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+    const auto path = std::filesystem::temp_directory_path() / "typical_example_05.tlam";
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Term corpus: " << terms << " terms, numerals up to " << value << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    {
+        TermGraph g;
+        TermWriter writer;
+        const TermNode* pair = reify<Pair>(g);
+        const TermNode* shared = church(g, value);
+        const double ms = time_ms([&] {
+            for (std::size_t i = 0; i < terms; ++i) {
+                writer.add(g.app(g.app(pair, church(g, i % value)), shared));
+            }
+            writer.write(path);
+        });
+        report("write", ms);
+    }
+    std::cout << "  file size   " << std::setw(12) << std::filesystem::file_size(path) / 1024 << " KiB" << std::endl;
+
+    std::optional<TermCorpus> corpus;
+    report("open", time_ms([&] { corpus.emplace(TermCorpus::open(path)); }));
+
+    std::size_t nodes = 0;
+    report("walk", time_ms([&] {
+               for (std::size_t i = 0; i < corpus->size(); ++i) {
+                   visit(corpus->root(i), [&](const TermCursor&) { ++nodes; });
+               }
+           }));
+
+    std::size_t sum = 0;
+    report("church_value", time_ms([&] {
+               for (std::size_t i = 0; i < corpus->size(); ++i) {
+                   sum += church_value(corpus->root(i).func().arg()).value_or(0);
+               }
+           }));
+
+    std::size_t loaded = 0;
+    report("load to heap", time_ms([&] {
+               TermGraph g;
+               TermLoader loader(g);
+               for (std::size_t i = 0; i < corpus->size(); ++i) {
+                   loaded += loader.load(corpus->root(i))->size;
+               }
+           }));
+
+    std::cout << "  " << nodes << " nodes walked, " << loaded << " loaded, numeral sum " << sum << std::endl;
+    corpus.reset();
+    std::filesystem::remove(path);
+    return 0;
+}
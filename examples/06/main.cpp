@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <vector>
+
+import typical.nat;
+import typical.fin;
+
+using namespace typical;
+
+// ============================================================================
+// Fin<N> indexing vs checked and unchecked access
+// ============================================================================
+//
+// Usage: example_06 [lookups]
+//
+// Gathers from a 4096-entry table through a list of random indices, and sums
+// the table in order, three ways: std::vector::at, unchecked operator[], and
+// FinSpan indexed by Fin<N>. The Fin indices are checked once when the index
+// list is built, so the gather loop has no bounds checks yet stays in bounds.
+
+namespace {
+
+using Size = nat::nat_t<4096>;
+
+template <typename F>
+auto time_ns_per_op(std::size_t ops, F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(ops);
+}
+
+void report(const char* name, double ns, double baseline, double checksum) {
+    std::cout << "  " << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(8) << ns << " ns" << std::setw(8) << std::setprecision(2) << baseline / ns << "x"
+              << "  (checksum " << std::setprecision(0) << checksum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 24;
+    constexpr std::size_t bound = Fin<Size>::bound;
+
+    std::vector<double> table(bound);
+    for (std::size_t i = 0; i < bound; ++i) {
+        table[i] = static_cast<double>(i % 97);
+    }
+
+    std::vector<std::size_t> raw(lookups);
+    std::vector<Fin<Size>> fins;
+    fins.reserve(lookups);
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (std::size_t i = 0; i < lookups; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        raw[i] = static_cast<std::size_t>(state >> 33) % bound;
+        fins.push_back(*Fin<Size>::check(raw[i]));
+    }
+    const FinSpan<const double, Size> view = *FinSpan<const double, Size>::check(table);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Fin<N> indexing, table of " << bound << ", " << lookups << " lookups" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  gather                      per op  vs at()" << std::endl;
+
+    double at_sum = 0.0;
+    const double at_ns = time_ns_per_op(lookups, [&] {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            at_sum += table.at(raw[i]);
+        }
+    });
+    double unchecked_sum = 0.0;
+    const double unchecked_ns = time_ns_per_op(lookups, [&] {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            unchecked_sum += table[raw[i]];
+        }
+    });
+    double fin_sum = 0.0;
+    const double fin_ns = time_ns_per_op(lookups, [&] {
+        for (const Fin<Size> i : fins) {
+            fin_sum += view[i];
+        }
+    });
+    report("vector::at", at_ns, at_ns, at_sum);
+    report("vector::operator[]", unchecked_ns, at_ns, unchecked_sum);
+    report("FinSpan[Fin<N>]", fin_ns, at_ns, fin_sum);
+
+    const std::size_t passes = lookups / bound + 1;
+    std::cout << "  sequential sum" << std::endl;
+    double seq_at = 0.0;
+    const double seq_at_ns = time_ns_per_op(passes * bound, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            for (std::size_t i = 0; i < bound; ++i) {
+                seq_at += table.at(i);
+            }
+        }
+    });
+    double seq_unchecked = 0.0;
+    const double seq_unchecked_ns = time_ns_per_op(passes * bound, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            for (std::size_t i = 0; i < bound; ++i) {
+                seq_unchecked += table[i];
+            }
+        }
+    });
+    double seq_fin = 0.0;
+    const double seq_fin_ns = time_ns_per_op(passes * bound, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            for (const Fin<Size> i : fin_range<Size>()) {
+                seq_fin += view[i];
+            }
+        }
+    });
+    report("vector::at", seq_at_ns, seq_at_ns, seq_at);
+    report("vector::operator[]", seq_unchecked_ns, seq_at_ns, seq_unchecked);
+    report("FinSpan[fin_range]", seq_fin_ns, seq_at_ns, seq_fin);
+    return 0;
+}
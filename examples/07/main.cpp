@@ -0,0 +1,116 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <vector>
+
+import typical.calculus;
+import typical.autodiff;
+
+using namespace typical;
+
+// ============================================================================
+// Reverse-mode gradients vs finite differences
+// ============================================================================
+//
+// Usage: example_07 [points]
+//
+// Takes the gradient of a 16-variable model, softplus of a sum of products
+// of sines, at many random points. Compares plain forward evaluation on the
+// tape, the reverse-mode gradient (one forward pass and one backward sweep on
+// a reused GradientTape), and central differences (two evaluations per
+// variable). The gradient should cost a small multiple of one evaluation.
+
+namespace {
+
+template <std::size_t I>
+struct Terms {
+    using type = Add<Mul<X_<I>, Sin<Mul<X_<I + 8>, X_<(I + 1) % 8>>>>, typename Terms<I - 1>::type>;
+};
+
+template <>
+struct Terms<0> {
+    using type = Mul<X_<0>, Sin<Mul<X_<8>, X_<1>>>>;
+};
+
+using Model = Log<Add<C_<1>, Exp<Terms<7>::type>>>;
+using Tape = GradientTape<Model>;
+constexpr std::size_t arity = Tape::arity;
+
+template <typename F>
+auto time_ns_per_point(std::size_t points, F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(points);
+}
+
+void report(const char* name, double ns, double baseline, double checksum) {
+    std::cout << "  " << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << ns << " ns" << std::setw(8) << std::setprecision(2) << ns / baseline << "x"
+              << "  (checksum " << std::setprecision(6) << checksum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 18;
+
+    std::vector<double> points(count * arity);
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (auto& p : points) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        p = static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53) - 0.5;
+    }
+    std::vector<double> values(count);
+    std::vector<double> gradients(count * arity);
+    Tape tape;
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Gradient of a " << arity << "-variable model, " << count << " points" << std::endl;
+    std::cout << "  tape: " << sizeof(Tape) << " bytes, " << Tape::partials << " partials" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  method                     per point  vs eval" << std::endl;
+
+    double eval_sum = 0.0;
+    const double eval_ns = time_ns_per_point(count, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            eval_sum += tape.forward(std::span<const double>(points).subspan(i * arity).first<arity>());
+        }
+    });
+
+    const double reverse_ns = time_ns_per_point(count, [&] { tape.gradient_batch(points, values, gradients); });
+    double reverse_sum = 0.0;
+    for (const double g : gradients) {
+        reverse_sum += g;
+    }
+
+    double central_sum = 0.0;
+    const double central_ns = time_ns_per_point(count, [&] {
+        constexpr double h = 1e-6;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::array<double, arity> x{};
+            for (std::size_t k = 0; k < arity; ++k) {
+                x[k] = points[i * arity + k];
+            }
+            for (std::size_t k = 0; k < arity; ++k) {
+                const double saved = x[k];
+                x[k] = saved + h;
+                const double up = tape.forward(x);
+                x[k] = saved - h;
+                const double down = tape.forward(x);
+                x[k] = saved;
+                central_sum += (up - down) / (2 * h);
+            }
+        }
+    });
+
+    report("evaluation", eval_ns, eval_ns, eval_sum);
+    report("reverse mode", reverse_ns, eval_ns, reverse_sum);
+    report("central differences", central_ns, eval_ns, central_sum);
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+
+import typical.lambda;
+import typical.church;
+import typical.reducer;
+import typical.combinator;
+
+using namespace typical;
+
+// ============================================================================
+// Combinator reduction vs beta reduction
+// ============================================================================
+//
+// Usage: example_08 [value] [elements]
+//
+// First prints, for a few Church workloads, the reduction steps and term
+// sizes of normalize_t on the lambda term and of ski_normalize_t on its
+// to_ski_t translation; both are applied to two free variables so that the
+// step counts cover the same normal form. Then times the runtime reducers on
+// larger instances: GraphReducer on a TermGraph, which substitutes, and
+// CombinatorGraph, which rewrites redexes in place.
+
+namespace {
+
+template <typename Term>
+using Probe = App<App<Term, Var<1>>, Var<0>>;
+
+template <typename Term>
+void row(const char* name) {
+    std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(8)
+              << Normalize<Probe<Term>>::steps << std::setw(8) << SkiNormalize<Probe<to_ski_t<Term>>>::steps
+              << std::setw(10) << term_size_v<Term> << std::setw(8) << combinator_size_v<to_ski_t<Term>> << std::endl;
+}
+
+using Three = church_numeral_t<3>;
+using Four = church_numeral_t<4>;
+
+auto church(TermGraph& g, std::size_t n) -> const TermNode* {
+    const TermNode* body = g.var(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        body = g.app(g.var(1), body);
+    }
+    return g.abs(g.abs(body));
+}
+
+/// Successor S B applied n times to zero K I
+auto church(CombinatorGraph& g, std::size_t n) -> CombinatorGraph::Id {
+    const auto succ = g.app(CombinatorGraph::atom(CombinatorKind::S), CombinatorGraph::atom(CombinatorKind::B));
+    auto term = g.app(CombinatorGraph::atom(CombinatorKind::K), CombinatorGraph::atom(CombinatorKind::I));
+    for (std::size_t i = 0; i < n; ++i) {
+        term = g.app(succ, term);
+    }
+    return term;
+}
+
+auto count(const TermNode* numeral) -> std::optional<std::size_t> {
+    if (numeral->kind != TermKind::Abs || numeral->left->kind != TermKind::Abs) {
+        return std::nullopt;
+    }
+    std::size_t n = 0;
+    for (const TermNode* t = numeral->left->left; t->kind == TermKind::App; t = t->right) {
+        ++n;
+    }
+    return n;
+}
+
+template <typename F>
+auto time_ms(F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, double lambda_ms, double ski_ms, std::optional<std::size_t> lambda_value,
+            std::optional<std::size_t> ski_value, std::size_t ski_steps) {
+    std::cout << "  " << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << lambda_ms << " ms" << std::setw(10) << ski_ms << " ms" << std::setw(10)
+              << ski_steps << "  " << (lambda_value && lambda_value == ski_value ? "ok" : "MISMATCH") << " ("
+              << lambda_value.value_or(0) << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t value = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    const std::size_t elements = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 400;
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Compile-time normalization, applied to f and x" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  workload            lambda     SKI  lam size  SKI size" << std::endl;
+    row<App<App<Add, Three>, Four>>("3 + 4");
+    row<App<App<Mul, Three>, Four>>("3 * 4");
+    row<App<Succ, App<App<Mul, Four>, Four>>>("succ (4 * 4)");
+    row<App<named::Sum, BuildList<One, Two, Three>>>("sum [1, 2, 3]");
+    row<App<Length, BuildList<Zero, Zero, Zero, Zero>>>("length [0, 0, 0, 0]");
+
+    std::cout << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Runtime normalization, value " << value << ", " << elements << " elements" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  workload             GraphReducer  CombinatorGraph  SKI steps" << std::endl;
+
+    const ReduceOptions options{.max_steps = std::size_t{1} << 24};
+
+    {
+        std::optional<std::size_t> lambda_value;
+        const double lambda_ms = time_ms([&] {
+            TermGraph g;
+            GraphReducer reducer(g, options);
+            lambda_value = count(reducer.normalize(g.app(g.app(reify<Mul>(g), church(g, value)), church(g, value))));
+        });
+        std::optional<std::size_t> ski_value;
+        std::size_t ski_steps = 0;
+        const double ski_ms = time_ms([&] {
+            CombinatorGraph g;
+            const auto mul = reify_combinator<to_ski_t<Mul>>(g);
+            ski_value = g.numeral(g.app(g.app(mul, church(g, value)), church(g, value)));
+            ski_steps = g.steps();
+        });
+        report("n * n", lambda_ms, ski_ms, lambda_value, ski_value, ski_steps);
+    }
+
+    {
+        std::optional<std::size_t> lambda_value;
+        const double lambda_ms = time_ms([&] {
+            TermGraph g;
+            GraphReducer reducer(g, options);
+            const TermNode* list = reify<Nil>(g);
+            const TermNode* cons = reify<Cons>(g);
+            for (std::size_t i = 0; i < elements; ++i) {
+                list = g.app(g.app(cons, church(g, i % 8)), list);
+            }
+            lambda_value = count(reducer.normalize(g.app(reify<Sum>(g), list)));
+        });
+        std::optional<std::size_t> ski_value;
+        std::size_t ski_steps = 0;
+        const double ski_ms = time_ms([&] {
+            CombinatorGraph g;
+            auto list = reify_combinator<to_ski_t<Nil>>(g);
+            const auto cons = reify_combinator<to_ski_t<Cons>>(g);
+            for (std::size_t i = 0; i < elements; ++i) {
+                list = g.app(g.app(cons, church(g, i % 8)), list);
+            }
+            ski_value = g.numeral(g.app(reify_combinator<to_ski_t<Sum>>(g), list));
+            ski_steps = g.steps();
+        });
+        report("sum of a list", lambda_ms, ski_ms, lambda_value, ski_value, ski_steps);
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+import typical.lambda;
+import typical.church;
+import typical.lower;
+import typical.reducer;
+import typical.native;
+
+using namespace typical;
+
+// ============================================================================
+// Native closures vs graph reduction
+// ============================================================================
+//
+// Usage: example_09 [inputs]
+//
+// Runs Church-encoded functions on random runtime numbers, once as closures
+// from compile<Term>() and once by normalizing the applied term with
+// GraphReducer. Multiplication types statically and runs as plain loops;
+// predecessor changes type at every step and runs on Dynamic; the sum of a
+// list of runtime length is built on Dynamic as well.
+
+namespace {
+
+auto church(TermGraph& g, std::size_t n) -> const TermNode* {
+    const TermNode* body = g.var(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        body = g.app(g.var(1), body);
+    }
+    return g.abs(g.abs(body));
+}
+
+auto count(const TermNode* numeral) -> std::size_t {
+    std::size_t n = 0;
+    for (const TermNode* t = numeral->left->left; t->kind == TermKind::App; t = t->right) {
+        ++n;
+    }
+    return n;
+}
+
+template <typename F>
+auto time_ns_per_input(std::size_t inputs, F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(inputs);
+}
+
+void report(const char* name, double native_ns, double graph_ns, bool agree) {
+    std::cout << "  " << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << native_ns << " ns" << std::setw(12) << graph_ns << " ns" << std::setw(9)
+              << graph_ns / native_ns << "x  " << (agree ? "ok" : "MISMATCH") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t inputs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500;
+
+    std::vector<std::size_t> numbers(inputs * 2);
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (auto& n : numbers) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        n = static_cast<std::size_t>(state >> 58);
+    }
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Church functions on " << inputs << " runtime inputs (values below 64)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  function           compiled    GraphReducer  speedup" << std::endl;
+
+    {
+        std::vector<std::size_t> native(inputs);
+        std::vector<std::size_t> graph(inputs);
+        const auto mul = compile<Mul>();
+        const double native_ns = time_ns_per_input(inputs, [&] {
+            for (std::size_t i = 0; i < inputs; ++i) {
+                native[i] = to_native<Numeral>(
+                    mul(from_native<Numeral>(numbers[2 * i]))(from_native<Numeral>(numbers[2 * i + 1])));
+            }
+        });
+        const double graph_ns = time_ns_per_input(inputs, [&] {
+            TermGraph g;
+            GraphReducer reducer(g);
+            const TermNode* term = reify<Mul>(g);
+            for (std::size_t i = 0; i < inputs; ++i) {
+                graph[i] = count(
+                    reducer.normalize(g.app(g.app(term, church(g, numbers[2 * i])), church(g, numbers[2 * i + 1]))));
+            }
+        });
+        report("a * b", native_ns, graph_ns, native == graph);
+    }
+
+    {
+        std::vector<std::size_t> native(inputs);
+        std::vector<std::size_t> graph(inputs);
+        const auto pred = compile<Pred>();
+        const double native_ns = time_ns_per_input(inputs, [&] {
+            for (std::size_t i = 0; i < inputs; ++i) {
+                native[i] = to_native<Numeral>(pred(from_native<Numeral>(numbers[i])));
+            }
+        });
+        const double graph_ns = time_ns_per_input(inputs, [&] {
+            TermGraph g;
+            GraphReducer reducer(g);
+            const TermNode* term = reify<Pred>(g);
+            for (std::size_t i = 0; i < inputs; ++i) {
+                graph[i] = count(reducer.normalize(g.app(term, church(g, numbers[i]))));
+            }
+        });
+        report("pred n", native_ns, graph_ns, native == graph);
+    }
+
+    {
+        std::size_t native = 0;
+        std::size_t graph = 0;
+        const double native_ns = time_ns_per_input(inputs, [&] {
+            const auto cons = compile<Cons>();
+            Dynamic list = to_dynamic(compile<Nil>());
+            for (std::size_t i = 0; i < inputs; ++i) {
+                list = to_dynamic(cons(from_native<Numeral>(numbers[i] % 8))(list));
+            }
+            native = to_native<Numeral>(compile<Sum>()(list));
+        });
+        const double graph_ns = time_ns_per_input(inputs, [&] {
+            TermGraph g;
+            GraphReducer reducer(g, ReduceOptions{.max_steps = std::size_t{1} << 24});
+            const TermNode* list = reify<Nil>(g);
+            const TermNode* cons = reify<Cons>(g);
+            for (std::size_t i = 0; i < inputs; ++i) {
+                list = g.app(g.app(cons, church(g, numbers[i] % 8)), list);
+            }
+            graph = count(reducer.normalize(g.app(reify<Sum>(g), list)));
+        });
+        report("sum of a list", native_ns, graph_ns, native == graph);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <vector>
+
+import typical.lambda;
+import typical.set;
+import typical.filter;
+
+using namespace typical;
+
+// ============================================================================
+// Fused filter kernels
+// ============================================================================
+//
+// Usage: example_10 [rows]
+//
+// Filters a three-column record batch with (price > 50 ∩ quantity < 20) ∪
+// ¬(flag != 0), written with the set combinators of typical.set. Compares the
+// fused FilterKernel, producing a bitmap and an index vector, with a per-row
+// interpreter: a tree of virtual nodes over std::function leaves, evaluated
+// with short-circuiting and a data-dependent branch per row.
+
+namespace {
+
+struct Batch {
+    std::span<const std::int32_t> price;
+    std::span<const std::int32_t> quantity;
+    std::span<const std::uint8_t> flag;
+};
+
+using Query = App<App<set::Union, App<App<set::Intersertion, set::Leaf<0>>, set::Leaf<1>>>,
+                  App<set::Complement, set::Leaf<2>>>;
+
+struct Node {
+    virtual ~Node() = default;
+    virtual auto test(const Batch& batch, std::size_t row) const -> bool = 0;
+};
+
+struct LeafNode : Node {
+    std::function<bool(const Batch&, std::size_t)> predicate;
+    explicit LeafNode(std::function<bool(const Batch&, std::size_t)> p) : predicate(std::move(p)) {}
+    auto test(const Batch& batch, std::size_t row) const -> bool override { return predicate(batch, row); }
+};
+
+struct AndNode : Node {
+    std::unique_ptr<Node> left;
+    std::unique_ptr<Node> right;
+    AndNode(std::unique_ptr<Node> l, std::unique_ptr<Node> r) : left(std::move(l)), right(std::move(r)) {}
+    auto test(const Batch& batch, std::size_t row) const -> bool override {
+        return left->test(batch, row) && right->test(batch, row);
+    }
+};
+
+struct OrNode : Node {
+    std::unique_ptr<Node> left;
+    std::unique_ptr<Node> right;
+    OrNode(std::unique_ptr<Node> l, std::unique_ptr<Node> r) : left(std::move(l)), right(std::move(r)) {}
+    auto test(const Batch& batch, std::size_t row) const -> bool override {
+        return left->test(batch, row) || right->test(batch, row);
+    }
+};
+
+struct NotNode : Node {
+    std::unique_ptr<Node> operand;
+    explicit NotNode(std::unique_ptr<Node> o) : operand(std::move(o)) {}
+    auto test(const Batch& batch, std::size_t row) const -> bool override { return !operand->test(batch, row); }
+};
+
+template <typename F>
+auto time_ms(F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, double ms, std::size_t rows, std::size_t selected) {
+    std::cout << "  " << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << ms << " ms" << std::setw(10) << static_cast<double>(rows) / ms / 1e3
+              << " Mrows/s" << std::setw(12) << selected << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 24;
+
+    std::vector<std::int32_t> price(rows);
+    std::vector<std::int32_t> quantity(rows);
+    std::vector<std::uint8_t> flag(rows);
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (std::size_t i = 0; i < rows; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        price[i] = static_cast<std::int32_t>(state >> 57);
+        quantity[i] = static_cast<std::int32_t>((state >> 40) & 63);
+        flag[i] = static_cast<std::uint8_t>((state >> 30) & 3);
+    }
+    const Batch batch{price, quantity, flag};
+
+    const auto filter = make_filter<Query>([](const Batch& b, std::size_t i) { return b.price[i] > 50; },
+                                           [](const Batch& b, std::size_t i) { return b.quantity[i] < 20; },
+                                           [](const Batch& b, std::size_t i) { return b.flag[i] != 0; });
+
+    const auto tree = std::make_unique<OrNode>(
+        std::make_unique<AndNode>(
+            std::make_unique<LeafNode>([](const Batch& b, std::size_t i) { return b.price[i] > 50; }),
+            std::make_unique<LeafNode>([](const Batch& b, std::size_t i) { return b.quantity[i] < 20; })),
+        std::make_unique<NotNode>(
+            std::make_unique<LeafNode>([](const Batch& b, std::size_t i) { return b.flag[i] != 0; })));
+
+    std::vector<std::uint64_t> bitmap(bitmap_words(rows));
+    std::vector<std::uint32_t> indices(rows);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Filtering " << rows << " rows" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  method                        time    throughput    selected" << std::endl;
+
+    std::size_t selected = 0;
+    double ms = time_ms([&] { selected = filter.select(batch, rows, std::span<std::uint64_t>(bitmap)); });
+    report("fused bitmap", ms, rows, selected);
+
+    ms = time_ms([&] { selected = filter.select(batch, rows, std::span<std::uint32_t>(indices)); });
+    report("fused indices", ms, rows, selected);
+
+    ms = time_ms([&] {
+        selected = 0;
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (tree->test(batch, i)) {
+                indices[selected++] = static_cast<std::uint32_t>(i);
+            }
+        }
+    });
+    report("virtual tree indices", ms, rows, selected);
+    return 0;
+}
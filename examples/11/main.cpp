@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+import typical.calculus;
+import typical.bytecode;
+
+using namespace typical;
+
+// ============================================================================
+// Approximate transcendental kernels
+// ============================================================================
+//
+// Usage: example_11 [samples]
+//
+// Prints the worst error of each approx kernel against libm under the Ulp
+// and Fast accuracy policies, then times batch evaluation of a formula
+// dominated by transcendental nodes under Libm, Ulp and Fast, both through
+// evaluate<E, Accuracy> in a loop and through Program::evaluate<Accuracy>.
+// Build with optimizations (and -march=native or at least SSE4.2) to let the
+// compiler vectorize the approximate kernels.
+
+namespace {
+
+using E = Add<Mul<Sin<X>, Exp<Neg<X>>>, Div<Log<Add<X, C_<2>>>, Sqrt<Add<Cos<X>, C_<2>>>>>;
+
+template <typename F>
+auto time_ns_per_sample(std::size_t samples, F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(samples);
+}
+
+template <typename Kernel, typename Reference>
+void accuracy_row(const char* name, Kernel kernel, Reference reference, double lo, double hi) {
+    const KernelError e = measure_error(kernel, reference, lo, hi, 1000001);
+    std::cout << "  " << std::left << std::setw(12) << name << std::right << std::setw(10) << std::setprecision(3)
+              << e.max_ulp << " ulp" << std::setw(12) << e.max_relative << " relative" << std::endl;
+}
+
+template <typename Policy>
+void accuracy_table(const char* policy) {
+    std::cout << "  " << policy << std::endl;
+    accuracy_row("  sin", [](double x) { return Policy::sin(x); }, [](double x) { return std::sin(x); }, -1e3, 1e3);
+    accuracy_row("  cos", [](double x) { return Policy::cos(x); }, [](double x) { return std::cos(x); }, -1e3, 1e3);
+    accuracy_row("  tan", [](double x) { return Policy::tan(x); }, [](double x) { return std::tan(x); }, -1e3, 1e3);
+    accuracy_row("  exp", [](double x) { return Policy::exp(x); }, [](double x) { return std::exp(x); }, -700, 700);
+    accuracy_row("  log", [](double x) { return Policy::log(x); }, [](double x) { return std::log(x); }, 1e-6, 1e6);
+    accuracy_row("  sqrt", [](double x) { return Policy::sqrt(x); }, [](double x) { return std::sqrt(x); }, 0, 1e6);
+}
+
+template <typename Policy>
+void time_policy(const char* name, const std::vector<double>& xs, const Program& program,
+                 const std::vector<double>& reference) {
+    std::vector<double> fused(xs.size());
+    std::vector<double> vm(xs.size());
+    const double fused_ns = time_ns_per_sample(xs.size(), [&] {
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            fused[i] = evaluate<E, Policy>(xs[i]);
+        }
+    });
+    const double vm_ns = time_ns_per_sample(xs.size(), [&] { program.evaluate<Policy>(xs, vm); });
+
+    double worst = 0.0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        worst = std::max(worst, std::abs(vm[i] - reference[i]) / (1.0 + std::abs(reference[i])));
+    }
+    std::cout << "  " << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << fused_ns << " ns" << std::setw(10) << vm_ns << " ns" << std::scientific
+              << std::setprecision(2) << std::setw(12) << worst << std::defaultfloat << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 22;
+    std::vector<double> xs(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        xs[i] = -1.5 + 20.0 * static_cast<double>(i) / static_cast<double>(samples);
+    }
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Kernel error against libm" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    accuracy_table<accuracy::Ulp>("Ulp");
+    accuracy_table<accuracy::Fast>("Fast");
+
+    const auto program = compile<E>();
+    std::vector<double> reference(samples);
+    program.evaluate(xs, reference);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  sin x e^-x + log(x + 2) / sqrt(cos x + 2), " << samples << " samples" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  policy       fused            vm   max error" << std::endl;
+    time_policy<accuracy::Libm>("Libm", xs, program, reference);
+    time_policy<accuracy::Ulp>("Ulp", xs, program, reference);
+    time_policy<accuracy::Fast>("Fast", xs, program, reference);
+    return 0;
+}
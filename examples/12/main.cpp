@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+import typical.calculus;
+import typical.solve;
+
+using namespace typical;
+
+// ============================================================================
+// Batched Newton and Halley root finding
+// ============================================================================
+//
+// Usage: example_12 [points]
+//
+// Solves exp(x) + x^3 + sin(x) - 5 = 0 from many starting points in [-3, 3].
+// The baseline is a scalar Newton loop over hand-written f and f' that call
+// std::exp and std::sin. It is compared with find_roots using Newton and
+// Halley under the Libm, Ulp and Fast accuracy policies. The approximate
+// policies let the compiler vectorize the iteration, so build with -O3 and
+// -march=native.
+
+namespace {
+
+using F = Sub<Add<Add<Exp<X>, Pow<X, 3>>, Sin<X>>, C_<5>>;
+
+void report(const char* name, double seconds, std::size_t points, std::size_t iterations, std::size_t converged,
+            double root) {
+    std::cout << "  " << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << static_cast<double>(points) / seconds / 1e6 << " Mpts/s" << std::setw(8)
+              << static_cast<double>(iterations) / static_cast<double>(points) << std::setw(10) << converged
+              << std::setprecision(12) << std::setw(18) << root << std::endl;
+}
+
+template <RootMethod Method, typename Accuracy>
+void batched(const char* name, const std::vector<double>& starts, SolveOptions options = {}) {
+    std::vector<double> roots(starts.size());
+    const SolveStats stats = find_roots<F, Method, Accuracy>(starts, roots, options);
+    report(name, stats.seconds, stats.points, stats.iterations, stats.converged, roots.front());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 22;
+    std::vector<double> starts(points);
+    for (std::size_t i = 0; i < points; ++i) {
+        starts[i] = -3.0 + 6.0 * (static_cast<double>(i) + 0.5) / static_cast<double>(points);
+    }
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  exp(x) + x^3 + sin(x) - 5 = 0 from " << points << " starting points" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  method            throughput   iters  converged              root" << std::endl;
+
+    {
+        // Scalar baseline with the same stopping rule as find_roots
+        const SolveOptions options;
+        std::vector<double> roots(points);
+        std::size_t iterations = 0;
+        std::size_t converged = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < points; ++i) {
+            double x = starts[i];
+            for (std::size_t n = 1; n <= options.max_iterations; ++n) {
+                const double f = std::exp(x) + x * x * x + std::sin(x) - 5.0;
+                const double d = std::exp(x) + 3.0 * x * x + std::cos(x);
+                const double step = f / d;
+                x -= step;
+                if (std::abs(step) <= options.tolerance * (1.0 + std::abs(x))) {
+                    iterations += n;
+                    ++converged;
+                    break;
+                }
+            }
+            roots[i] = x;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report("scalar std::", seconds, points, iterations, converged, roots.front());
+    }
+
+    batched<RootMethod::Newton, accuracy::Libm>("Newton Libm", starts);
+    batched<RootMethod::Halley, accuracy::Libm>("Halley Libm", starts);
+    batched<RootMethod::Newton, accuracy::Ulp>("Newton Ulp", starts);
+    batched<RootMethod::Halley, accuracy::Ulp>("Halley Ulp", starts);
+    batched<RootMethod::Newton, accuracy::Fast>("Newton Fast", starts, SolveOptions{.tolerance = 1e-6});
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+import typical.lambda;
+import typical.church;
+import typical.reducer;
+import typical.cache;
+
+using namespace typical;
+
+// ============================================================================
+// Persistent normal-form cache
+// ============================================================================
+//
+// Usage: example_13 [queries] [length] [value]
+//
+// Each query maps (λn. n * n) over a Church list of numerals. Every list has
+// its own first numeral and the same tail, as in a service that receives
+// similar requests over and over. The queries are normalized with a plain
+// GraphReducer, then with a CachedReducer over an empty log (the first
+// process), then over the reopened log (a restarted process) and again with
+// the memory tier warm. Each query gets a fresh TermGraph.
+
+namespace {
+
+auto church(TermGraph& g, std::size_t n) -> const TermNode* {
+    const TermNode* body = g.var(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        body = g.app(g.var(1), body);
+    }
+    return g.abs(g.abs(body));
+}
+
+auto query(TermGraph& g, std::size_t first, std::size_t length, std::size_t value) -> const TermNode* {
+    const TermNode* cons = reify<Cons>(g);
+    const TermNode* list = reify<Nil>(g);
+    for (std::size_t i = 1; i < length; ++i) {
+        list = g.app(g.app(cons, church(g, value)), list);
+    }
+    list = g.app(g.app(cons, church(g, first)), list);
+    const TermNode* square = reify<Abs<App<App<Mul, Var<0>>, Var<0>>>>(g);
+    return g.app(g.app(reify<Map>(g), square), list);
+}
+
+template <typename F>
+auto time_ms(F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* label, double ms, const CacheStats& stats, bool agree) {
+    std::cout << "  " << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << ms << " ms" << std::setw(9) << stats.hits() << std::setw(9) << stats.misses
+              << std::setw(9) << stats.file_entries << std::setw(10) << stats.file_bytes / 1024 << " KiB  "
+              << (agree ? "ok" : "MISMATCH") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t queries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    const std::size_t length = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+    const std::size_t value = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 12;
+    const auto path = std::filesystem::temp_directory_path() / "typical_example_13.tnfc";
+    std::filesystem::remove(path);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  " << queries << " queries: squares of " << length << " numerals up to " << value << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  run                    time     hits   misses  records      file" << std::endl;
+
+    // Expected normal forms, one graph per query as the cached runs use
+    std::vector<std::unique_ptr<TermGraph>> graphs;
+    std::vector<const TermNode*> expected(queries);
+    const double plain_ms = time_ms([&] {
+        for (std::size_t i = 0; i < queries; ++i) {
+            graphs.push_back(std::make_unique<TermGraph>());
+            GraphReducer reducer(*graphs.back());
+            expected[i] = reducer.normalize(query(*graphs.back(), i % value, length, value));
+        }
+    });
+    report("GraphReducer", plain_ms, CacheStats{}, true);
+
+    const auto run = [&](NormalFormCache& cache, const char* label) {
+        bool agree = true;
+        const double ms = time_ms([&] {
+            for (std::size_t i = 0; i < queries; ++i) {
+                TermGraph g;
+                CachedReducer reducer(g, cache);
+                agree = term_equal(reducer.normalize(query(g, i % value, length, value)), expected[i]) && agree;
+            }
+        });
+        report(label, ms, cache.stats(), agree);
+    };
+
+    {
+        NormalFormCache cache(path);
+        run(cache, "cold log");
+    }
+    {
+        NormalFormCache cache(path);
+        run(cache, "reopened log");
+        run(cache, "warm memory");
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
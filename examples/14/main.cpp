@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+import typical.lambda;
+import typical.church;
+import typical.reducer;
+import typical.scott;
+
+using namespace typical;
+
+// ============================================================================
+// Scott vs Church encodings
+// ============================================================================
+//
+// Usage: example_14 [length]
+//
+// First prints the reduction steps normalize_t takes for predecessor, tail and
+// indexing on Church and Scott encodings of growing size. Church Pred rebuilds
+// the numeral, and the Scott Pred takes a constant number of steps. One Tail
+// is lazy enough under normal order that Head (Tail l) is constant for both
+// encodings. Repeated Tail is not: Nth = λn.λl.Head (n Tail l) is quadratic
+// in the index for Church lists and linear for Scott lists. The example then
+// times GraphReducer reading the last element of a runtime list of the given
+// length.
+
+namespace {
+
+template <typename Church, typename Scott>
+void row(const char* name, std::size_t size) {
+    std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(6) << size << std::setw(10)
+              << Normalize<Church>::steps << std::setw(10) << Normalize<Scott>::steps << std::endl;
+}
+
+auto church(TermGraph& g, std::size_t n) -> const TermNode* {
+    const TermNode* body = g.var(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        body = g.app(g.var(1), body);
+    }
+    return g.abs(g.abs(body));
+}
+
+/// List of free variables 1000, 1001, ... built with the given Cons and Nil
+auto list(TermGraph& g, const TermNode* cons, const TermNode* nil, std::size_t length) -> const TermNode* {
+    const TermNode* result = nil;
+    for (std::size_t i = length; i > 0; --i) {
+        result = g.app(g.app(cons, g.var(static_cast<std::uint32_t>(999 + i))), result);
+    }
+    return result;
+}
+
+template <typename F>
+auto time_ms(F&& body) -> double {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t length = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Compile-time normalization steps" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  workload        size    Church     Scott" << std::endl;
+    row<App<Pred, church_numeral_t<8>>, App<scott::Pred, scott::numeral_t<8>>>("pred n", 8);
+    row<App<Pred, church_numeral_t<32>>, App<scott::Pred, scott::numeral_t<32>>>("pred n", 32);
+    row<App<Pred, church_numeral_t<128>>, App<scott::Pred, scott::numeral_t<128>>>("pred n", 128);
+
+    using C4 = BuildList<Var<100>, Var<101>, Var<102>, Var<103>>;
+    using S4 = scott::BuildList<Var<100>, Var<101>, Var<102>, Var<103>>;
+    using C8 = BuildList<Var<100>, Var<101>, Var<102>, Var<103>, Var<104>, Var<105>, Var<106>, Var<107>>;
+    using S8 = scott::BuildList<Var<100>, Var<101>, Var<102>, Var<103>, Var<104>, Var<105>, Var<106>, Var<107>>;
+    using C12 = MakeCons<Var<90>, MakeCons<Var<91>, MakeCons<Var<92>, MakeCons<Var<93>, C8>>>>;
+    using S12 =
+        scott::MakeCons<Var<90>, scott::MakeCons<Var<91>, scott::MakeCons<Var<92>, scott::MakeCons<Var<93>, S8>>>>;
+    row<App<Head, App<Tail, C4>>, App<scott::Head, App<scott::Tail, S4>>>("head (tail l)", 4);
+    row<App<Head, App<Tail, C8>>, App<scott::Head, App<scott::Tail, S8>>>("head (tail l)", 8);
+    row<App<Head, App<Tail, C12>>, App<scott::Head, App<scott::Tail, S12>>>("head (tail l)", 12);
+    row<App<App<Nth, church_numeral_t<3>>, C4>, App<App<scott::Nth, church_numeral_t<3>>, S4>>("last of l", 4);
+    row<App<App<Nth, church_numeral_t<7>>, C8>, App<App<scott::Nth, church_numeral_t<7>>, S8>>("last of l", 8);
+    row<App<App<Nth, church_numeral_t<11>>, C12>, App<App<scott::Nth, church_numeral_t<11>>, S12>>("last of l", 12);
+
+    std::cout << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Runtime normalization, last of " << length << " elements" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    const ReduceOptions options{.max_steps = std::size_t{1} << 24};
+    const TermNode* church_last = nullptr;
+    const TermNode* scott_last = nullptr;
+    TermGraph church_graph;
+    TermGraph scott_graph;
+    const double church_ms = time_ms([&] {
+        GraphReducer reducer(church_graph, options);
+        TermGraph& g = church_graph;
+        const TermNode* l = list(g, reify<Cons>(g), reify<Nil>(g), length);
+        church_last = reducer.normalize(g.app(g.app(reify<Nth>(g), church(g, length - 1)), l));
+    });
+    const double scott_ms = time_ms([&] {
+        GraphReducer reducer(scott_graph, options);
+        TermGraph& g = scott_graph;
+        const TermNode* l = list(g, reify<scott::Cons>(g), reify<scott::Nil>(g), length);
+        scott_last = reducer.normalize(g.app(g.app(reify<scott::Nth>(g), church(g, length - 1)), l));
+    });
+    const bool agree = church_last->kind == TermKind::Var && church_last->index == 999 + length &&
+                       term_equal(church_last, scott_last);
+    std::cout << "  Church" << std::fixed << std::setprecision(2) << std::setw(12) << church_ms << " ms" << std::endl;
+    std::cout << "  Scott " << std::setw(12) << scott_ms << " ms" << std::endl;
+    std::cout << "  speedup" << std::setw(11) << church_ms / scott_ms << "x  " << (agree ? "ok" : "MISMATCH")
+              << std::endl;
+    return 0;
+}
@@ -9,3 +9,20 @@ export import typical.eq;
 export import typical.set;
 export import typical.calculus;
 export import typical.refine;
+export import typical.pool;
+export import typical.mapped;
+export import typical.stream;
+export import typical.bytecode;
+export import typical.reducer;
+export import typical.serialize;
+export import typical.fin;
+export import typical.vec;
+export import typical.lower;
+export import typical.autodiff;
+export import typical.combinator;
+export import typical.native;
+export import typical.filter;
+export import typical.approx;
+export import typical.solve;
+export import typical.cache;
+export import typical.scott;
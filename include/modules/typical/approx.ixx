@@ -0,0 +1,427 @@
+module;
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+export module typical.approx;
+
+export namespace typical {
+
+// Approximate kernels
+// ----------------
+//
+// Branch-free double kernels for the transcendental nodes of typical.calculus:
+// range reduction to a small interval, a truncated series there, and special
+// inputs (zero, infinities, NaN, negative arguments) patched in with selects.
+// They never touch errno and contain no calls, so a loop over them
+// vectorizes. Series coefficients are Taylor coefficients computed at compile
+// time, with enough terms for the error bound of each accuracy policy.
+
+namespace approx {
+
+/// 1.5 * 2^52: adding and then subtracting it rounds |x| < 2^51 to the nearest integer, and the sum carries
+/// that integer in its low mantissa bits
+inline constexpr double round_shift = 0x1.8p52;
+
+/// Horner evaluation of c[I] + x * (c[I + 1] + x * ...), unrolled
+template <std::size_t I = 0, std::size_t N>
+constexpr auto horner(double x, const std::array<double, N>& c) -> double {
+    if constexpr (I + 1 == N) {
+        return c[I];
+    }
+    else {
+        return horner<I + 1>(x, c) * x + c[I];
+    }
+}
+
+/// 1 / n!, with n! exact for n <= 22
+constexpr auto inverse_factorial(std::size_t n) -> double {
+    double f = 1.0;
+    for (std::size_t i = 2; i <= n; ++i) {
+        f *= static_cast<double>(i);
+    }
+    return 1.0 / f;
+}
+
+/// Coefficients of (sin r - r) / r^3 in z = r^2
+template <std::size_t Terms>
+inline constexpr auto sin_coefficients = [] {
+    std::array<double, Terms - 1> c{};
+    for (std::size_t j = 0; j < c.size(); ++j) {
+        c[j] = (j % 2 == 0 ? -1.0 : 1.0) * inverse_factorial(2 * j + 3);
+    }
+    return c;
+}();
+
+/// Coefficients of (cos r - 1) / r^2 in z = r^2
+template <std::size_t Terms>
+inline constexpr auto cos_coefficients = [] {
+    std::array<double, Terms - 1> c{};
+    for (std::size_t j = 0; j < c.size(); ++j) {
+        c[j] = (j % 2 == 0 ? -1.0 : 1.0) * inverse_factorial(2 * j + 2);
+    }
+    return c;
+}();
+
+/// Coefficients of exp r in r
+template <std::size_t Terms>
+inline constexpr auto exp_coefficients = [] {
+    std::array<double, Terms> c{};
+    for (std::size_t j = 0; j < c.size(); ++j) {
+        c[j] = inverse_factorial(j);
+    }
+    return c;
+}();
+
+/// Coefficients of (2 atanh s - 2s) / s^3 in z = s^2
+template <std::size_t Terms>
+inline constexpr auto log_coefficients = [] {
+    std::array<double, Terms> c{};
+    for (std::size_t j = 0; j < c.size(); ++j) {
+        c[j] = 2.0 / static_cast<double>(2 * j + 3);
+    }
+    return c;
+}();
+
+constexpr auto bits(double x) -> std::uint64_t {
+    return std::bit_cast<std::uint64_t>(x);
+}
+
+constexpr auto from_bits(std::uint64_t b) -> double {
+    return std::bit_cast<double>(b);
+}
+
+/// Bits of a where mask is set and of b elsewhere
+constexpr auto blend(std::uint64_t mask, double a, double b) -> double {
+    return from_bits((bits(a) & mask) | (bits(b) & ~mask));
+}
+
+/// a if pick_a, else b. A ?: on computed values lets the compiler move each computation into a branch of its
+/// own, which stops vectorization; here both are computed and blended, and the condition only picks a mask.
+constexpr auto select(bool pick_a, double a, double b) -> double {
+    return blend(std::uint64_t{0} - static_cast<std::uint64_t>(pick_a), a, b);
+}
+
+/// 2^k from k + round_shift, for integral k in [-1022, 1023]
+constexpr auto exp2_shifted(double shifted) -> double {
+    return from_bits((bits(shifted) + 1023) << 52);
+}
+
+/// x reduced by the nearest multiple q of π/2
+struct HalfPiReduction {
+    /// x - qπ/2, in [-π/4, π/4]
+    double r;
+    /// q mod 4
+    std::uint64_t quadrant;
+};
+
+/// Bound of the trigonometric kernels: 2^20 π/2, about 1.6e6
+inline constexpr double trig_limit = 0x1p20 * 1.57079632679489661923;
+
+/// NaN where |x| is not below trig_limit (including infinities and NaN), value elsewhere
+constexpr auto trig_domain(double x, double value) -> double {
+    const double magnitude = from_bits(bits(x) & ~(std::uint64_t{1} << 63));
+    return select(magnitude < trig_limit, value, std::numeric_limits<double>::quiet_NaN());
+}
+
+/// Cody-Waite reduction with π/2 split in three parts; the first two have 33 significant bits, so their
+/// multiples are exact while |q| <= 2^20, which bounds the domain to |x| < trig_limit
+constexpr auto reduce_half_pi(double x) -> HalfPiReduction {
+    constexpr double two_over_pi = 6.36619772367581382433e-01;
+    constexpr double pio2_1 = 1.57079632673412561417e+00;
+    constexpr double pio2_2 = 6.07710050630396597660e-11;
+    constexpr double pio2_2t = 2.02226624879595063154e-21;
+    const double shifted = x * two_over_pi + round_shift;
+    const double q = shifted - round_shift;
+    return {((x - q * pio2_1) - q * pio2_2) - q * pio2_2t, bits(shifted) & 3};
+}
+
+template <std::size_t Terms>
+constexpr auto sin_reduced(double r) -> double {
+    return r + r * (r * r) * horner(r * r, sin_coefficients<Terms>);
+}
+
+template <std::size_t Terms>
+constexpr auto cos_reduced(double r) -> double {
+    return 1.0 + (r * r) * horner(r * r, cos_coefficients<Terms>);
+}
+
+/// sin x with the series of sin to Terms terms and of cos to CosTerms terms; NaN for |x| >= trig_limit
+template <std::size_t Terms, std::size_t CosTerms>
+constexpr auto sin(double x) -> double {
+    const auto [r, q] = reduce_half_pi(x);
+    const double v = blend(0 - (q & 1), cos_reduced<CosTerms>(r), sin_reduced<Terms>(r));
+    return trig_domain(x, from_bits(bits(v) ^ ((q & 2) << 62)));
+}
+
+/// cos x, as sin x shifted by one quadrant; NaN for |x| >= trig_limit
+template <std::size_t SinTerms, std::size_t Terms>
+constexpr auto cos(double x) -> double {
+    const auto [r, q] = reduce_half_pi(x);
+    const double v = blend(0 - (q & 1), sin_reduced<SinTerms>(r), cos_reduced<Terms>(r));
+    return trig_domain(x, from_bits(bits(v) ^ (((q + 1) & 2) << 62)));
+}
+
+/// tan x as a quotient of the two reduced series; NaN for |x| >= trig_limit
+template <std::size_t SinTerms, std::size_t CosTerms>
+constexpr auto tan(double x) -> double {
+    const auto [r, q] = reduce_half_pi(x);
+    const double s = sin_reduced<SinTerms>(r);
+    const double c = cos_reduced<CosTerms>(r);
+    return trig_domain(x, blend(0 - (q & 1), -c / s, s / c));
+}
+
+/// exp x = 2^k exp r with r = x - k ln 2 in [-ln 2 / 2, ln 2 / 2]
+template <std::size_t Terms>
+constexpr auto exp(double x) -> double {
+    constexpr double log2e = 1.44269504088896338700e+00;
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+    // Beyond these the result is 0 or inf anyway; NaN fails both tests and passes through
+    x = select(x < -746.0, -746.0, x);
+    x = select(x > 710.0, 710.0, x);
+    const double shifted = x * log2e + round_shift;
+    const double k = shifted - round_shift;
+    const double r = (x - k * ln2_hi) - k * ln2_lo;
+    // 2^k as two factors, so results in the subnormal range and overflow to inf come out of the last multiply
+    const double half = k * 0.5 + round_shift;
+    const double rest = (k - (half - round_shift)) + round_shift;
+    return horner(r, exp_coefficients<Terms>) * exp2_shifted(half) * exp2_shifted(rest);
+}
+
+/// log x = e ln 2 + log m with x = 2^e m, m in [√½, √2), and log m = 2 atanh(s), s = (m - 1) / (m + 1)
+template <std::size_t Terms>
+constexpr auto log(double x) -> double {
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+    constexpr std::uint64_t sqrt_half = 0x3fe6a09e667f3bcd;
+    constexpr std::uint64_t exponent_one = 0x3ff0000000000000;
+    constexpr std::uint64_t mantissa = 0x000fffffffffffff;
+    // Subnormals are scaled into the normal range first
+    const bool tiny = x < std::numeric_limits<double>::min();
+    // Offsetting the bits by those of √½ puts the mantissa of [√½, √2) at the start of an exponent step
+    const std::uint64_t offset = bits(select(tiny, x * 0x1p52, x)) + (exponent_one - sqrt_half);
+    const double e = from_bits((offset >> 52) | bits(0x1p52)) - (0x1p52 + 1023.0) - select(tiny, 52.0, 0.0);
+    const double f = from_bits((offset & mantissa) + sqrt_half) - 1.0;
+    const double s = f / (2.0 + f);
+    const double z = s * s;
+    const double hfsq = 0.5 * f * f;
+    const double series = z * horner(z, log_coefficients<Terms>);
+    const double v = e * ln2_hi - ((hfsq - (s * (hfsq + series) + e * ln2_lo)) - f);
+    const double inf = std::numeric_limits<double>::infinity();
+    return select(x > 0.0, select(x < inf, v, x), select(x == 0.0, -inf, std::numeric_limits<double>::quiet_NaN()));
+}
+
+/// sqrt x = x / √x from a bit-level estimate of 1 / √x, Steps Newton steps on it and one correction of the
+/// product
+template <std::size_t Steps>
+constexpr auto sqrt(double x) -> double {
+    // Subnormals are scaled by 2^200, and the result by 2^-100, so the estimate starts close
+    const bool tiny = x < 0x1p-1000;
+    const double scaled = select(tiny, x * 0x1p200, x);
+    double r = from_bits(0x5fe6eb50c7b537a9 - (bits(scaled) >> 1));
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((r = r * (1.5 - 0.5 * scaled * r * r), void(I)), ...);
+    }(std::make_index_sequence<Steps>{});
+    double v = scaled * r;
+    v += 0.5 * r * (scaled - v * v);
+    v = select(tiny, v * 0x1p-100, v);
+    const double inf = std::numeric_limits<double>::infinity();
+    return select(x > 0.0, select(x < inf, v, x), select(x == 0.0, x, std::numeric_limits<double>::quiet_NaN()));
+}
+
+/// Float and double run the double kernels; other types fall back to libm
+template <typename T>
+inline constexpr bool has_kernel = std::is_same_v<T, double> || std::is_same_v<T, float>;
+
+} // namespace approx
+
+// Accuracy policies
+// ----------------
+//
+// An accuracy policy supplies sin, cos, tan, exp, log and sqrt as static
+// member templates. evaluate, value_and_derivative, stream_evaluate and
+// Program::evaluate take one as a template argument, defaulting to Libm.
+
+/// A type supplying sin, cos, tan, exp, log and sqrt on double as static members, like the policies below
+template <typename P>
+concept AccuracyPolicy = requires(double x) {
+    { P::sin(x) } -> std::same_as<double>;
+    { P::cos(x) } -> std::same_as<double>;
+    { P::tan(x) } -> std::same_as<double>;
+    { P::exp(x) } -> std::same_as<double>;
+    { P::log(x) } -> std::same_as<double>;
+    { P::sqrt(x) } -> std::same_as<double>;
+};
+
+namespace accuracy {
+
+/// The C library functions
+struct Libm {
+    template <typename T>
+    static auto sin(T x) -> T {
+        return std::sin(x);
+    }
+
+    template <typename T>
+    static auto cos(T x) -> T {
+        return std::cos(x);
+    }
+
+    template <typename T>
+    static auto tan(T x) -> T {
+        return std::tan(x);
+    }
+
+    template <typename T>
+    static auto exp(T x) -> T {
+        return std::exp(x);
+    }
+
+    template <typename T>
+    static auto log(T x) -> T {
+        return std::log(x);
+    }
+
+    template <typename T>
+    static auto sqrt(T x) -> T {
+        return std::sqrt(x);
+    }
+};
+
+/// The approx kernels with the given series lengths and Newton steps.
+///
+/// Trigonometric kernels are accurate for |x| < 2^20 π/2 (about 1.6e6) and
+/// return NaN beyond it, where the reduction would lose bits. exp, log and
+/// sqrt cover every double, including subnormals, infinities and NaN.
+template <std::size_t SinTerms, std::size_t CosTerms, std::size_t ExpTerms, std::size_t LogTerms,
+          std::size_t SqrtSteps>
+struct Series {
+    template <typename T>
+    static constexpr auto sin(T x) -> T {
+        if constexpr (approx::has_kernel<T>) {
+            return static_cast<T>(approx::sin<SinTerms, CosTerms>(static_cast<double>(x)));
+        }
+        else {
+            return std::sin(x);
+        }
+    }
+
+    template <typename T>
+    static constexpr auto cos(T x) -> T {
+        if constexpr (approx::has_kernel<T>) {
+            return static_cast<T>(approx::cos<SinTerms, CosTerms>(static_cast<double>(x)));
+        }
+        else {
+            return std::cos(x);
+        }
+    }
+
+    template <typename T>
+    static constexpr auto tan(T x) -> T {
+        if constexpr (approx::has_kernel<T>) {
+            return static_cast<T>(approx::tan<SinTerms, CosTerms>(static_cast<double>(x)));
+        }
+        else {
+            return std::tan(x);
+        }
+    }
+
+    template <typename T>
+    static constexpr auto exp(T x) -> T {
+        if constexpr (approx::has_kernel<T>) {
+            return static_cast<T>(approx::exp<ExpTerms>(static_cast<double>(x)));
+        }
+        else {
+            return std::exp(x);
+        }
+    }
+
+    template <typename T>
+    static constexpr auto log(T x) -> T {
+        if constexpr (approx::has_kernel<T>) {
+            return static_cast<T>(approx::log<LogTerms>(static_cast<double>(x)));
+        }
+        else {
+            return std::log(x);
+        }
+    }
+
+    template <typename T>
+    static constexpr auto sqrt(T x) -> T {
+        if constexpr (approx::has_kernel<T>) {
+            return static_cast<T>(approx::sqrt<SqrtSteps>(static_cast<double>(x)));
+        }
+        else {
+            return std::sqrt(x);
+        }
+    }
+};
+
+/// Within 1 ulp of libm for exp, log and sqrt, 2 for sin and cos and 4 for tan
+using Ulp = Series<9, 9, 14, 9, 3>;
+
+/// Relative error below 1e-6
+using Fast = Series<4, 5, 7, 3, 2>;
+
+} // namespace accuracy
+
+// Accuracy measurement
+// ----------------
+
+/// Distance between two doubles in units in the last place; 0 for two NaNs, infinite for one
+inline auto ulp_distance(double a, double b) -> double {
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b) ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    // Map the bit patterns onto a line ordered like the values, with -0 and +0 together
+    auto ordered = [](double v) -> std::uint64_t {
+        const auto b = std::bit_cast<std::uint64_t>(v);
+        return (b >> 63) != 0 ? (std::uint64_t{1} << 63) - (b & ~(std::uint64_t{1} << 63))
+                              : (std::uint64_t{1} << 63) + b;
+    };
+    const std::uint64_t x = ordered(a);
+    const std::uint64_t y = ordered(b);
+    return static_cast<double>(x > y ? x - y : y - x);
+}
+
+/// Worst error of a kernel against a reference over a sweep
+struct KernelError {
+    /// Largest distance in ulps
+    double max_ulp = 0.0;
+    /// Largest |kernel - reference| / |reference|, or |kernel| where the reference is 0
+    double max_relative = 0.0;
+    /// Input with the largest ulp distance
+    double worst = 0.0;
+};
+
+/// Compare kernel with reference at samples evenly spaced points of [lo, hi]
+template <typename Kernel, typename Reference>
+auto measure_error(Kernel kernel, Reference reference, double lo, double hi, std::size_t samples) -> KernelError {
+    KernelError error;
+    for (std::size_t i = 0; i < samples; ++i) {
+        const double x = samples > 1 ? lo + (hi - lo) * static_cast<double>(i) / static_cast<double>(samples - 1) : lo;
+        const double got = kernel(x);
+        const double want = reference(x);
+        const double ulp = ulp_distance(got, want);
+        if (ulp > error.max_ulp) {
+            error.max_ulp = ulp;
+            error.worst = x;
+        }
+        if (std::isfinite(want)) {
+            const double relative = want != 0.0 ? std::abs((got - want) / want) : std::abs(got);
+            error.max_relative = std::max(error.max_relative, relative);
+        }
+    }
+    return error;
+}
+
+} // namespace typical
@@ -0,0 +1,394 @@
+module;
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+export module typical.autodiff;
+
+import typical.calculus;
+
+export namespace typical {
+
+// Adjoint rules
+// ----------------
+//
+// Reverse mode runs over the same distinct nodes as evaluate. The forward
+// step of a node computes its value and records its local partials with
+// respect to its operands; the backward step scatters the node's adjoint
+// through them. Partials that are constant (Add, Sub, Neg) are not recorded.
+
+/// Reverse-mode rule for one node
+template <typename E>
+struct AdjointRule;
+
+/// Specialization for Arg
+template <std::size_t I>
+struct AdjointRule<Arg<I>> {
+    static constexpr std::size_t partials = 0;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T*, const T* args, T*) -> T {
+        return args[I];
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T, const T*, T*) {}
+};
+
+/// Specialization for Const
+template <auto C>
+struct AdjointRule<Const<C>> {
+    static constexpr std::size_t partials = 0;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T*, const T*, T*) -> T {
+        return static_cast<T>(C);
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T, const T*, T*) {}
+};
+
+/// Specialization for Add
+template <typename L, typename R>
+struct AdjointRule<Add<L, R>> {
+    static constexpr std::size_t partials = 0;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T* v, const T*, T*) -> T {
+        return v[slot_of<L>(List{})] + v[slot_of<R>(List{})];
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T adjoint, const T*, T* adjoints) {
+        adjoints[slot_of<L>(List{})] += adjoint;
+        adjoints[slot_of<R>(List{})] += adjoint;
+    }
+};
+
+/// Specialization for Sub
+template <typename L, typename R>
+struct AdjointRule<Sub<L, R>> {
+    static constexpr std::size_t partials = 0;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T* v, const T*, T*) -> T {
+        return v[slot_of<L>(List{})] - v[slot_of<R>(List{})];
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T adjoint, const T*, T* adjoints) {
+        adjoints[slot_of<L>(List{})] += adjoint;
+        adjoints[slot_of<R>(List{})] -= adjoint;
+    }
+};
+
+/// Specialization for Mul (records each operand as the partial of the other)
+template <typename L, typename R>
+struct AdjointRule<Mul<L, R>> {
+    static constexpr std::size_t partials = 2;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T* v, const T*, T* p) -> T {
+        const T l = v[slot_of<L>(List{})];
+        const T r = v[slot_of<R>(List{})];
+        p[0] = r;
+        p[1] = l;
+        return l * r;
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T adjoint, const T* p, T* adjoints) {
+        T& l = adjoints[slot_of<L>(List{})];
+        l = multiply_add(adjoint, p[0], l);
+        T& r = adjoints[slot_of<R>(List{})];
+        r = multiply_add(adjoint, p[1], r);
+    }
+};
+
+/// Specialization for Div
+template <typename L, typename R>
+struct AdjointRule<Div<L, R>> {
+    static constexpr std::size_t partials = 2;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T* v, const T*, T* p) -> T {
+        const T r = v[slot_of<R>(List{})];
+        const T q = v[slot_of<L>(List{})] / r;
+        p[0] = T{1} / r;
+        p[1] = -q / r;
+        return q;
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T adjoint, const T* p, T* adjoints) {
+        T& l = adjoints[slot_of<L>(List{})];
+        l = multiply_add(adjoint, p[0], l);
+        T& r = adjoints[slot_of<R>(List{})];
+        r = multiply_add(adjoint, p[1], r);
+    }
+};
+
+/// Specialization for Neg
+template <typename E>
+struct AdjointRule<Neg<E>> {
+    static constexpr std::size_t partials = 0;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T* v, const T*, T*) -> T {
+        return -v[slot_of<E>(List{})];
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T adjoint, const T*, T* adjoints) {
+        adjoints[slot_of<E>(List{})] -= adjoint;
+    }
+};
+
+/// Unary nodes with one recorded partial
+template <typename E, typename Node>
+struct UnaryAdjointRule {
+    static constexpr std::size_t partials = 1;
+
+    template <typename List, typename T>
+    static constexpr auto forward(const T* v, const T*, T* p) -> T {
+        return Node::apply(v[slot_of<E>(List{})], p[0]);
+    }
+
+    template <typename List, typename T>
+    static constexpr void backward(T adjoint, const T* p, T* adjoints) {
+        T& e = adjoints[slot_of<E>(List{})];
+        e = multiply_add(adjoint, p[0], e);
+    }
+};
+
+/// Specialization for Pow
+template <typename E, auto N>
+struct AdjointRule<Pow<E, N>> : UnaryAdjointRule<E, AdjointRule<Pow<E, N>>> {
+    template <typename T>
+    static constexpr auto apply(T e, T& partial) -> T {
+        partial = static_cast<T>(N) * power<N - 1>(e);
+        return power<N>(e);
+    }
+};
+
+/// Specialization for Sin
+template <typename E>
+struct AdjointRule<Sin<E>> : UnaryAdjointRule<E, AdjointRule<Sin<E>>> {
+    template <typename T>
+    static auto apply(T e, T& partial) -> T {
+        partial = std::cos(e);
+        return std::sin(e);
+    }
+};
+
+/// Specialization for Cos
+template <typename E>
+struct AdjointRule<Cos<E>> : UnaryAdjointRule<E, AdjointRule<Cos<E>>> {
+    template <typename T>
+    static auto apply(T e, T& partial) -> T {
+        partial = -std::sin(e);
+        return std::cos(e);
+    }
+};
+
+/// Specialization for Tan
+template <typename E>
+struct AdjointRule<Tan<E>> : UnaryAdjointRule<E, AdjointRule<Tan<E>>> {
+    template <typename T>
+    static auto apply(T e, T& partial) -> T {
+        const T t = std::tan(e);
+        partial = T{1} + t * t;
+        return t;
+    }
+};
+
+/// Specialization for Exp
+template <typename E>
+struct AdjointRule<Exp<E>> : UnaryAdjointRule<E, AdjointRule<Exp<E>>> {
+    template <typename T>
+    static auto apply(T e, T& partial) -> T {
+        partial = std::exp(e);
+        return partial;
+    }
+};
+
+/// Specialization for Log
+template <typename E>
+struct AdjointRule<Log<E>> : UnaryAdjointRule<E, AdjointRule<Log<E>>> {
+    template <typename T>
+    static auto apply(T e, T& partial) -> T {
+        partial = T{1} / e;
+        return std::log(e);
+    }
+};
+
+/// Specialization for Sqrt
+template <typename E>
+struct AdjointRule<Sqrt<E>> : UnaryAdjointRule<E, AdjointRule<Sqrt<E>>> {
+    template <typename T>
+    static auto apply(T e, T& partial) -> T {
+        const T v = std::sqrt(e);
+        partial = T{0.5} / v;
+        return v;
+    }
+};
+
+// Tapes
+// ----------------
+
+/// Static layout of a tape over a NodeList
+template <typename List>
+struct TapeLayout;
+
+template <typename... Nodes>
+struct TapeLayout<NodeList<Nodes...>> {
+protected:
+    using List = NodeList<Nodes...>;
+
+    template <std::size_t I>
+    using Node = std::tuple_element_t<I, std::tuple<Nodes...>>;
+
+    static constexpr auto make_offsets() -> std::array<std::size_t, sizeof...(Nodes) + 1> {
+        std::array<std::size_t, sizeof...(Nodes) + 1> offsets{};
+        const std::size_t counts[] = {AdjointRule<Nodes>::partials...};
+        for (std::size_t i = 0; i < sizeof...(Nodes); ++i) {
+            offsets[i + 1] = offsets[i] + counts[i];
+        }
+        return offsets;
+    }
+
+    template <typename T, std::size_t... I>
+    static constexpr auto run_forward(T* values, T* partials, const T* args, std::index_sequence<I...>) -> T {
+        ((values[I] = AdjointRule<Nodes>::template forward<List>(values, args, partials + offsets[I])), ...);
+        return values[sizeof...(Nodes) - 1];
+    }
+
+    template <typename T, std::size_t... I>
+    static constexpr void run_backward(const T* partials, T* adjoints, std::index_sequence<I...>) {
+        constexpr std::size_t last = sizeof...(Nodes) - 1;
+        (AdjointRule<Node<last - I>>::template backward<List>(adjoints[last - I], partials + offsets[last - I],
+                                                                 adjoints),
+         ...);
+    }
+
+public:
+    /// Number of nodes, one value and one adjoint each
+    static constexpr std::size_t nodes = sizeof...(Nodes);
+
+    /// Start of each node's partials; the last entry is the total
+    static constexpr std::array<std::size_t, sizeof...(Nodes) + 1> offsets = make_offsets();
+
+    /// Values in node order, recording partials
+    template <typename T>
+    static constexpr auto forward(T* values, T* partials, const T* args) -> T {
+        return run_forward(values, partials, args, std::index_sequence_for<Nodes...>{});
+    }
+
+    /// Adjoints of every node from the recorded partials, in reverse node order
+    template <typename T>
+    static constexpr void backward(const T* partials, T* adjoints) {
+        for (std::size_t i = 0; i < nodes; ++i) {
+            adjoints[i] = T{0};
+        }
+        adjoints[nodes - 1] = T{1};
+        run_backward(partials, adjoints, std::index_sequence_for<Nodes...>{});
+    }
+};
+
+/// Value and gradient of an expression at a point
+template <typename T, std::size_t N>
+struct ValueAndGradient {
+    T value;
+    std::array<T, N> gradient;
+};
+
+/// Reverse-mode tape for the expression E over arity_v<E> variables X_<0>, X_<1>, ...
+///
+/// The layout (a value and an adjoint per distinct node of plan_t<E>, and
+/// only the non-constant local partials) is fixed by E, so the tape is a
+/// plain object that can live on the stack and be reused for any number of
+/// points without allocating. A gradient costs one recorded forward pass and
+/// one backward sweep of at most two multiply-adds per node, whatever the
+/// number of variables.
+template <Expression E, typename T = double>
+class GradientTape {
+protected:
+    using List = nodes_t<plan_t<E>>;
+    using Layout = TapeLayout<List>;
+
+    static_assert(slot_of<Var>(List{}) == List::size, "gradients are taken over X_<I>; X has no index");
+
+    template <std::size_t... I>
+    constexpr void gather(std::span<T, arity_v<E>> gradient, std::index_sequence<I...>) const {
+        ((gradient[I] = slot_of<Arg<I>>(List{}) < Layout::nodes ? adjoints_[slot_of<Arg<I>>(List{})] : T{0}), ...);
+    }
+
+public:
+    /// Number of variables
+    static constexpr std::size_t arity = arity_v<E>;
+
+    /// Number of recorded partials
+    static constexpr std::size_t partials = Layout::offsets[Layout::nodes];
+
+    /// Evaluate at args and record the tape
+    constexpr auto forward(std::span<const T, arity> args) -> T {
+        return Layout::forward(values_.data(), partials_.data(), args.data());
+    }
+
+    /// Gradient of the last recorded evaluation
+    constexpr void backward(std::span<T, arity> gradient) {
+        Layout::backward(partials_.data(), adjoints_.data());
+        gather(gradient, std::make_index_sequence<arity>{});
+    }
+
+    /// Value at args, writing the gradient
+    constexpr auto gradient(std::span<const T, arity> args, std::span<T, arity> gradient) -> T {
+        const T value = forward(args);
+        backward(gradient);
+        return value;
+    }
+
+    /// Value and gradient at a point
+    constexpr auto value_and_gradient(const std::array<T, arity>& point) -> ValueAndGradient<T, arity> {
+        ValueAndGradient<T, arity> result{};
+        result.value = gradient(point, result.gradient);
+        return result;
+    }
+
+    /// Values and gradients at values.size() points. points and gradients hold
+    /// arity entries per point, point after point; throws std::invalid_argument
+    /// if either is shorter than that.
+    constexpr void gradient_batch(std::span<const T> points, std::span<T> values, std::span<T> gradients) {
+        if constexpr (arity > 0) {
+            if (points.size() / arity < values.size() || gradients.size() / arity < values.size()) {
+                throw std::invalid_argument("gradient_batch needs arity points and gradient entries per value");
+            }
+        }
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = gradient(points.subspan(i * arity).template first<arity>(),
+                                 gradients.subspan(i * arity).template first<arity>());
+        }
+    }
+
+private:
+    std::array<T, Layout::nodes> values_{};
+    std::array<T, partials> partials_{};
+    std::array<T, Layout::nodes> adjoints_{};
+};
+
+/// Value and gradient of E at a point, on a tape of its own
+template <Expression E, typename T, std::size_t N>
+    requires(N == arity_v<E>)
+constexpr auto value_and_gradient(const std::array<T, N>& point) -> ValueAndGradient<T, N> {
+    GradientTape<E, T> tape;
+    return tape.value_and_gradient(point);
+}
+
+} // namespace typical
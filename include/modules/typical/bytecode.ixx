@@ -0,0 +1,810 @@
+module;
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+export module typical.bytecode;
+
+import typical.calculus;
+
+export namespace typical {
+
+// Runtime expressions
+// ----------------
+
+/// Node kinds, mirroring the node set of typical.calculus
+enum class Op : std::uint8_t { Var, Const, Add, Sub, Mul, Div, Neg, Pow, Sin, Cos, Tan, Exp, Log, Sqrt };
+
+/// Node of a runtime expression graph
+struct ExprNode {
+    Op op = Op::Const;
+    std::uint32_t lhs = 0;
+    std::uint32_t rhs = 0;
+    /// Constant value for Const, exponent for Pow
+    double value = 0.0;
+};
+
+/// Hash-consed expression graph built at runtime.
+///
+/// Structurally equal nodes share one id, and every node's operands have
+/// smaller ids than the node itself, so ids are a topological order.
+class ExprGraph {
+public:
+    using Id = std::uint32_t;
+
+    auto var() -> Id { return intern({Op::Var}); }
+    auto constant(double c) -> Id { return intern({Op::Const, 0, 0, c}); }
+    auto add(Id l, Id r) -> Id { return intern({Op::Add, l, r}); }
+    auto sub(Id l, Id r) -> Id { return intern({Op::Sub, l, r}); }
+    auto mul(Id l, Id r) -> Id { return intern({Op::Mul, l, r}); }
+    auto div(Id l, Id r) -> Id { return intern({Op::Div, l, r}); }
+    auto neg(Id e) -> Id { return intern({Op::Neg, e}); }
+    auto pow(Id e, double n) -> Id { return intern({Op::Pow, e, 0, n}); }
+    auto sin(Id e) -> Id { return intern({Op::Sin, e}); }
+    auto cos(Id e) -> Id { return intern({Op::Cos, e}); }
+    auto tan(Id e) -> Id { return intern({Op::Tan, e}); }
+    auto exp(Id e) -> Id { return intern({Op::Exp, e}); }
+    auto log(Id e) -> Id { return intern({Op::Log, e}); }
+    auto sqrt(Id e) -> Id { return intern({Op::Sqrt, e}); }
+
+    auto node(Id id) const -> const ExprNode& { return nodes_[id]; }
+    auto size() const -> std::size_t { return nodes_.size(); }
+
+private:
+    struct Key {
+        Op op;
+        std::uint32_t lhs;
+        std::uint32_t rhs;
+        std::uint64_t bits;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        auto operator()(const Key& k) const -> std::size_t {
+            std::uint64_t h = static_cast<std::uint64_t>(k.op);
+            h = h * 0x9e3779b97f4a7c15ULL ^ k.lhs;
+            h = h * 0x9e3779b97f4a7c15ULL ^ k.rhs;
+            h = h * 0x9e3779b97f4a7c15ULL ^ k.bits;
+            return static_cast<std::size_t>(h ^ (h >> 29));
+        }
+    };
+
+    auto intern(ExprNode node) -> Id {
+        const Key key{node.op, node.lhs, node.rhs, std::bit_cast<std::uint64_t>(node.value)};
+        if (auto it = index_.find(key); it != index_.end()) {
+            return it->second;
+        }
+        const auto id = static_cast<Id>(nodes_.size());
+        nodes_.push_back(node);
+        index_.emplace(key, id);
+        return id;
+    }
+
+    std::vector<ExprNode> nodes_;
+    std::unordered_map<Key, Id, KeyHash> index_;
+};
+
+// Parsing
+// ----------------
+
+/// Parse an infix formula in x, e.g. "sin(x)^2 + 2 * exp(-x / 3)".
+///
+/// Supports + - * / ^, unary minus, parentheses, numbers, x and the functions
+/// sin, cos, tan, exp, log and sqrt. Exponents must be constant. Throws
+/// std::invalid_argument on malformed input, including parentheses and
+/// function calls nested more than max_depth deep.
+class ExprParser {
+public:
+    /// Deepest nesting of parentheses and function arguments accepted
+    static constexpr std::size_t max_depth = 256;
+
+    ExprParser(std::string_view text, ExprGraph& graph) : text_(text), graph_(graph) {}
+
+    auto parse() -> ExprGraph::Id {
+        const auto root = expression();
+        skip_space();
+        if (pos_ != text_.size()) {
+            fail("unexpected character");
+        }
+        return root;
+    }
+
+private:
+    [[noreturn]] void fail(const char* what) const {
+        throw std::invalid_argument(std::string("parse error at ") + std::to_string(pos_) + ": " + what);
+    }
+
+    void skip_space() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    auto accept(char c) -> bool {
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    auto expression() -> ExprGraph::Id {
+        if (depth_ == max_depth) {
+            fail("expression nested too deeply");
+        }
+        ++depth_;
+        const auto root = sum();
+        --depth_;
+        return root;
+    }
+
+    auto sum() -> ExprGraph::Id {
+        auto lhs = term();
+        while (true) {
+            if (accept('+')) {
+                lhs = graph_.add(lhs, term());
+            }
+            else if (accept('-')) {
+                lhs = graph_.sub(lhs, term());
+            }
+            else {
+                return lhs;
+            }
+        }
+    }
+
+    auto term() -> ExprGraph::Id {
+        auto lhs = unary();
+        while (true) {
+            if (accept('*')) {
+                lhs = graph_.mul(lhs, unary());
+            }
+            else if (accept('/')) {
+                lhs = graph_.div(lhs, unary());
+            }
+            else {
+                return lhs;
+            }
+        }
+    }
+
+    auto unary() -> ExprGraph::Id {
+        std::size_t negations = 0;
+        while (accept('-')) {
+            ++negations;
+        }
+        auto operand = power();
+        for (; negations > 0; --negations) {
+            operand = graph_.neg(operand);
+        }
+        return operand;
+    }
+
+    auto power() -> ExprGraph::Id {
+        const auto base = primary();
+        if (!accept('^')) {
+            return base;
+        }
+        const bool negative = accept('-');
+        skip_space();
+        const auto exponent = graph_.node(primary());
+        if (exponent.op != Op::Const) {
+            fail("exponent must be a constant");
+        }
+        return graph_.pow(base, negative ? -exponent.value : exponent.value);
+    }
+
+    auto primary() -> ExprGraph::Id {
+        skip_space();
+        if (pos_ >= text_.size()) {
+            fail("unexpected end of input");
+        }
+        if (accept('(')) {
+            const auto inner = expression();
+            if (!accept(')')) {
+                fail("expected ')'");
+            }
+            return inner;
+        }
+        const char c = text_[pos_];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            return number();
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            return identifier();
+        }
+        fail("unexpected character");
+    }
+
+    auto number() -> ExprGraph::Id {
+        const std::string digits(text_.substr(pos_));
+        std::size_t used = 0;
+        double value = 0.0;
+        try {
+            value = std::stod(digits, &used);
+        }
+        catch (const std::exception&) {
+            fail("malformed number");
+        }
+        pos_ += used;
+        return graph_.constant(value);
+    }
+
+    auto identifier() -> ExprGraph::Id {
+        const auto start = pos_;
+        while (pos_ < text_.size() && std::isalnum(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+        const auto name = text_.substr(start, pos_ - start);
+        if (name == "x") {
+            return graph_.var();
+        }
+        if (!accept('(')) {
+            fail("expected '(' after function name");
+        }
+        const auto arg = expression();
+        if (!accept(')')) {
+            fail("expected ')'");
+        }
+        if (name == "sin") {
+            return graph_.sin(arg);
+        }
+        if (name == "cos") {
+            return graph_.cos(arg);
+        }
+        if (name == "tan") {
+            return graph_.tan(arg);
+        }
+        if (name == "exp") {
+            return graph_.exp(arg);
+        }
+        if (name == "log") {
+            return graph_.log(arg);
+        }
+        if (name == "sqrt") {
+            return graph_.sqrt(arg);
+        }
+        pos_ = start;
+        fail("unknown function");
+    }
+
+    std::string_view text_;
+    ExprGraph& graph_;
+    std::size_t pos_ = 0;
+    std::size_t depth_ = 0;
+};
+
+/// Parse a formula into a graph, returning its root
+inline auto parse_expression(std::string_view text, ExprGraph& graph) -> ExprGraph::Id {
+    return ExprParser(text, graph).parse();
+}
+
+// Lowering from compile-time expressions
+// ----------------
+
+/// Lower a typical.calculus expression type into an ExprGraph
+template <typename E>
+struct Lower;
+
+template <>
+struct Lower<Var> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.var(); }
+};
+
+template <auto C>
+struct Lower<Const<C>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.constant(static_cast<double>(C)); }
+};
+
+template <typename L, typename R>
+struct Lower<Add<L, R>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.add(Lower<L>::apply(g), Lower<R>::apply(g)); }
+};
+
+template <typename L, typename R>
+struct Lower<Sub<L, R>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.sub(Lower<L>::apply(g), Lower<R>::apply(g)); }
+};
+
+template <typename L, typename R>
+struct Lower<Mul<L, R>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.mul(Lower<L>::apply(g), Lower<R>::apply(g)); }
+};
+
+template <typename L, typename R>
+struct Lower<Div<L, R>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.div(Lower<L>::apply(g), Lower<R>::apply(g)); }
+};
+
+template <typename E>
+struct Lower<Neg<E>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.neg(Lower<E>::apply(g)); }
+};
+
+template <typename E, auto N>
+struct Lower<Pow<E, N>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.pow(Lower<E>::apply(g), static_cast<double>(N)); }
+};
+
+template <typename E>
+struct Lower<Sin<E>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.sin(Lower<E>::apply(g)); }
+};
+
+template <typename E>
+struct Lower<Cos<E>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.cos(Lower<E>::apply(g)); }
+};
+
+template <typename E>
+struct Lower<Tan<E>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.tan(Lower<E>::apply(g)); }
+};
+
+template <typename E>
+struct Lower<Exp<E>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.exp(Lower<E>::apply(g)); }
+};
+
+template <typename E>
+struct Lower<Log<E>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.log(Lower<E>::apply(g)); }
+};
+
+template <typename E>
+struct Lower<Sqrt<E>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id { return g.sqrt(Lower<E>::apply(g)); }
+};
+
+/// Horner steps p * x + c, which compile fuses into multiply-adds
+template <auto... Cs>
+struct Lower<Horner<Cs...>> {
+    static auto apply(ExprGraph& g) -> ExprGraph::Id {
+        const double c[] = {static_cast<double>(Cs)...};
+        const auto x = g.var();
+        auto p = g.constant(c[0]);
+        for (std::size_t i = 1; i < sizeof...(Cs); ++i) {
+            p = g.add(g.mul(p, x), g.constant(c[i]));
+        }
+        return p;
+    }
+};
+
+/// Lower the evaluation plan of an expression type into a graph, returning its root
+template <Expression E>
+auto lower(ExprGraph& graph) -> ExprGraph::Id {
+    return Lower<plan_t<E>>::apply(graph);
+}
+
+// Bytecode
+// ----------------
+
+/// Register machine opcodes. The K forms take their second operand as an immediate.
+enum class OpCode : std::uint8_t {
+    LoadX,
+    LoadK,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    AddK,
+    MulK,
+    SubK,  // a - k
+    RSubK, // k - a
+    DivK,  // a / k
+    RDivK, // k / a
+    MulAddK, // a * b + k, rounded once where fma is fast
+    Neg,
+    PowI, // integral exponent, square-and-multiply
+    Pow,
+    Sin,
+    Cos,
+    Tan,
+    Exp,
+    Log,
+    Sqrt,
+};
+
+/// One bytecode instruction
+struct Instruction {
+    OpCode code;
+    std::uint16_t dst = 0;
+    std::uint16_t a = 0;
+    std::uint16_t b = 0;
+    double k = 0.0;
+};
+
+/// Apply a scalar operation to a constant during folding
+inline auto fold(const ExprNode& node, double l, double r) -> double {
+    switch (node.op) {
+    case Op::Add:
+        return l + r;
+    case Op::Sub:
+        return l - r;
+    case Op::Mul:
+        return l * r;
+    case Op::Div:
+        return l / r;
+    case Op::Neg:
+        return -l;
+    case Op::Pow:
+        return std::pow(l, node.value);
+    case Op::Sin:
+        return std::sin(l);
+    case Op::Cos:
+        return std::cos(l);
+    case Op::Tan:
+        return std::tan(l);
+    case Op::Exp:
+        return std::exp(l);
+    case Op::Log:
+        return std::log(l);
+    case Op::Sqrt:
+        return std::sqrt(l);
+    default:
+        return node.value;
+    }
+}
+
+/// Compiled register program with a batch interpreter
+class Program {
+public:
+    /// Inputs evaluated per instruction dispatch
+    static constexpr std::size_t block = 256;
+
+    Program() = default;
+    Program(std::vector<Instruction> code, std::size_t registers, std::uint16_t result)
+        : code_(std::move(code)), registers_(registers), result_(result) {}
+
+    auto instructions() const -> std::span<const Instruction> { return code_; }
+    auto registers() const -> std::size_t { return registers_; }
+
+    /// Evaluate at a single point
+    template <AccuracyPolicy Accuracy = accuracy::Libm>
+    auto evaluate(double x) const -> double {
+        double y = 0.0;
+        evaluate<Accuracy>(std::span<const double>(&x, 1), std::span<double>(&y, 1));
+        return y;
+    }
+
+    /// Evaluate at every input, block by block; throws std::invalid_argument if out is shorter than xs.
+    /// Under an approximate Accuracy the per-block loops of transcendental instructions have no calls and vectorize.
+    template <AccuracyPolicy Accuracy = accuracy::Libm>
+    void evaluate(std::span<const double> xs, std::span<double> out) const {
+        if (out.size() < xs.size()) {
+            throw std::invalid_argument("output span is shorter than the inputs");
+        }
+        // Registers are strided by the block length actually used, so a short input needs a short scratch
+        const std::size_t stride = std::min(block, xs.size());
+        std::vector<double> scratch(registers_ * stride);
+        for (std::size_t begin = 0; begin < xs.size(); begin += stride) {
+            const std::size_t n = std::min(stride, xs.size() - begin);
+            run<Accuracy>(xs.data() + begin, scratch.data(), stride, n);
+            const double* result = scratch.data() + result_ * stride;
+            std::copy(result, result + n, out.data() + begin);
+        }
+    }
+
+private:
+    template <typename Accuracy>
+    void run(const double* x, double* regs, std::size_t stride, std::size_t n) const {
+        for (const auto& ins : code_) {
+            double* d = regs + ins.dst * stride;
+            const double* a = regs + ins.a * stride;
+            const double* b = regs + ins.b * stride;
+            const double k = ins.k;
+            switch (ins.code) {
+            case OpCode::LoadX:
+                std::copy(x, x + n, d);
+                break;
+            case OpCode::LoadK:
+                std::fill(d, d + n, k);
+                break;
+            case OpCode::Add:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] + b[i];
+                break;
+            case OpCode::Sub:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] - b[i];
+                break;
+            case OpCode::Mul:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] * b[i];
+                break;
+            case OpCode::Div:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] / b[i];
+                break;
+            case OpCode::AddK:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] + k;
+                break;
+            case OpCode::MulK:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] * k;
+                break;
+            case OpCode::SubK:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] - k;
+                break;
+            case OpCode::RSubK:
+                for (std::size_t i = 0; i < n; ++i) d[i] = k - a[i];
+                break;
+            case OpCode::DivK:
+                for (std::size_t i = 0; i < n; ++i) d[i] = a[i] / k;
+                break;
+            case OpCode::RDivK:
+                for (std::size_t i = 0; i < n; ++i) d[i] = k / a[i];
+                break;
+            case OpCode::MulAddK:
+                for (std::size_t i = 0; i < n; ++i) d[i] = multiply_add(a[i], b[i], k);
+                break;
+            case OpCode::Neg:
+                for (std::size_t i = 0; i < n; ++i) d[i] = -a[i];
+                break;
+            case OpCode::PowI: {
+                const auto e = static_cast<long long>(k);
+                const auto m = static_cast<unsigned long long>(e < 0 ? -e : e);
+                for (std::size_t i = 0; i < n; ++i) {
+                    double base = a[i];
+                    double acc = 1.0;
+                    for (auto bits = m; bits != 0; bits >>= 1) {
+                        if (bits & 1) acc *= base;
+                        base *= base;
+                    }
+                    d[i] = e < 0 ? 1.0 / acc : acc;
+                }
+                break;
+            }
+            case OpCode::Pow:
+                for (std::size_t i = 0; i < n; ++i) d[i] = std::pow(a[i], k);
+                break;
+            case OpCode::Sin:
+                for (std::size_t i = 0; i < n; ++i) d[i] = Accuracy::sin(a[i]);
+                break;
+            case OpCode::Cos:
+                for (std::size_t i = 0; i < n; ++i) d[i] = Accuracy::cos(a[i]);
+                break;
+            case OpCode::Tan:
+                for (std::size_t i = 0; i < n; ++i) d[i] = Accuracy::tan(a[i]);
+                break;
+            case OpCode::Exp:
+                for (std::size_t i = 0; i < n; ++i) d[i] = Accuracy::exp(a[i]);
+                break;
+            case OpCode::Log:
+                for (std::size_t i = 0; i < n; ++i) d[i] = Accuracy::log(a[i]);
+                break;
+            case OpCode::Sqrt:
+                for (std::size_t i = 0; i < n; ++i) d[i] = Accuracy::sqrt(a[i]);
+                break;
+            }
+        }
+    }
+
+    std::vector<Instruction> code_;
+    std::size_t registers_ = 0;
+    std::uint16_t result_ = 0;
+};
+
+/// Compile the subgraph rooted at root into a register program.
+///
+/// Constant subtrees are folded, operations with one constant operand use the
+/// immediate (K) forms, a product of two registers whose only use is adding a
+/// constant is fused into that addition, and registers are reused after their
+/// last use. Throws std::length_error if more than 65535 values are live at
+/// once, since register numbers are 16 bits.
+inline auto compile(const ExprGraph& graph, ExprGraph::Id root) -> Program {
+    constexpr std::uint32_t none = ~std::uint32_t{0};
+    const std::size_t count = static_cast<std::size_t>(root) + 1;
+
+    auto is_unary = [](Op op) { return op != Op::Add && op != Op::Sub && op != Op::Mul && op != Op::Div; };
+
+    // Reachability, constant folding and last use, in topological (id) order
+    std::vector<bool> live(count, false);
+    std::vector<bool> is_const(count, false);
+    std::vector<double> folded(count, 0.0);
+    std::vector<std::uint32_t> last_use(count, none);
+    live[root] = true;
+    for (std::size_t i = count; i-- > 0;) {
+        const auto& node = graph.node(static_cast<ExprGraph::Id>(i));
+        if (!live[i] || node.op == Op::Var || node.op == Op::Const) {
+            continue;
+        }
+        live[node.lhs] = true;
+        if (!is_unary(node.op)) {
+            live[node.rhs] = true;
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& node = graph.node(static_cast<ExprGraph::Id>(i));
+        if (!live[i]) {
+            continue;
+        }
+        if (node.op == Op::Const) {
+            is_const[i] = true;
+            folded[i] = node.value;
+        }
+        else if (node.op != Op::Var) {
+            const bool unary = is_unary(node.op);
+            if (is_const[node.lhs] && (unary || is_const[node.rhs])) {
+                is_const[i] = true;
+                folded[i] = fold(node, folded[node.lhs], unary ? 0.0 : folded[node.rhs]);
+            }
+        }
+    }
+
+    // Multiply-adds: products folded into their one user, which reads the factors directly
+    std::vector<std::uint32_t> uses(count, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& node = graph.node(static_cast<ExprGraph::Id>(i));
+        if (!live[i] || is_const[i] || node.op == Op::Var) {
+            continue;
+        }
+        ++uses[node.lhs];
+        if (!is_unary(node.op)) {
+            ++uses[node.rhs];
+        }
+    }
+    std::vector<bool> fused(count, false);
+    auto fusable_product = [&](const ExprNode& node) -> std::uint32_t {
+        if (node.op != Op::Add || is_const[node.lhs] == is_const[node.rhs]) {
+            return none;
+        }
+        const auto m = is_const[node.lhs] ? node.rhs : node.lhs;
+        const auto& product = graph.node(m);
+        return product.op == Op::Mul && uses[m] == 1 && !is_const[product.lhs] && !is_const[product.rhs] ? m : none;
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        if (live[i] && !is_const[i]) {
+            if (const auto m = fusable_product(graph.node(static_cast<ExprGraph::Id>(i))); m != none) {
+                fused[m] = true;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& node = graph.node(static_cast<ExprGraph::Id>(i));
+        if (!live[i] || is_const[i] || fused[i] || node.op == Op::Var) {
+            continue;
+        }
+        for (const auto operand : {node.lhs, is_unary(node.op) ? node.lhs : node.rhs}) {
+            if (fused[operand]) {
+                last_use[graph.node(operand).lhs] = static_cast<std::uint32_t>(i);
+                last_use[graph.node(operand).rhs] = static_cast<std::uint32_t>(i);
+            }
+            else {
+                last_use[operand] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+
+    std::vector<Instruction> code;
+    std::vector<std::uint16_t> reg(count, 0);
+    std::vector<std::uint16_t> free_regs;
+    std::uint16_t next_reg = 0;
+
+    auto release = [&](ExprGraph::Id operand, std::size_t user) {
+        if (!is_const[operand] && last_use[operand] == user) {
+            free_regs.push_back(reg[operand]);
+        }
+    };
+    auto allocate = [&]() -> std::uint16_t {
+        if (free_regs.empty()) {
+            if (next_reg == std::numeric_limits<std::uint16_t>::max()) {
+                throw std::length_error("expression keeps more than 65535 values live at once");
+            }
+            return next_reg++;
+        }
+        const auto it = std::min_element(free_regs.begin(), free_regs.end());
+        const auto r = *it;
+        free_regs.erase(it);
+        return r;
+    };
+
+    if (is_const[root]) {
+        code.push_back({OpCode::LoadK, 0, 0, 0, folded[root]});
+        return Program(std::move(code), 1, 0);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& node = graph.node(static_cast<ExprGraph::Id>(i));
+        if (!live[i] || is_const[i] || fused[i]) {
+            continue;
+        }
+        Instruction ins{OpCode::LoadX};
+        if (const auto m = fusable_product(node); m != none) {
+            const auto& product = graph.node(m);
+            ins.code = OpCode::MulAddK;
+            ins.a = reg[product.lhs];
+            ins.b = reg[product.rhs];
+            ins.k = folded[is_const[node.lhs] ? node.lhs : node.rhs];
+            release(product.lhs, i);
+            if (product.rhs != product.lhs) {
+                release(product.rhs, i);
+            }
+        }
+        else if (node.op != Op::Var) {
+            const bool unary = is_unary(node.op);
+            const bool lk = is_const[node.lhs];
+            const bool rk = !unary && is_const[node.rhs];
+            const double k = lk ? folded[node.lhs] : (rk ? folded[node.rhs] : node.value);
+            ins.a = lk ? reg[node.rhs] : reg[node.lhs];
+            ins.b = unary || lk || rk ? 0 : reg[node.rhs];
+            ins.k = k;
+            switch (node.op) {
+            case Op::Add:
+                ins.code = lk || rk ? OpCode::AddK : OpCode::Add;
+                break;
+            case Op::Sub:
+                ins.code = lk ? OpCode::RSubK : (rk ? OpCode::SubK : OpCode::Sub);
+                break;
+            case Op::Mul:
+                ins.code = lk || rk ? OpCode::MulK : OpCode::Mul;
+                break;
+            case Op::Div:
+                ins.code = lk ? OpCode::RDivK : (rk ? OpCode::DivK : OpCode::Div);
+                break;
+            case Op::Neg:
+                ins.code = OpCode::Neg;
+                break;
+            case Op::Pow:
+                ins.code = node.value == std::trunc(node.value) && std::fabs(node.value) < 64 ? OpCode::PowI
+                                                                                                : OpCode::Pow;
+                break;
+            case Op::Sin:
+                ins.code = OpCode::Sin;
+                break;
+            case Op::Cos:
+                ins.code = OpCode::Cos;
+                break;
+            case Op::Tan:
+                ins.code = OpCode::Tan;
+                break;
+            case Op::Exp:
+                ins.code = OpCode::Exp;
+                break;
+            case Op::Log:
+                ins.code = OpCode::Log;
+                break;
+            case Op::Sqrt:
+                ins.code = OpCode::Sqrt;
+                break;
+            default:
+                break;
+            }
+            // Operands dying here may be overwritten: every opcode reads lane i before writing it
+            release(node.lhs, i);
+            if (!unary && node.rhs != node.lhs) {
+                release(node.rhs, i);
+            }
+        }
+        reg[i] = allocate();
+        ins.dst = reg[i];
+        code.push_back(ins);
+    }
+    return Program(std::move(code), next_reg, reg[root]);
+}
+
+/// Compile a formula given as text
+inline auto compile(std::string_view formula) -> Program {
+    ExprGraph graph;
+    const auto root = parse_expression(formula, graph);
+    return compile(graph, root);
+}
+
+/// Compile a typical.calculus expression type to bytecode
+template <Expression E>
+auto compile() -> Program {
+    ExprGraph graph;
+    const auto root = lower<E>(graph);
+    return compile(graph, root);
+}
+
+} // namespace typical
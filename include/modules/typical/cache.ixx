@@ -0,0 +1,530 @@
+module;
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <list>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+export module typical.cache;
+
+import typical.lambda;
+import typical.mapped;
+import typical.reducer;
+import typical.serialize;
+
+export namespace typical {
+
+// Structural hashing
+// ----------------
+//
+// Terms are hashed on their de Bruijn structure, so alpha-equivalent terms
+// hash alike with no renaming. The hash has two 64-bit lanes with separate
+// seeds. At 128 bits a collision between cached terms is treated as
+// impossible and is never checked.
+
+/// 128-bit structural hash of a lambda term
+struct TermHash {
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    auto operator==(const TermHash& other) const -> bool = default;
+};
+
+/// Hasher for unordered containers keyed by TermHash
+struct TermHashHasher {
+    auto operator()(const TermHash& h) const -> std::size_t { return static_cast<std::size_t>(h.lo ^ (h.hi >> 1)); }
+};
+
+/// Hashes of the three node kinds, shared by the type-level and runtime hashes
+struct TermHashing {
+    /// Murmur3 64-bit finalizer
+    static constexpr auto mix(std::uint64_t x) -> std::uint64_t {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    static constexpr auto var(std::uint64_t index) -> TermHash {
+        return {mix(0x243f6a8885a308d3ULL ^ index), mix(0x13198a2e03707344ULL + index * 0x9e3779b97f4a7c15ULL)};
+    }
+
+    static constexpr auto abs(TermHash body) -> TermHash {
+        return {mix(body.lo ^ 0xa4093822299f31d0ULL), mix(body.hi + 0x082efa98ec4e6c89ULL)};
+    }
+
+    /// The function is mixed before the argument is folded in, so App<A, B> and App<B, A> differ
+    static constexpr auto app(TermHash func, TermHash arg) -> TermHash {
+        return {mix(mix(func.lo ^ 0x452821e638d01377ULL) + arg.lo),
+                mix(mix(func.hi + 0xbe5466cf34e90c6cULL) * 0xc0ac29b7c97c50ddULL ^ arg.hi)};
+    }
+};
+
+/// Structural hash of a typical.lambda term type
+template <typename Term>
+struct StructuralHash;
+
+/// Specialization for Var
+template <size_t Index>
+struct StructuralHash<Var<Index>> {
+    static constexpr TermHash value = TermHashing::var(Index);
+};
+
+/// Specialization for Abs
+template <typename Body>
+struct StructuralHash<Abs<Body>> {
+    static constexpr TermHash value = TermHashing::abs(StructuralHash<Body>::value);
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct StructuralHash<App<Func, Arg>> {
+    static constexpr TermHash value = TermHashing::app(StructuralHash<Func>::value, StructuralHash<Arg>::value);
+};
+
+/// Named terms hash as their definition, matching reify, which inlines them
+template <typename Tag, typename Def>
+struct StructuralHash<Named<Tag, Def>> {
+    static constexpr TermHash value = StructuralHash<Def>::value;
+};
+
+/// Compile-time structural hash; equal to TermHasher on reify<Term>
+template <LambdaTerm Term>
+inline constexpr TermHash term_hash_v = StructuralHash<Term>::value;
+
+/// Structural hashes of runtime terms, memoized per node so a shared subterm is hashed once
+class TermHasher {
+public:
+    auto operator()(const TermNode* t) -> TermHash {
+        if (auto it = hashes_.find(t); it != hashes_.end()) {
+            return it->second;
+        }
+        TermHash h;
+        switch (t->kind) {
+            case TermKind::Var:
+                h = TermHashing::var(t->index);
+                break;
+            case TermKind::Abs:
+                h = TermHashing::abs((*this)(t->left));
+                break;
+            case TermKind::App:
+                h = TermHashing::app((*this)(t->left), (*this)(t->right));
+                break;
+        }
+        hashes_.emplace(t, h);
+        return h;
+    }
+
+private:
+    std::unordered_map<const TermNode*, TermHash> hashes_;
+};
+
+// Normal-form log
+// ----------------
+//
+// An append-only file of normal forms keyed by structural hash. Integers are
+// little-endian.
+//
+//   0   "TNFC"                     magic
+//   4   u32 version                currently 1
+//   8   records, each starting on a multiple of 8:
+//       0   u64 hash lo
+//       8   u64 hash hi
+//       16  u64 code length L
+//       24  u64 checksum of bytes 0..23 and the code
+//       32  code: a one-root typical.serialize corpus, zero-padded to a multiple of 8
+//
+// Every record is written with a single write and is never rewritten. A crash
+// can leave at most a torn record at the end. Opening stops at the first
+// record that is cut short or fails its checksum, and truncates the file
+// there.
+
+/// Normal-form log format constants
+struct NormalFormCodec {
+    static constexpr char magic[4] = {'T', 'N', 'F', 'C'};
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t header_bytes = 8;
+    static constexpr std::size_t record_header_bytes = 32;
+
+    static constexpr auto padded(std::size_t bytes) -> std::size_t { return (bytes + 7) & ~std::size_t{7}; }
+
+    /// FNV-1a over the record header and code, finalized with TermHashing::mix
+    static auto checksum(const std::byte* header, std::span<const std::byte> code) -> std::uint64_t {
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        const auto fold = [&h](std::byte b) { h = (h ^ static_cast<std::uint64_t>(b)) * 0x100000001b3ULL; };
+        for (std::size_t i = 0; i < 24; ++i) {
+            fold(header[i]);
+        }
+        for (std::byte b : code) {
+            fold(b);
+        }
+        return TermHashing::mix(h);
+    }
+};
+
+/// Append-only, memory-mapped file of normal forms (POSIX).
+///
+/// Appends go to the end this handle last saw, so two writers would overwrite
+/// each other's records. The log therefore holds an exclusive flock on the
+/// file while it is open, and a second handle, in this process or another,
+/// fails to open it. Services sharing a cache across restarts take turns.
+class NormalFormLog {
+public:
+    /// Open or create the log at path, dropping a torn record left at its end; throws std::system_error if
+    /// another handle has it open
+    explicit NormalFormLog(const std::filesystem::path& path, bool sync = false) : path_(path), sync_(sync) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path.string());
+        }
+        try {
+            if (::flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+                throw std::system_error(errno, std::generic_category(), "normal-form log in use " + path.string());
+            }
+            recover();
+        }
+        catch (...) {
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    NormalFormLog(const NormalFormLog&) = delete;
+    NormalFormLog& operator=(const NormalFormLog&) = delete;
+
+    ~NormalFormLog() { ::close(fd_); }
+
+    /// Code stored under key; valid until the next call on this log
+    auto find(const TermHash& key) -> std::optional<std::span<const std::byte>> {
+        const auto it = index_.find(key);
+        if (it == index_.end()) {
+            return std::nullopt;
+        }
+        const auto [offset, length] = it->second;
+        if (offset + length > map_.size()) {
+            map_ = MappedFile::open_read(path_);
+        }
+        return std::span<const std::byte>(map_.data() + offset, length);
+    }
+
+    /// Append a record unless key is already present
+    void append(const TermHash& key, std::span<const std::byte> code) {
+        if (index_.contains(key)) {
+            return;
+        }
+        std::vector<std::byte> record(NormalFormCodec::record_header_bytes + NormalFormCodec::padded(code.size()));
+        TermCodec::put_u64(record.data(), key.lo);
+        TermCodec::put_u64(record.data() + 8, key.hi);
+        TermCodec::put_u64(record.data() + 16, code.size());
+        TermCodec::put_u64(record.data() + 24, NormalFormCodec::checksum(record.data(), code));
+        std::memcpy(record.data() + NormalFormCodec::record_header_bytes, code.data(), code.size());
+        write_at(record, end_);
+        if (sync_ && ::fdatasync(fd_) != 0) {
+            throw std::system_error(errno, std::generic_category(), "fdatasync " + path_.string());
+        }
+        index_.emplace(key, std::pair{end_ + NormalFormCodec::record_header_bytes, code.size()});
+        end_ += record.size();
+    }
+
+    /// Number of records
+    auto size() const -> std::size_t { return index_.size(); }
+
+    /// Valid bytes in the file
+    auto bytes() const -> std::size_t { return end_; }
+
+private:
+    void write_at(std::span<const std::byte> data, std::size_t offset) {
+        while (!data.empty()) {
+            const ssize_t written = ::pwrite(fd_, data.data(), data.size(), static_cast<off_t>(offset));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "write " + path_.string());
+            }
+            data = data.subspan(static_cast<std::size_t>(written));
+            offset += static_cast<std::size_t>(written);
+        }
+    }
+
+    void truncate(std::size_t size) {
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate " + path_.string());
+        }
+    }
+
+    void recover() {
+        struct stat info {};
+        if (::fstat(fd_, &info) != 0) {
+            throw std::system_error(errno, std::generic_category(), "fstat " + path_.string());
+        }
+        const auto size = static_cast<std::size_t>(info.st_size);
+        if (size < NormalFormCodec::header_bytes) {
+            // New, or torn while its header was being written
+            std::byte header[NormalFormCodec::header_bytes];
+            std::memcpy(header, NormalFormCodec::magic, 4);
+            for (int i = 0; i < 4; ++i) {
+                header[4 + i] = static_cast<std::byte>(NormalFormCodec::version >> (8 * i));
+            }
+            truncate(0);
+            write_at(header, 0);
+            end_ = NormalFormCodec::header_bytes;
+            map_ = MappedFile::open_read(path_);
+            return;
+        }
+
+        map_ = MappedFile::open_read(path_);
+        const std::byte* data = map_.data();
+        std::uint32_t version = 0;
+        for (int i = 3; i >= 0; --i) {
+            version = (version << 8) | static_cast<std::uint32_t>(data[4 + i]);
+        }
+        if (std::memcmp(data, NormalFormCodec::magic, 4) != 0 || version != NormalFormCodec::version) {
+            throw std::runtime_error("not a normal-form log: " + path_.string());
+        }
+
+        std::size_t at = NormalFormCodec::header_bytes;
+        while (size - at >= NormalFormCodec::record_header_bytes) {
+            const std::uint64_t length = TermCodec::get_u64(data + at + 16);
+            const std::size_t body = size - at - NormalFormCodec::record_header_bytes;
+            if (length > body || NormalFormCodec::padded(static_cast<std::size_t>(length)) > body) {
+                break;
+            }
+            const std::span<const std::byte> code(data + at + NormalFormCodec::record_header_bytes,
+                                                  static_cast<std::size_t>(length));
+            if (TermCodec::get_u64(data + at + 24) != NormalFormCodec::checksum(data + at, code)) {
+                break;
+            }
+            const TermHash key{TermCodec::get_u64(data + at), TermCodec::get_u64(data + at + 8)};
+            index_.try_emplace(key, std::pair{at + NormalFormCodec::record_header_bytes, code.size()});
+            at += NormalFormCodec::record_header_bytes + NormalFormCodec::padded(code.size());
+        }
+        end_ = at;
+        if (end_ != size) {
+            truncate(end_);
+            map_ = MappedFile::open_read(path_);
+        }
+    }
+
+    std::filesystem::path path_;
+    bool sync_;
+    int fd_ = -1;
+    MappedFile map_;
+    /// Offset and length of the code of each record
+    std::unordered_map<TermHash, std::pair<std::size_t, std::size_t>, TermHashHasher> index_;
+    std::size_t end_ = 0;
+};
+
+// Normal-form cache
+// ----------------
+
+/// Normal-form cache settings
+struct CacheOptions {
+    /// Encoded bytes kept in memory before least recently used entries are dropped
+    std::size_t memory_bytes = std::size_t{64} << 20;
+    /// Subterms with fewer nodes are reduced without consulting the cache
+    std::uint32_t min_term_size = 16;
+    /// fdatasync after every append, so records survive power loss and not only process crashes
+    bool sync = false;
+};
+
+/// Normal-form cache counters
+struct CacheStats {
+    std::size_t memory_hits = 0;
+    std::size_t file_hits = 0;
+    std::size_t misses = 0;
+    /// Normal forms added
+    std::size_t stores = 0;
+    /// Entries dropped from memory to stay within CacheOptions::memory_bytes
+    std::size_t evictions = 0;
+    std::size_t memory_entries = 0;
+    std::size_t memory_bytes = 0;
+    std::size_t file_entries = 0;
+    std::size_t file_bytes = 0;
+
+    auto hits() const -> std::size_t { return memory_hits + file_hits; }
+};
+
+/// Normal forms keyed by the structural hash of the term they were reduced from.
+///
+/// Entries are one-root typical.serialize corpora, so they keep the sharing of
+/// the normal form and load into any TermGraph with TermLoader. The memory
+/// tier is an LRU list bounded in bytes. With a path, every entry is also
+/// appended to a NormalFormLog, and file hits are promoted back into memory.
+/// Not thread-safe.
+class NormalFormCache {
+public:
+    /// Memory tier only
+    explicit NormalFormCache(CacheOptions options = {}) : options_(options) {}
+
+    /// Memory tier backed by the log at path
+    explicit NormalFormCache(const std::filesystem::path& path, CacheOptions options = {}) : options_(options) {
+        log_.emplace(path, options.sync);
+    }
+
+    /// Code stored under key, counting a hit or a miss; valid until the next call on this cache
+    auto find(const TermHash& key) -> std::optional<std::span<const std::byte>> {
+        if (auto it = entries_.find(key); it != entries_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            ++stats_.memory_hits;
+            return std::span<const std::byte>(it->second->code);
+        }
+        if (log_) {
+            if (auto code = log_->find(key)) {
+                ++stats_.file_hits;
+                return std::span<const std::byte>(remember(key, std::vector<std::byte>(code->begin(), code->end())));
+            }
+        }
+        ++stats_.misses;
+        return std::nullopt;
+    }
+
+    /// Add the code of a normal form
+    void store(const TermHash& key, std::vector<std::byte> code) {
+        if (entries_.contains(key)) {
+            return;
+        }
+        ++stats_.stores;
+        if (log_) {
+            log_->append(key, code);
+        }
+        remember(key, std::move(code));
+    }
+
+    auto stats() const -> CacheStats {
+        CacheStats stats = stats_;
+        stats.memory_entries = entries_.size();
+        stats.memory_bytes = memory_bytes_;
+        if (log_) {
+            stats.file_entries = log_->size();
+            stats.file_bytes = log_->bytes();
+        }
+        return stats;
+    }
+
+    auto options() const -> const CacheOptions& { return options_; }
+
+private:
+    struct Entry {
+        TermHash key;
+        std::vector<std::byte> code;
+    };
+
+    auto remember(const TermHash& key, std::vector<std::byte> code) -> const std::vector<std::byte>& {
+        memory_bytes_ += code.size();
+        lru_.push_front(Entry{key, std::move(code)});
+        entries_.emplace(key, lru_.begin());
+        // The entry just added stays even when it alone exceeds the budget
+        while (memory_bytes_ > options_.memory_bytes && lru_.size() > 1) {
+            memory_bytes_ -= lru_.back().code.size();
+            entries_.erase(lru_.back().key);
+            lru_.pop_back();
+            ++stats_.evictions;
+        }
+        return lru_.front().code;
+    }
+
+    CacheOptions options_;
+    std::list<Entry> lru_;
+    std::unordered_map<TermHash, std::list<Entry>::iterator, TermHashHasher> entries_;
+    std::size_t memory_bytes_ = 0;
+    std::optional<NormalFormLog> log_;
+    CacheStats stats_;
+};
+
+// Cached reduction
+// ----------------
+
+/// Normalizer that consults a NormalFormCache at every subterm of at least CacheOptions::min_term_size nodes.
+///
+/// Results equal GraphReducer::normalize: each subterm is taken to weak head
+/// normal form and the children of its head are normalized. A subterm is
+/// looked up by structural hash before it is reduced. A computation sharing
+/// part of an earlier one finds that part in the cache, even under binders,
+/// since the hash covers free indices. A normal form is stored only when
+/// no reduction below it diverged or ran out of ReduceOptions::max_steps.
+/// Such results depend on the step budget rather than the term.
+class CachedReducer {
+public:
+    CachedReducer(TermGraph& graph, NormalFormCache& cache, ReduceOptions options = {})
+        : graph_(graph), cache_(cache), reducer_(graph, options) {}
+
+    auto normalize(const TermNode* t) -> const TermNode* { return reduce(t).node; }
+
+    /// Reify and normalize a term type
+    template <LambdaTerm Term>
+    auto normalize() -> const TermNode* {
+        return normalize(reify<Term>(graph_));
+    }
+
+private:
+    struct Result {
+        const TermNode* node;
+        /// The node is the normal form, not a term cut short by divergence or the step limit
+        bool exact;
+    };
+
+    auto reduce(const TermNode* t) -> Result {
+        if (auto it = done_.find(t); it != done_.end()) {
+            return it->second;
+        }
+        const bool cached = t->size >= cache_.options().min_term_size;
+        TermHash key;
+        if (cached) {
+            key = hasher_(t);
+            if (auto code = cache_.find(key)) {
+                TermLoader loader(graph_);
+                const Result result{loader.load(TermCorpus(*code).root(0)), true};
+                done_.emplace(t, result);
+                return result;
+            }
+        }
+
+        bool diverged = false;
+        const TermNode* head = reducer_.whnf(t, &diverged);
+        Result result{head, !diverged && reducer_.step(head) == nullptr};
+        if (!diverged && head->kind == TermKind::Abs) {
+            const Result body = reduce(head->left);
+            result.node = body.node == head->left ? head : graph_.abs(body.node);
+            result.exact = result.exact && body.exact;
+        }
+        else if (!diverged && head->kind == TermKind::App) {
+            const Result func = reduce(head->left);
+            const Result arg = reduce(head->right);
+            result.node = func.node == head->left && arg.node == head->right ? head : graph_.app(func.node, arg.node);
+            result.exact = result.exact && func.exact && arg.exact;
+        }
+
+        if (cached && result.exact) {
+            TermWriter writer;
+            writer.add(result.node);
+            cache_.store(key, writer.bytes());
+        }
+        done_.emplace(t, result);
+        return result;
+    }
+
+    TermGraph& graph_;
+    NormalFormCache& cache_;
+    GraphReducer reducer_;
+    TermHasher hasher_;
+    std::unordered_map<const TermNode*, Result> done_;
+};
+
+} // namespace typical
@@ -1,15 +1,29 @@
 module;
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
 #include <type_traits>
-#include <typeinfo>
+#include <utility>
 
 
 export module typical.calculus;
 
+export import typical.approx;
+
 export namespace typical {
 
 /// Base expression for variables in calculus
 struct Var {};
 
+/// Indexed variable of a multivariate expression, distinct from X
+template <std::size_t I>
+struct Arg {
+    static constexpr std::size_t index = I;
+};
+
 template <auto C>
 struct Const {
     static constexpr auto value = C;
@@ -55,11 +69,19 @@ struct Log {};
 template <typename E>
 struct Sqrt {};
 
+/// Polynomial in X in Horner form, coefficients from the highest degree down.
+/// Produced by plan_t rather than written by hand.
+template <auto... Cs>
+struct Horner {};
+
 using X = Var;
 
 template <auto C>
 using C_ = Const<C>;
 
+template <std::size_t I>
+using X_ = Arg<I>;
+
 // Expression classification
 
 template <typename T>
@@ -68,6 +90,9 @@ struct is_expr : std::false_type {};
 template <>
 struct is_expr<Var> : std::true_type {};
 
+template <std::size_t I>
+struct is_expr<Arg<I>> : std::true_type {};
+
 template <auto C>
 struct is_expr<Const<C>> : std::true_type {};
 
@@ -83,6 +108,9 @@ struct is_expr<Mul<L, R>> : std::true_type {};
 template <typename L, typename R>
 struct is_expr<Div<L, R>> : std::true_type {};
 
+template <typename E>
+struct is_expr<Neg<E>> : std::true_type {};
+
 template <typename E, auto N>
 struct is_expr<Pow<E, N>> : std::true_type {};
 
@@ -92,12 +120,21 @@ struct is_expr<Sin<E>> : std::true_type {};
 template <typename E>
 struct is_expr<Cos<E>> : std::true_type {};
 
+template <typename E>
+struct is_expr<Tan<E>> : std::true_type {};
+
 template <typename E>
 struct is_expr<Exp<E>> : std::true_type {};
 
 template <typename E>
 struct is_expr<Log<E>> : std::true_type {};
 
+template <typename E>
+struct is_expr<Sqrt<E>> : std::true_type {};
+
+template <auto... Cs>
+struct is_expr<Horner<Cs...>> : std::true_type {};
+
 template <typename T>
 concept Expression = is_expr<T>::value;
 
@@ -107,6 +144,9 @@ struct IsConstant;
 template <>
 struct IsConstant<Var> : std::false_type {};
 
+template <std::size_t I>
+struct IsConstant<Arg<I>> : std::false_type {};
+
 template <auto C>
 struct IsConstant<Const<C>> : std::true_type {};
 
@@ -122,6 +162,9 @@ struct IsConstant<Mul<L, R>> : std::bool_constant<IsConstant<L>::value && IsCons
 template <typename L, typename R>
 struct IsConstant<Div<L, R>> : std::bool_constant<IsConstant<L>::value && IsConstant<R>::value> {};
 
+template <typename E>
+struct IsConstant<Neg<E>> : IsConstant<E> {};
+
 template <typename E, auto N>
 struct IsConstant<Pow<E, N>> : IsConstant<E> {};
 
@@ -131,21 +174,1457 @@ struct IsConstant<Sin<E>> : IsConstant<E> {};
 template <typename E>
 struct IsConstant<Cos<E>> : IsConstant<E> {};
 
+template <typename E>
+struct IsConstant<Tan<E>> : IsConstant<E> {};
+
 template <typename E>
 struct IsConstant<Exp<E>> : IsConstant<E> {};
 
 template <typename E>
 struct IsConstant<Log<E>> : IsConstant<E> {};
 
+template <typename E>
+struct IsConstant<Sqrt<E>> : IsConstant<E> {};
+
+template <auto... Cs>
+struct IsConstant<Horner<Cs...>> : std::false_type {};
+
 template <Expression E>
 inline constexpr bool is_constant_v = IsConstant<E>::value;
 
+/// Number of indexed variables of an expression: one more than its largest Arg index
+template <typename E>
+struct Arity : std::integral_constant<std::size_t, 0> {};
+
+template <std::size_t I>
+struct Arity<Arg<I>> : std::integral_constant<std::size_t, I + 1> {};
+
+template <template <typename> class Op, typename A>
+struct Arity<Op<A>> : Arity<A> {};
+
+template <template <typename, typename> class Op, typename L, typename R>
+struct Arity<Op<L, R>> : std::integral_constant<std::size_t, std::max(Arity<L>::value, Arity<R>::value)> {};
+
+template <typename E, auto N>
+struct Arity<Pow<E, N>> : Arity<E> {};
+
+template <Expression E>
+inline constexpr std::size_t arity_v = Arity<E>::value;
+
+// Constant nodes
+
+/// Type trait to identify constant leaves
+template <typename T>
+struct is_const : std::false_type {};
+
+/// Specialization for Const
+template <auto C>
+struct is_const<Const<C>> : std::true_type {};
+
+/// Alias for is_const
+template <typename T>
+inline constexpr bool is_const_v = is_const<T>::value;
+
+/// Type trait to identify a constant leaf equal to V
+template <typename E, auto V>
+struct is_const_value : std::false_type {};
+
+/// Specialization for Const
+template <auto C, auto V>
+struct is_const_value<Const<C>, V> : std::bool_constant<(C == V)> {};
+
+/// Alias for is_const_value
+template <typename E, auto V>
+inline constexpr bool is_const_value_v = is_const_value<E, V>::value;
+
+// Structural ordering
+//
+// A total order on expression types, used to put the operands of commutative
+// nodes in a canonical position. Constants sort first, then X, then indexed
+// variables by index, then compound nodes by kind and finally by their children.
+
+/// Rank of an expression node kind
+template <typename E>
+struct NodeRank;
+
+template <auto C>
+struct NodeRank<Const<C>> : std::integral_constant<int, 0> {};
+
+template <>
+struct NodeRank<Var> : std::integral_constant<int, 1> {};
+
+template <std::size_t I>
+struct NodeRank<Arg<I>> : std::integral_constant<int, 2> {};
+
+template <typename E>
+struct NodeRank<Neg<E>> : std::integral_constant<int, 3> {};
+
+template <typename L, typename R>
+struct NodeRank<Add<L, R>> : std::integral_constant<int, 4> {};
+
+template <typename L, typename R>
+struct NodeRank<Sub<L, R>> : std::integral_constant<int, 5> {};
+
+template <typename L, typename R>
+struct NodeRank<Mul<L, R>> : std::integral_constant<int, 6> {};
+
+template <typename L, typename R>
+struct NodeRank<Div<L, R>> : std::integral_constant<int, 7> {};
+
+template <typename E, auto N>
+struct NodeRank<Pow<E, N>> : std::integral_constant<int, 8> {};
+
+template <typename E>
+struct NodeRank<Sin<E>> : std::integral_constant<int, 9> {};
+
+template <typename E>
+struct NodeRank<Cos<E>> : std::integral_constant<int, 10> {};
+
+template <typename E>
+struct NodeRank<Tan<E>> : std::integral_constant<int, 11> {};
+
+template <typename E>
+struct NodeRank<Exp<E>> : std::integral_constant<int, 12> {};
+
+template <typename E>
+struct NodeRank<Log<E>> : std::integral_constant<int, 13> {};
+
+template <typename E>
+struct NodeRank<Sqrt<E>> : std::integral_constant<int, 14> {};
+
+template <auto... Cs>
+struct NodeRank<Horner<Cs...>> : std::integral_constant<int, 15> {};
+
+/// Strict structural order on expressions
+template <typename A, typename B>
+struct ExprLess : std::bool_constant<(NodeRank<A>::value < NodeRank<B>::value)> {};
+
+/// Constants compare by value
+template <auto A, auto B>
+struct ExprLess<Const<A>, Const<B>> : std::bool_constant<(A < B)> {};
+
+/// Indexed variables compare by index
+template <std::size_t I, std::size_t J>
+struct ExprLess<Arg<I>, Arg<J>> : std::bool_constant<(I < J)> {};
+
+/// Unary nodes of the same kind compare by operand
+template <template <typename> class Op, typename A, typename B>
+struct ExprLess<Op<A>, Op<B>> : ExprLess<A, B> {};
+
+/// Binary nodes of the same kind compare lexicographically
+template <template <typename, typename> class Op, typename L1, typename R1, typename L2, typename R2>
+struct ExprLess<Op<L1, R1>, Op<L2, R2>>
+    : std::bool_constant<ExprLess<L1, L2>::value || (std::is_same_v<L1, L2> && ExprLess<R1, R2>::value)> {};
+
+/// Powers compare by base, then exponent
+template <typename A, auto N, typename B, auto M>
+struct ExprLess<Pow<A, N>, Pow<B, M>>
+    : std::bool_constant<ExprLess<A, B>::value || (std::is_same_v<A, B> && (N < M))> {};
+
+/// Alias for ExprLess
+template <typename A, typename B>
+inline constexpr bool expr_less_v = ExprLess<A, B>::value;
+
+// Simplification
+//
+// Each Simplify* builder receives already simplified operands and applies the
+// local rewrite rules for its node: constant folding, identity elimination and
+// canonical operand order for Add and Mul. Identities such as 0 * E = 0 assume
+// finite operands. Transcendental functions of constants are not folded
+// because <cmath> is not constexpr.
+
+template <typename E>
+struct Simplify;
+
+template <typename L, typename R>
+struct SimplifyAdd;
+
+template <typename L, typename R>
+struct SimplifySub;
+
+template <typename L, typename R>
+struct SimplifyMul;
+
+template <typename L, typename R>
+struct SimplifyDiv;
+
+template <typename E>
+struct SimplifyNeg;
+
+template <typename E, auto N>
+struct SimplifyPow;
+
+/// Quotient of two constants, if it can be represented without loss
+template <auto A, auto B>
+constexpr bool exact_quotient() {
+    if constexpr (std::is_integral_v<decltype(A)> && std::is_integral_v<decltype(B)>) {
+        return B != 0 && A % B == 0;
+    }
+    else {
+        return B != 0;
+    }
+}
+
+/// Integral power of a constant
+template <auto C, auto N>
+constexpr auto const_pow() {
+    auto result = decltype(C * C){1};
+    for (auto i = decltype(N){0}; i < N; ++i) {
+        result *= C;
+    }
+    return result;
+}
+
+/// Addition
+template <typename L, typename R>
+struct SimplifyAdd {
+protected:
+    static constexpr auto pick() {
+        if constexpr (is_const_v<L> && is_const_v<R>) {
+            return std::type_identity<Const<L::value + R::value>>{};
+        }
+        else if constexpr (is_const_value_v<L, 0>) {
+            return std::type_identity<R>{};
+        }
+        else if constexpr (is_const_value_v<R, 0>) {
+            return std::type_identity<L>{};
+        }
+        else if constexpr (std::is_same_v<L, R>) {
+            return std::type_identity<typename SimplifyMul<Const<2>, L>::Result>{};
+        }
+        else if constexpr (expr_less_v<R, L>) {
+            return std::type_identity<typename SimplifyAdd<R, L>::Result>{};
+        }
+        else {
+            return CollectConstants<L, R>{};
+        }
+    }
+
+    /// c1 + (c2 + E) = (c1 + c2) + E
+    template <typename A, typename B>
+    struct CollectConstants : std::type_identity<Add<A, B>> {};
+
+    template <auto C1, auto C2, typename E>
+    struct CollectConstants<Const<C1>, Add<Const<C2>, E>>
+        : std::type_identity<typename SimplifyAdd<Const<C1 + C2>, E>::Result> {};
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Subtraction
+template <typename L, typename R>
+struct SimplifySub {
+protected:
+    static constexpr auto pick() {
+        if constexpr (is_const_v<L> && is_const_v<R>) {
+            return std::type_identity<Const<L::value - R::value>>{};
+        }
+        else if constexpr (is_const_value_v<R, 0>) {
+            return std::type_identity<L>{};
+        }
+        else if constexpr (is_const_value_v<L, 0>) {
+            return std::type_identity<typename SimplifyNeg<R>::Result>{};
+        }
+        else if constexpr (std::is_same_v<L, R>) {
+            return std::type_identity<Const<0>>{};
+        }
+        else {
+            return std::type_identity<Sub<L, R>>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Multiplication
+template <typename L, typename R>
+struct SimplifyMul {
+protected:
+    static constexpr auto pick() {
+        if constexpr (is_const_v<L> && is_const_v<R>) {
+            return std::type_identity<Const<L::value * R::value>>{};
+        }
+        else if constexpr (is_const_value_v<L, 0> || is_const_value_v<R, 0>) {
+            return std::type_identity<Const<0>>{};
+        }
+        else if constexpr (is_const_value_v<L, 1>) {
+            return std::type_identity<R>{};
+        }
+        else if constexpr (is_const_value_v<R, 1>) {
+            return std::type_identity<L>{};
+        }
+        else if constexpr (std::is_same_v<L, R>) {
+            return std::type_identity<typename SimplifyPow<L, 2>::Result>{};
+        }
+        else if constexpr (expr_less_v<R, L>) {
+            return std::type_identity<typename SimplifyMul<R, L>::Result>{};
+        }
+        else {
+            return CollectConstants<L, R>{};
+        }
+    }
+
+    /// c1 * (c2 * E) = (c1 * c2) * E
+    template <typename A, typename B>
+    struct CollectConstants : std::type_identity<Mul<A, B>> {};
+
+    template <auto C1, auto C2, typename E>
+    struct CollectConstants<Const<C1>, Mul<Const<C2>, E>>
+        : std::type_identity<typename SimplifyMul<Const<C1 * C2>, E>::Result> {};
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Division
+template <typename L, typename R>
+struct SimplifyDiv {
+protected:
+    static constexpr auto pick() {
+        if constexpr (is_const_v<L> && is_const_v<R>) {
+            if constexpr (exact_quotient<L::value, R::value>()) {
+                return std::type_identity<Const<L::value / R::value>>{};
+            }
+            else {
+                return std::type_identity<Div<L, R>>{};
+            }
+        }
+        else if constexpr (is_const_value_v<R, 1>) {
+            return std::type_identity<L>{};
+        }
+        else {
+            return std::type_identity<Div<L, R>>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Negation
+template <typename E>
+struct SimplifyNeg {
+    using Result = Neg<E>;
+};
+
+/// -c folds into the constant
+template <auto C>
+struct SimplifyNeg<Const<C>> {
+    using Result = Const<-C>;
+};
+
+/// -(-E) = E
+template <typename E>
+struct SimplifyNeg<Neg<E>> {
+    using Result = E;
+};
+
+/// Power
+template <typename E, auto N>
+struct SimplifyPow {
+protected:
+    static constexpr auto pick() {
+        if constexpr (N == 0) {
+            return std::type_identity<Const<1>>{};
+        }
+        else if constexpr (N == 1) {
+            return std::type_identity<E>{};
+        }
+        else {
+            return Fold<E>{};
+        }
+    }
+
+    template <typename B>
+    struct Fold : std::type_identity<Pow<B, N>> {};
+
+    /// c^n for a non-negative integral exponent
+    template <auto C>
+        requires(std::is_integral_v<decltype(N)> && N > 0)
+    struct Fold<Const<C>> : std::type_identity<Const<const_pow<C, N>()>> {};
+
+    /// (B^m)^n = B^(m * n) for integral exponents
+    template <typename B, auto M>
+        requires(std::is_integral_v<decltype(N)> && std::is_integral_v<decltype(M)>)
+    struct Fold<Pow<B, M>> : std::type_identity<typename SimplifyPow<B, M * N>::Result> {};
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Variables are already simple
+template <>
+struct Simplify<Var> {
+    using Result = Var;
+};
+
+/// Indexed variables are already simple
+template <std::size_t I>
+struct Simplify<Arg<I>> {
+    using Result = Arg<I>;
+};
+
+/// Constants are already simple
+template <auto C>
+struct Simplify<Const<C>> {
+    using Result = Const<C>;
+};
+
+/// Specialization for Add
+template <typename L, typename R>
+struct Simplify<Add<L, R>> {
+    using Result = typename SimplifyAdd<typename Simplify<L>::Result, typename Simplify<R>::Result>::Result;
+};
+
+/// Specialization for Sub
+template <typename L, typename R>
+struct Simplify<Sub<L, R>> {
+    using Result = typename SimplifySub<typename Simplify<L>::Result, typename Simplify<R>::Result>::Result;
+};
+
+/// Specialization for Mul
+template <typename L, typename R>
+struct Simplify<Mul<L, R>> {
+    using Result = typename SimplifyMul<typename Simplify<L>::Result, typename Simplify<R>::Result>::Result;
+};
+
+/// Specialization for Div
+template <typename L, typename R>
+struct Simplify<Div<L, R>> {
+    using Result = typename SimplifyDiv<typename Simplify<L>::Result, typename Simplify<R>::Result>::Result;
+};
+
+/// Specialization for Neg
+template <typename E>
+struct Simplify<Neg<E>> {
+    using Result = typename SimplifyNeg<typename Simplify<E>::Result>::Result;
+};
+
+/// Specialization for Pow
+template <typename E, auto N>
+struct Simplify<Pow<E, N>> {
+    using Result = typename SimplifyPow<typename Simplify<E>::Result, N>::Result;
+};
+
+/// Specialization for Sin
+template <typename E>
+struct Simplify<Sin<E>> {
+    using Result = Sin<typename Simplify<E>::Result>;
+};
+
+/// Specialization for Cos
+template <typename E>
+struct Simplify<Cos<E>> {
+    using Result = Cos<typename Simplify<E>::Result>;
+};
+
+/// Specialization for Tan
+template <typename E>
+struct Simplify<Tan<E>> {
+    using Result = Tan<typename Simplify<E>::Result>;
+};
+
+/// Specialization for Exp
+template <typename E>
+struct Simplify<Exp<E>> {
+    using Result = Exp<typename Simplify<E>::Result>;
+};
+
+/// Specialization for Log, with log(exp(E)) = E
+template <typename E>
+struct Simplify<Log<E>> {
+protected:
+    template <typename A>
+    struct Build : std::type_identity<Log<A>> {};
+
+    template <typename A>
+    struct Build<Exp<A>> : std::type_identity<A> {};
+
+public:
+    /// Result
+    using Result = typename Build<typename Simplify<E>::Result>::type;
+};
+
+/// Specialization for Sqrt
+template <typename E>
+struct Simplify<Sqrt<E>> {
+    using Result = Sqrt<typename Simplify<E>::Result>;
+};
+
+/// Horner nodes are already simple
+template <auto... Cs>
+struct Simplify<Horner<Cs...>> {
+    using Result = Horner<Cs...>;
+};
+
+/// Alias for Simplify
+template <Expression E>
+using simplify_t = typename Simplify<E>::Result;
+
+// Evaluation plans
+//
+// plan_t rewrites a simplified expression into the form the evaluators run.
+// A sum of monomials in X (c * x^k, or such a monomial times another sum)
+// becomes one Horner node, so a polynomial of degree n costs n multiply-adds.
+// Products and powers of sums are not expanded, so a plan adds no
+// cancellation the input did not have, and a sparse polynomial such as
+// x^12 + 1 keeps its terms when they are cheaper than Horner form.
+// Remaining powers become square-and-multiply chains whose repeated squares
+// nodes_t evaluates once, and half-integral powers route to Sqrt.
+
+/// Coefficients of a polynomial in X, constant term first
+template <auto... Cs>
+struct Coefficients {
+    static constexpr std::size_t size = sizeof...(Cs);
+};
+
+/// Marker for expressions that are not sums of monomials in X
+struct NotPolynomial {};
+
+/// Coefficient I, zero past the degree
+template <std::size_t I, auto... Cs>
+constexpr auto coefficient(Coefficients<Cs...>) {
+    if constexpr (I < sizeof...(Cs)) {
+        return std::get<I>(std::tuple{Cs...});
+    }
+    else {
+        return 0;
+    }
+}
+
+/// Degree, ignoring zero coefficients at the top
+template <auto... Cs>
+constexpr auto degree_of(Coefficients<Cs...>) -> std::size_t {
+    std::size_t degree = 0;
+    std::size_t i = 0;
+    ((degree = Cs != 0 ? i : degree, ++i), ...);
+    return degree;
+}
+
+/// Number of nonzero coefficients
+template <auto... Cs>
+constexpr auto term_count(Coefficients<Cs...>) -> std::size_t {
+    return (std::size_t{0} + ... + (Cs != 0 ? 1 : 0));
+}
+
+/// Zero padding for shifted coefficients
+template <std::size_t>
+inline constexpr int zero_coefficient = 0;
+
+/// Drop zero coefficients above the degree
+template <typename P, typename = std::make_index_sequence<degree_of(P{}) + 1>>
+struct TrimCoefficients;
+
+template <auto... Cs, std::size_t... I>
+struct TrimCoefficients<Coefficients<Cs...>, std::index_sequence<I...>> {
+    using Result = Coefficients<coefficient<I>(Coefficients<Cs...>{})...>;
+};
+
+/// Sum of two polynomials
+template <typename A, typename B>
+struct PolyAdd {
+    using Result = NotPolynomial;
+};
+
+template <auto... As, auto... Bs>
+struct PolyAdd<Coefficients<As...>, Coefficients<Bs...>> {
+protected:
+    static constexpr std::size_t size = sizeof...(As) > sizeof...(Bs) ? sizeof...(As) : sizeof...(Bs);
+
+    template <typename = std::make_index_sequence<size>>
+    struct Build;
+
+    template <std::size_t... I>
+    struct Build<std::index_sequence<I...>> {
+        using Result = Coefficients<(coefficient<I>(Coefficients<As...>{}) + coefficient<I>(Coefficients<Bs...>{}))...>;
+    };
+
+public:
+    /// Result
+    using Result = typename TrimCoefficients<typename Build<>::Result>::Result;
+};
+
+/// Negated polynomial
+template <typename P>
+struct PolyNeg {
+    using Result = NotPolynomial;
+};
+
+template <auto... Cs>
+struct PolyNeg<Coefficients<Cs...>> {
+    using Result = Coefficients<(-Cs)...>;
+};
+
+/// Polynomial times the monomial C x^K
+template <typename P, auto C, std::size_t K, typename = std::make_index_sequence<K>>
+struct PolyScale;
+
+template <auto... Cs, auto C, std::size_t K, std::size_t... Z>
+struct PolyScale<Coefficients<Cs...>, C, K, std::index_sequence<Z...>> {
+    using Result = typename TrimCoefficients<Coefficients<zero_coefficient<Z>..., (C * Cs)...>>::Result;
+};
+
+/// Product of two polynomials, kept only when one side is a monomial
+template <typename A, typename B>
+struct PolyMul {
+    using Result = NotPolynomial;
+};
+
+template <auto... As, auto... Bs>
+struct PolyMul<Coefficients<As...>, Coefficients<Bs...>> {
+protected:
+    using A = Coefficients<As...>;
+    using B = Coefficients<Bs...>;
+
+    static constexpr auto pick() {
+        if constexpr (term_count(A{}) <= 1) {
+            return std::type_identity<typename PolyScale<B, coefficient<A::size - 1>(A{}), A::size - 1>::Result>{};
+        }
+        else if constexpr (term_count(B{}) <= 1) {
+            return std::type_identity<typename PolyScale<A, coefficient<B::size - 1>(B{}), B::size - 1>::Result>{};
+        }
+        else {
+            return std::type_identity<NotPolynomial>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Power of a polynomial, kept only for a monomial and a non-negative integral exponent
+template <typename P, auto N>
+struct PolyPow {
+    using Result = NotPolynomial;
+};
+
+template <auto... Cs, auto N>
+    requires(std::is_integral_v<decltype(N)> && N >= 0)
+struct PolyPow<Coefficients<Cs...>, N> {
+protected:
+    using P = Coefficients<Cs...>;
+
+    static constexpr auto pick() {
+        if constexpr (term_count(P{}) <= 1) {
+            constexpr auto c = coefficient<P::size - 1>(P{});
+            constexpr auto k = (P::size - 1) * static_cast<std::size_t>(N);
+            return std::type_identity<typename PolyScale<Coefficients<1>, const_pow<c, N>(), k>::Result>{};
+        }
+        else {
+            return std::type_identity<NotPolynomial>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Coefficients of a simplified expression read as a sum of monomials in X, or NotPolynomial
+template <typename E>
+struct Polynomial {
+    using Result = NotPolynomial;
+};
+
+/// Specialization for Var
+template <>
+struct Polynomial<Var> {
+    using Result = Coefficients<0, 1>;
+};
+
+/// Specialization for Const
+template <auto C>
+struct Polynomial<Const<C>> {
+    using Result = Coefficients<C>;
+};
+
+/// Specialization for Add
+template <typename L, typename R>
+struct Polynomial<Add<L, R>> {
+    using Result = typename PolyAdd<typename Polynomial<L>::Result, typename Polynomial<R>::Result>::Result;
+};
+
+/// Specialization for Sub
+template <typename L, typename R>
+struct Polynomial<Sub<L, R>> {
+    using Result = typename PolyAdd<typename Polynomial<L>::Result,
+                                    typename PolyNeg<typename Polynomial<R>::Result>::Result>::Result;
+};
+
+/// Specialization for Neg
+template <typename E>
+struct Polynomial<Neg<E>> {
+    using Result = typename PolyNeg<typename Polynomial<E>::Result>::Result;
+};
+
+/// Specialization for Mul
+template <typename L, typename R>
+struct Polynomial<Mul<L, R>> {
+    using Result = typename PolyMul<typename Polynomial<L>::Result, typename Polynomial<R>::Result>::Result;
+};
+
+/// Specialization for Pow
+template <typename E, auto N>
+struct Polynomial<Pow<E, N>> {
+    using Result = typename PolyPow<typename Polynomial<E>::Result, N>::Result;
+};
+
+/// Whether Horner form is no more work than evaluating the terms directly.
+/// Direct evaluation shares the squares of x, then pays for each term its
+/// extra chain multiplications, its coefficient and its addition.
+constexpr auto horner_pays(NotPolynomial) -> bool {
+    return false;
+}
+
+template <auto... Cs>
+constexpr auto horner_pays(Coefficients<Cs...>) -> bool {
+    constexpr std::size_t degree = sizeof...(Cs) - 1;
+    const bool nonzero[] = {(Cs != 0)...};
+    const bool unit[] = {(Cs == 1)...};
+    std::size_t direct = degree > 0 ? std::bit_width(degree) - 1 : 0;
+    std::size_t terms = 0;
+    for (std::size_t k = 0; k <= degree; ++k) {
+        if (nonzero[k]) {
+            ++terms;
+            direct += k > 0 ? std::popcount(k) - 1 + (unit[k] ? 0 : 1) : 0;
+        }
+    }
+    direct += terms > 0 ? terms - 1 : 0;
+    return terms >= 2 && degree <= direct;
+}
+
+/// Horner node for a list of coefficients
+template <typename P, typename = std::make_index_sequence<P::size>>
+struct ToHorner;
+
+template <auto... Cs, std::size_t... I>
+struct ToHorner<Coefficients<Cs...>, std::index_sequence<I...>> {
+    using Result = Horner<coefficient<sizeof...(Cs) - 1 - I>(Coefficients<Cs...>{})...>;
+};
+
+/// B^K for K >= 1 by square-and-multiply; each square is one type, so nodes_t computes it once
+template <typename B, std::size_t K>
+struct SquareMultiply {
+protected:
+    using Half = typename SquareMultiply<B, K / 2>::Result;
+
+public:
+    /// Result
+    using Result = std::conditional_t<K % 2 == 0, Mul<Half, Half>, Mul<B, Mul<Half, Half>>>;
+};
+
+/// Base case
+template <typename B>
+struct SquareMultiply<B, 1> {
+    using Result = B;
+};
+
+/// Plan for B^N with B already planned
+template <typename B, auto N>
+struct PowerPlan {
+protected:
+    /// Largest floating exponent turned into a chain
+    static constexpr long long limit = 1LL << 20;
+
+    /// 2N if it is an integer, otherwise 0
+    static constexpr auto twice() -> long long {
+        if constexpr (std::is_integral_v<decltype(N)>) {
+            return 2 * static_cast<long long>(N);
+        }
+        else {
+            const auto t = 2 * N;
+            return t > -limit && t < limit && t == static_cast<long long>(t) ? static_cast<long long>(t) : 0;
+        }
+    }
+
+    static constexpr long long halves = twice();
+    static constexpr std::size_t whole = static_cast<std::size_t>(halves < 0 ? -halves : halves) / 2;
+
+    template <std::size_t K, bool Root>
+    struct Magnitude : std::type_identity<Mul<typename SquareMultiply<B, K>::Result, Sqrt<B>>> {};
+
+    template <std::size_t K>
+    struct Magnitude<K, false> : std::type_identity<typename SquareMultiply<B, K>::Result> {};
+
+    template <bool Root>
+    struct Magnitude<0, Root> : std::type_identity<Sqrt<B>> {};
+
+    static constexpr auto pick() {
+        if constexpr (N == 0) {
+            return std::type_identity<Const<1>>{};
+        }
+        else if constexpr (halves == 0) {
+            return std::type_identity<Pow<B, N>>{};
+        }
+        else {
+            using M = typename Magnitude<whole, halves % 2 != 0>::type;
+            return std::type_identity<std::conditional_t<(halves < 0), Div<Const<1>, M>, M>>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+template <typename E>
+struct Plan;
+
+/// Plan the children of a node
+template <typename E>
+struct PlanChildren {
+    using Result = E;
+};
+
+/// Specialization for unary nodes
+template <template <typename> class Op, typename A>
+struct PlanChildren<Op<A>> {
+    using Result = Op<typename Plan<A>::Result>;
+};
+
+/// Specialization for binary nodes
+template <template <typename, typename> class Op, typename L, typename R>
+struct PlanChildren<Op<L, R>> {
+    using Result = Op<typename Plan<L>::Result, typename Plan<R>::Result>;
+};
+
+/// Specialization for Pow
+template <typename B, auto N>
+struct PlanChildren<Pow<B, N>> {
+    using Result = typename PowerPlan<typename Plan<B>::Result, N>::Result;
+};
+
+/// Evaluation plan of a simplified expression
+template <typename E>
+struct Plan {
+protected:
+    using P = typename Polynomial<E>::Result;
+
+    static constexpr auto pick() {
+        if constexpr (horner_pays(P{})) {
+            return std::type_identity<typename ToHorner<P>::Result>{};
+        }
+        else {
+            return std::type_identity<typename PlanChildren<E>::Result>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Alias for the plan of an expression, after simplification
+template <Expression E>
+using plan_t = typename Plan<simplify_t<E>>::Result;
+
+// Evaluation
+//
+// Expressions are evaluated through their plan, over its distinct
+// subexpressions in post-order. Each distinct node is computed exactly once
+// and stored in a slot, so a subterm shared by several parents (as happens in
+// derivatives and square-and-multiply chains) costs one evaluation.
+
+/// Ordered list of distinct subexpressions
+template <typename... Nodes>
+struct NodeList {
+    static constexpr std::size_t size = sizeof...(Nodes);
+};
+
+/// Direct children of an expression node
+template <typename E>
+struct Children {
+    using Result = NodeList<>;
+};
+
+/// Specialization for unary nodes
+template <template <typename> class Op, typename A>
+struct Children<Op<A>> {
+    using Result = NodeList<A>;
+};
+
+/// Specialization for binary nodes
+template <template <typename, typename> class Op, typename L, typename R>
+struct Children<Op<L, R>> {
+    using Result = NodeList<L, R>;
+};
+
+/// Specialization for Pow
+template <typename B, auto N>
+struct Children<Pow<B, N>> {
+    using Result = NodeList<B>;
+};
+
+/// Collect the distinct nodes of E into List, children first
+template <typename List, typename E>
+struct CollectNodes;
+
+/// Collect every expression of a NodeList into List
+template <typename List, typename Es>
+struct CollectAll;
+
+/// Base case
+template <typename List>
+struct CollectAll<List, NodeList<>> {
+    using Result = List;
+};
+
+/// Recursive case
+template <typename List, typename E, typename... Es>
+struct CollectAll<List, NodeList<E, Es...>> {
+    using Result = typename CollectAll<typename CollectNodes<List, E>::Result, NodeList<Es...>>::Result;
+};
+
+template <typename... Nodes, typename E>
+struct CollectNodes<NodeList<Nodes...>, E> {
+protected:
+    template <bool Seen, typename Collected>
+    struct Insert {
+        using Result = Collected;
+    };
+
+    template <typename... Collected>
+    struct Insert<false, NodeList<Collected...>> {
+        using Result = NodeList<Collected..., E>;
+    };
+
+    static constexpr bool seen = (std::is_same_v<E, Nodes> || ...);
+    using WithChildren = std::conditional_t<seen, NodeList<Nodes...>,
+                                            typename CollectAll<NodeList<Nodes...>, typename Children<E>::Result>::Result>;
+
+public:
+    /// Result
+    using Result = typename Insert<seen, WithChildren>::Result;
+};
+
+/// Alias for the distinct nodes of an expression
+template <Expression E>
+using nodes_t = typename CollectNodes<NodeList<>, E>::Result;
+
+/// Alias for the distinct nodes of several expressions; subexpressions they share appear once
+template <typename... Es>
+using joint_nodes_t = typename CollectAll<NodeList<>, NodeList<Es...>>::Result;
+
+/// Number of distinct subexpressions of an expression
+template <Expression E>
+inline constexpr std::size_t node_count_v = nodes_t<E>::size;
+
+/// Position of E in a NodeList
+template <typename E, typename... Nodes>
+constexpr std::size_t slot_of(NodeList<Nodes...>) {
+    std::size_t index = 0;
+    (void)((std::is_same_v<E, Nodes> ? false : (++index, true)) && ...);
+    return index;
+}
+
+/// Value and first derivative of an expression at a point
+template <typename T>
+struct Dual {
+    T value;
+    T derivative;
+};
+
+/// Per-node evaluation rules, reading operands from earlier slots; transcendental nodes go through the
+/// Accuracy policy
+template <typename E>
+struct NodeRule;
+
+/// Specialization for Var
+template <>
+struct NodeRule<Var> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T*, T x) -> T {
+        return x;
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>*, T x) -> Dual<T> {
+        return {x, T{1}};
+    }
+};
+
+/// Specialization for Const
+template <auto C>
+struct NodeRule<Const<C>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T*, T) -> T {
+        return static_cast<T>(C);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>*, T) -> Dual<T> {
+        return {static_cast<T>(C), T{0}};
+    }
+};
+
+/// Specialization for Add
+template <typename L, typename R>
+struct NodeRule<Add<L, R>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return s[slot_of<L>(List{})] + s[slot_of<R>(List{})];
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& l = s[slot_of<L>(List{})];
+        const auto& r = s[slot_of<R>(List{})];
+        return {l.value + r.value, l.derivative + r.derivative};
+    }
+};
+
+/// Specialization for Sub
+template <typename L, typename R>
+struct NodeRule<Sub<L, R>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return s[slot_of<L>(List{})] - s[slot_of<R>(List{})];
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& l = s[slot_of<L>(List{})];
+        const auto& r = s[slot_of<R>(List{})];
+        return {l.value - r.value, l.derivative - r.derivative};
+    }
+};
+
+/// Specialization for Mul (product rule)
+template <typename L, typename R>
+struct NodeRule<Mul<L, R>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return s[slot_of<L>(List{})] * s[slot_of<R>(List{})];
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& l = s[slot_of<L>(List{})];
+        const auto& r = s[slot_of<R>(List{})];
+        return {l.value * r.value, l.derivative * r.value + l.value * r.derivative};
+    }
+};
+
+/// Specialization for Div (quotient rule)
+template <typename L, typename R>
+struct NodeRule<Div<L, R>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return s[slot_of<L>(List{})] / s[slot_of<R>(List{})];
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& l = s[slot_of<L>(List{})];
+        const auto& r = s[slot_of<R>(List{})];
+        const T q = l.value / r.value;
+        return {q, (l.derivative - q * r.derivative) / r.value};
+    }
+};
+
+/// Specialization for Neg
+template <typename E>
+struct NodeRule<Neg<E>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return -s[slot_of<E>(List{})];
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        return {-e.value, -e.derivative};
+    }
+};
+
+/// a * b + c, rounded once where the target has a fast fma
+template <typename T>
+constexpr auto multiply_add(T a, T b, T c) -> T {
+#ifdef FP_FAST_FMA
+    if constexpr (std::is_same_v<T, double>) {
+        if (!std::is_constant_evaluated()) {
+            return std::fma(a, b, c);
+        }
+    }
+#endif
+#ifdef FP_FAST_FMAF
+    if constexpr (std::is_same_v<T, float>) {
+        if (!std::is_constant_evaluated()) {
+            return std::fma(a, b, c);
+        }
+    }
+#endif
+    return a * b + c;
+}
+
+/// Specialization for Horner, one multiply-add per degree
+template <auto... Cs>
+struct NodeRule<Horner<Cs...>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T*, T x) -> T {
+        const T c[] = {static_cast<T>(Cs)...};
+        T p = c[0];
+        for (std::size_t i = 1; i < sizeof...(Cs); ++i) {
+            p = multiply_add(p, x, c[i]);
+        }
+        return p;
+    }
+
+    /// The derivative runs its own Horner recurrence alongside the value
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>*, T x) -> Dual<T> {
+        const T c[] = {static_cast<T>(Cs)...};
+        T p = c[0];
+        T d{0};
+        for (std::size_t i = 1; i < sizeof...(Cs); ++i) {
+            d = multiply_add(d, x, p);
+            p = multiply_add(p, x, c[i]);
+        }
+        return {p, d};
+    }
+};
+
+/// x^N, by square-and-multiply for integral exponents
+template <auto N, typename T>
+constexpr auto power(T x) -> T {
+    if constexpr (std::is_integral_v<decltype(N)>) {
+        T result{1};
+        for (auto bits = static_cast<unsigned long long>(N < 0 ? -N : N); bits != 0; bits >>= 1) {
+            if (bits & 1) {
+                result *= x;
+            }
+            if (bits > 1) {
+                x *= x;
+            }
+        }
+        return N < 0 ? T{1} / result : result;
+    }
+    else {
+        return std::pow(x, static_cast<T>(N));
+    }
+}
+
+/// Specialization for Pow
+template <typename E, auto N>
+struct NodeRule<Pow<E, N>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return power<N>(s[slot_of<E>(List{})]);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        return {power<N>(e.value), static_cast<T>(N) * power<N - 1>(e.value) * e.derivative};
+    }
+};
+
+/// Specialization for Sin (chain rule)
+template <typename E>
+struct NodeRule<Sin<E>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return Accuracy::sin(s[slot_of<E>(List{})]);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        return {Accuracy::sin(e.value), Accuracy::cos(e.value) * e.derivative};
+    }
+};
+
+/// Specialization for Cos (chain rule)
+template <typename E>
+struct NodeRule<Cos<E>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return Accuracy::cos(s[slot_of<E>(List{})]);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        return {Accuracy::cos(e.value), -Accuracy::sin(e.value) * e.derivative};
+    }
+};
+
+/// Specialization for Tan (chain rule)
+template <typename E>
+struct NodeRule<Tan<E>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return Accuracy::tan(s[slot_of<E>(List{})]);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        const T t = Accuracy::tan(e.value);
+        return {t, (T{1} + t * t) * e.derivative};
+    }
+};
+
+/// Specialization for Exp (chain rule)
+template <typename E>
+struct NodeRule<Exp<E>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return Accuracy::exp(s[slot_of<E>(List{})]);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        const T v = Accuracy::exp(e.value);
+        return {v, v * e.derivative};
+    }
+};
+
+/// Specialization for Log (chain rule)
+template <typename E>
+struct NodeRule<Log<E>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return Accuracy::log(s[slot_of<E>(List{})]);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        return {Accuracy::log(e.value), e.derivative / e.value};
+    }
+};
+
+/// Specialization for Sqrt (chain rule)
+template <typename E>
+struct NodeRule<Sqrt<E>> {
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto value(const T* s, T) -> T {
+        return Accuracy::sqrt(s[slot_of<E>(List{})]);
+    }
+
+    template <typename List, typename Accuracy, typename T>
+    static constexpr auto dual(const Dual<T>* s, T) -> Dual<T> {
+        const auto& e = s[slot_of<E>(List{})];
+        const T v = Accuracy::sqrt(e.value);
+        return {v, e.derivative / (T{2} * v)};
+    }
+};
+
+/// Single pass over a NodeList
+template <typename List, AccuracyPolicy Accuracy = accuracy::Libm>
+struct EvalPass;
+
+template <typename... Nodes, AccuracyPolicy Accuracy>
+struct EvalPass<NodeList<Nodes...>, Accuracy> {
+protected:
+    using List = NodeList<Nodes...>;
+
+    template <typename T, std::size_t... I>
+    static constexpr auto run_value(T x, std::index_sequence<I...>) -> T {
+        T slots[sizeof...(Nodes)]{};
+        ((slots[I] = NodeRule<Nodes>::template value<List, Accuracy>(slots, x)), ...);
+        return slots[sizeof...(Nodes) - 1];
+    }
+
+    template <typename... Roots, typename T, std::size_t... I>
+    static constexpr auto run_values(T x, std::index_sequence<I...>) -> std::array<T, sizeof...(Roots)> {
+        T slots[sizeof...(Nodes)]{};
+        ((slots[I] = NodeRule<Nodes>::template value<List, Accuracy>(slots, x)), ...);
+        return {slots[slot_of<Roots>(List{})]...};
+    }
+
+    template <typename T, std::size_t... I>
+    static constexpr auto run_dual(T x, std::index_sequence<I...>) -> Dual<T> {
+        Dual<T> slots[sizeof...(Nodes)]{};
+        ((slots[I] = NodeRule<Nodes>::template dual<List, Accuracy>(slots, x)), ...);
+        return slots[sizeof...(Nodes) - 1];
+    }
+
+public:
+    /// Value of the last node
+    template <typename T>
+    static constexpr auto value(T x) -> T {
+        return run_value(x, std::index_sequence_for<Nodes...>{});
+    }
+
+    /// Values of the given nodes, all from one pass
+    template <typename... Roots, typename T>
+    static constexpr auto values(T x) -> std::array<T, sizeof...(Roots)> {
+        return run_values<Roots...>(x, std::index_sequence_for<Nodes...>{});
+    }
+
+    /// Value and derivative of the last node
+    template <typename T>
+    static constexpr auto dual(T x) -> Dual<T> {
+        return run_dual(x, std::index_sequence_for<Nodes...>{});
+    }
+};
+
+/// Evaluate an expression at x, with transcendental nodes computed under Accuracy
+template <Expression E, AccuracyPolicy Accuracy = accuracy::Libm, typename T>
+constexpr auto evaluate(T x) -> T {
+    return EvalPass<nodes_t<plan_t<E>>, Accuracy>::value(x);
+}
+
+/// Evaluate an expression and its derivative at x in one fused pass
+template <Expression E, AccuracyPolicy Accuracy = accuracy::Libm, typename T>
+constexpr auto value_and_derivative(T x) -> Dual<T> {
+    return EvalPass<nodes_t<plan_t<E>>, Accuracy>::dual(x);
+}
+
 // Differentiation
 //
-inline auto mul = [](auto a, auto b) { return a * b; };
+// Symbolic derivative with respect to X. The input is simplified first and
+// every rule rebuilds its result through the Simplify* builders, so zero and
+// unit factors never enter the derivative tree.
 
-// type of mul
-inline auto& t_i = typeid(mul);
+/// Derivative
+template <typename E>
+struct Derive;
+
+/// d/dx x = 1
+template <>
+struct Derive<Var> {
+    using Result = Const<1>;
+};
+
+/// d/dx c = 0
+template <auto C>
+struct Derive<Const<C>> {
+    using Result = Const<0>;
+};
+
+/// Other variables are constant with respect to X
+template <std::size_t I>
+struct Derive<Arg<I>> {
+    using Result = Const<0>;
+};
+
+/// Sum rule
+template <typename L, typename R>
+struct Derive<Add<L, R>> {
+    using Result = typename SimplifyAdd<typename Derive<L>::Result, typename Derive<R>::Result>::Result;
+};
+
+/// Difference rule
+template <typename L, typename R>
+struct Derive<Sub<L, R>> {
+    using Result = typename SimplifySub<typename Derive<L>::Result, typename Derive<R>::Result>::Result;
+};
+
+/// Product rule
+template <typename L, typename R>
+struct Derive<Mul<L, R>> {
+    using Result = typename SimplifyAdd<typename SimplifyMul<typename Derive<L>::Result, R>::Result,
+                                        typename SimplifyMul<L, typename Derive<R>::Result>::Result>::Result;
+};
+
+/// Quotient rule
+template <typename L, typename R>
+struct Derive<Div<L, R>> {
+protected:
+    using Numerator = typename SimplifySub<typename SimplifyMul<typename Derive<L>::Result, R>::Result,
+                                           typename SimplifyMul<L, typename Derive<R>::Result>::Result>::Result;
+
+public:
+    /// Result
+    using Result = typename SimplifyDiv<Numerator, typename SimplifyPow<R, 2>::Result>::Result;
+};
+
+/// Negation
+template <typename E>
+struct Derive<Neg<E>> {
+    using Result = typename SimplifyNeg<typename Derive<E>::Result>::Result;
+};
+
+/// Power rule
+template <typename E, auto N>
+struct Derive<Pow<E, N>> {
+protected:
+    using Outer = typename SimplifyMul<Const<N>, typename SimplifyPow<E, N - 1>::Result>::Result;
+
+public:
+    /// Result
+    using Result = typename SimplifyMul<Outer, typename Derive<E>::Result>::Result;
+};
+
+/// d/dx sin(E) = cos(E) E'
+template <typename E>
+struct Derive<Sin<E>> {
+    using Result = typename SimplifyMul<Cos<E>, typename Derive<E>::Result>::Result;
+};
+
+/// d/dx cos(E) = -sin(E) E'
+template <typename E>
+struct Derive<Cos<E>> {
+    using Result = typename SimplifyNeg<typename SimplifyMul<Sin<E>, typename Derive<E>::Result>::Result>::Result;
+};
+
+/// d/dx tan(E) = E' / cos(E)^2
+template <typename E>
+struct Derive<Tan<E>> {
+    using Result = typename SimplifyDiv<typename Derive<E>::Result, Pow<Cos<E>, 2>>::Result;
+};
+
+/// d/dx exp(E) = exp(E) E'
+template <typename E>
+struct Derive<Exp<E>> {
+    using Result = typename SimplifyMul<Exp<E>, typename Derive<E>::Result>::Result;
+};
+
+/// d/dx log(E) = E' / E
+template <typename E>
+struct Derive<Log<E>> {
+    using Result = typename SimplifyDiv<typename Derive<E>::Result, E>::Result;
+};
+
+/// d/dx sqrt(E) = E' / (2 sqrt(E))
+template <typename E>
+struct Derive<Sqrt<E>> {
+    using Result = typename SimplifyDiv<typename Derive<E>::Result, Mul<Const<2>, Sqrt<E>>>::Result;
+};
+
+/// d/dx of a Horner node, again in Horner form
+template <auto... Cs>
+struct Derive<Horner<Cs...>> {
+protected:
+    static constexpr std::size_t degree = sizeof...(Cs) - 1;
+
+    template <typename = std::make_index_sequence<degree>>
+    struct Build;
+
+    template <std::size_t... I>
+    struct Build<std::index_sequence<I...>> {
+        using Result = Horner<(static_cast<int>(degree - I) * std::get<I>(std::tuple{Cs...}))...>;
+    };
+
+    static constexpr auto pick() {
+        if constexpr (degree == 1) {
+            return std::type_identity<Const<std::get<0>(std::tuple{Cs...})>>{};
+        }
+        else {
+            return std::type_identity<typename Build<>::Result>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Alias for Derive
+template <Expression E>
+using derive_t = typename Derive<simplify_t<E>>::Result;
 
 
 } // namespace typical
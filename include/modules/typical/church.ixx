@@ -77,8 +77,14 @@ using Append = Abs<Abs<App<App<Var<1>, Cons>, Var<0>>>>;
 /// Reverse = λl.FoldL l (Nil) (λacc.λx.Append acc (MakeCons x Nil))
 using Reverse = Abs<App<App<Var<0>, Abs<Abs<App<App<Append, Var<0>>, MakeCons<Var<1>, Nil>>>>>, Nil>>;
 
+/// Nth = λn.λl.Head (n Tail l)  -- element n, counting from 0; each Tail traverses the list
+using Nth = Abs<Abs<App<Head, App<App<Var<1>, Tail>, Var<0>>>>>;
+
 // Church arithmetic operations
 
+/// Pred = λn.λf.λx.n (λg.λh.h (g f)) (λu.x) (λu.u)  -- Pred 0 = 0; rebuilds all n applications
+using Pred = Abs<Abs<Abs<App<App<App<Var<2>, Abs<Abs<App<Var<0>, App<Var<1>, Var<3>>>>>>, Abs<Var<1>>>, Abs<Var<0>>>>>>;
+
 /// Sum = λm.λn.m (λx.λy.S y) n
 using Sum = Abs<App<App<Var<0>, Abs<Abs<App<App<Add, Var<1>>, Var<0>>>>>, Zero>>;
 
@@ -185,4 +191,100 @@ using IsLeft = Abs<App<App<Var<0>, Abs<True>>, Abs<False>>>;
 
 /// IsRight = λe.e (λx.False) (λy.True)
 using IsRight = Abs<App<App<Var<0>, Abs<False>>, Abs<True>>>;
+
+// Named combinators
+
+/// The same definitions as Named nodes: substitution copies one node instead of
+/// the whole definition, and normalize_t reads them back to identical normal forms.
+namespace named {
+
+struct SuccTag;
+struct AddTag;
+struct MulTag;
+struct PairTag;
+struct ConsTag;
+struct LengthTag;
+struct MapTag;
+struct FilterTag;
+struct AppendTag;
+struct ReverseTag;
+struct SumTag;
+struct ProductTag;
+
+using Succ = Named<SuccTag, typical::Succ>;
+using Add = Named<AddTag, typical::Add>;
+using Mul = Named<MulTag, typical::Mul>;
+using Pair = Named<PairTag, typical::Pair>;
+using Cons = Named<ConsTag, typical::Cons>;
+
+/// Cons built from the named Cons
+template <typename Head, typename Tail>
+using MakeCons = App<App<Cons, Head>, Tail>;
+
+using Length = Named<LengthTag, Abs<App<App<Var<0>, Abs<Abs<App<Succ, Var<0>>>>>, Zero>>>;
+using Map = Named<MapTag, Abs<Abs<App<App<Var<0>, Abs<Abs<MakeCons<App<Var<3>, Var<1>>, Var<0>>>>>, Nil>>>>;
+using Filter = Named<
+    FilterTag,
+    Abs<Abs<App<App<Var<0>, Abs<Abs<App<App<App<Var<3>, Var<1>>, MakeCons<Var<1>, Var<0>>>, Var<0>>>>>, Nil>>>>;
+using Append = Named<AppendTag, Abs<Abs<App<App<Var<1>, Cons>, Var<0>>>>>;
+using Reverse =
+    Named<ReverseTag, Abs<App<App<Var<0>, Abs<Abs<App<App<Append, Var<0>>, MakeCons<Var<1>, Nil>>>>>, Nil>>>;
+using Sum = Named<SumTag, Abs<App<App<Var<0>, Abs<Abs<App<App<Add, Var<1>>, Var<0>>>>>, Zero>>>;
+using Product = Named<ProductTag, Abs<App<App<Var<0>, Abs<Abs<App<App<Mul, Var<1>>, Var<0>>>>>, One>>>;
+
+} // namespace named
+
+// Church numeral table
+
+/// Entries 0..numeral_table_size of church_numeral_t build under the default template depth
+inline constexpr size_t numeral_table_size = 1024;
+
+/// K applications of f around Body
+template <size_t K, typename Body>
+struct ApplyF {
+    using Result = App<Var<1>, typename ApplyF<K - 1, Body>::Result>;
+};
+
+/// Base case: Body itself
+template <typename Body>
+struct ApplyF<0, Body> {
+    using Result = Body;
+};
+
+/// Body of the numeral 64 * M, built a block of 64 applications at a time
+template <size_t M>
+struct ChurchNumeralBlock {
+    using Result = typename ApplyF<64, typename ChurchNumeralBlock<M - 1>::Result>::Result;
+};
+
+/// Base case: x
+template <>
+struct ChurchNumeralBlock<0> {
+    using Result = Var<0>;
+};
+
+/// Body of the canonical numeral N: f (f (... x)) with N applications.
+/// Instantiation depth is about N / 64 + 64, so entry 1024 builds under the default limit.
+template <size_t N>
+struct ChurchNumeralBody {
+    using Result = typename ApplyF<N % 64, typename ChurchNumeralBlock<N / 64>::Result>::Result;
+};
+
+/// Church numeral N in normal form, λf.λx.f^N x
+template <size_t N>
+struct ChurchNumeral {
+    using Result = Abs<Abs<typename ChurchNumeralBody<N>::Result>>;
+};
+
+/// Alias for ChurchNumeral
+template <size_t N>
+using church_numeral_t = typename ChurchNumeral<N>::Result;
+
+/// Normal form of Add M N on canonical numerals, looked up by index instead of reduced
+template <size_t M, size_t N>
+using church_sum_t = church_numeral_t<M + N>;
+
+/// Normal form of Mul M N on canonical numerals, looked up by index instead of reduced
+template <size_t M, size_t N>
+using church_product_t = church_numeral_t<M * N>;
 } // namespace typical
@@ -0,0 +1,631 @@
+module;
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+
+export module typical.combinator;
+
+import typical.lambda;
+import typical.church;
+import typical.lower;
+
+export namespace typical {
+
+// Combinators
+// ----------------
+//
+// Combinator terms are built from the basis atoms with App; a free variable
+// stays a Var. The atoms live in namespace ski, next to the Id and Const of
+// typical.lambda.
+
+namespace ski {
+
+/// S f g x = f x (g x)
+struct S {};
+
+/// K x y = x
+struct K {};
+
+/// I x = x
+struct I {};
+
+/// B f g x = f (g x)
+struct B {};
+
+/// C f g x = f x g
+struct C {};
+
+} // namespace ski
+
+/// Type trait to identify basis combinators
+template <typename T>
+struct is_combinator : std::false_type {};
+
+/// Specialization for S
+template <>
+struct is_combinator<ski::S> : std::true_type {};
+
+/// Specialization for K
+template <>
+struct is_combinator<ski::K> : std::true_type {};
+
+/// Specialization for I
+template <>
+struct is_combinator<ski::I> : std::true_type {};
+
+/// Specialization for B
+template <>
+struct is_combinator<ski::B> : std::true_type {};
+
+/// Specialization for C
+template <>
+struct is_combinator<ski::C> : std::true_type {};
+
+/// Number of atoms and applications in a combinator term
+template <typename Term>
+struct CombinatorSize {
+    static constexpr size_t value = 1;
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct CombinatorSize<App<Func, Arg>> {
+    static constexpr size_t value = CombinatorSize<Func>::value + CombinatorSize<Arg>::value + 1;
+};
+
+/// Helper variable for CombinatorSize
+template <typename Term>
+inline constexpr size_t combinator_size_v = CombinatorSize<Term>::value;
+
+// Bracket abstraction
+// ----------------
+//
+// A lambda term is translated bottom-up: the body of an Abs is translated
+// first, so abstraction only ever sees atoms, applications and variables, and
+// the bound variable is Var<0>. Turner's rules keep the result linear in the
+// common cases: a body without the variable becomes K E, an eta-redex E x
+// becomes E, and a variable used on only one side of an application becomes
+// B or C instead of S.
+
+/// Indicates if Var<0> occurs in a combinator term
+template <typename Term>
+struct OccursZero : std::false_type {};
+
+/// Specialization for Var<0>
+template <>
+struct OccursZero<Var<0>> : std::true_type {};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct OccursZero<App<Func, Arg>> : std::bool_constant<OccursZero<Func>::value || OccursZero<Arg>::value> {};
+
+/// A term without Var<0> moved out of its binder: every variable index drops by one
+template <typename Term>
+struct Unbind {
+    using Result = Term;
+};
+
+/// Specialization for Var
+template <size_t Index>
+struct Unbind<Var<Index>> {
+    static_assert(Index > 0, "Var<0> is bound by the abstraction");
+    using Result = Var<Index - 1>;
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct Unbind<App<Func, Arg>> {
+    using Result = App<typename Unbind<Func>::Result, typename Unbind<Arg>::Result>;
+};
+
+/// Bracket abstraction [x]Term of Var<0>; the general case is a term without it: K Term
+template <typename Term, bool Occurs = OccursZero<Term>::value>
+struct Abstract {
+    using Result = App<ski::K, typename Unbind<Term>::Result>;
+};
+
+/// [x]x = I
+template <>
+struct Abstract<Var<0>, true> {
+    using Result = ski::I;
+};
+
+/// Application that uses the variable
+template <typename Func, typename Arg>
+struct Abstract<App<Func, Arg>, true> {
+protected:
+    static constexpr bool in_func = OccursZero<Func>::value;
+    static constexpr bool in_arg = OccursZero<Arg>::value;
+
+    static constexpr auto pick() {
+        if constexpr (!in_func && std::is_same_v<Arg, Var<0>>) {
+            return std::type_identity<typename Unbind<Func>::Result>{};
+        }
+        else if constexpr (!in_func) {
+            return std::type_identity<
+                App<App<ski::B, typename Unbind<Func>::Result>, typename Abstract<Arg>::Result>>{};
+        }
+        else if constexpr (!in_arg) {
+            return std::type_identity<
+                App<App<ski::C, typename Abstract<Func>::Result>, typename Unbind<Arg>::Result>>{};
+        }
+        else {
+            return std::type_identity<
+                App<App<ski::S, typename Abstract<Func>::Result>, typename Abstract<Arg>::Result>>{};
+        }
+    }
+
+public:
+    /// Result
+    using Result = typename decltype(pick())::type;
+};
+
+/// Translation of a lambda term to combinators
+template <typename Term>
+struct ToSki;
+
+/// Specialization for Var (free variables stay)
+template <size_t Index>
+struct ToSki<Var<Index>> {
+    using Result = Var<Index>;
+};
+
+/// Specialization for Abs
+template <typename Body>
+struct ToSki<Abs<Body>> {
+    using Result = typename Abstract<typename ToSki<Body>::Result>::Result;
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct ToSki<App<Func, Arg>> {
+    using Result = App<typename ToSki<Func>::Result, typename ToSki<Arg>::Result>;
+};
+
+/// Specialization for Named (translated once per definition)
+template <typename Tag, typename Def>
+struct ToSki<Named<Tag, Def>> {
+    using Result = typename ToSki<Def>::Result;
+};
+
+/// Alias for ToSki
+template <typename Term>
+using to_ski_t = typename ToSki<Term>::Result;
+
+// Combinator reduction
+// ----------------
+//
+// A step rewrites the combinator at the head of the spine once it has all its
+// arguments; arguments are passed around as they are, so no step shifts or
+// substitutes anything.
+
+/// One head reduction step; the general case is an atom or a variable, which does not reduce
+template <typename Term>
+struct SkiReduce {
+    using Result = Term;
+    static constexpr bool reduced = false;
+};
+
+/// I x = x
+template <typename X>
+struct SkiReduce<App<ski::I, X>> {
+    using Result = X;
+    static constexpr bool reduced = true;
+};
+
+/// K x y = x
+template <typename X, typename Y>
+struct SkiReduce<App<App<ski::K, X>, Y>> {
+    using Result = X;
+    static constexpr bool reduced = true;
+};
+
+/// S f g x = f x (g x)
+template <typename F, typename G, typename X>
+struct SkiReduce<App<App<App<ski::S, F>, G>, X>> {
+    using Result = App<App<F, X>, App<G, X>>;
+    static constexpr bool reduced = true;
+};
+
+/// B f g x = f (g x)
+template <typename F, typename G, typename X>
+struct SkiReduce<App<App<App<ski::B, F>, G>, X>> {
+    using Result = App<F, App<G, X>>;
+    static constexpr bool reduced = true;
+};
+
+/// C f g x = f x g
+template <typename F, typename G, typename X>
+struct SkiReduce<App<App<App<ski::C, F>, G>, X>> {
+    using Result = App<App<F, X>, G>;
+    static constexpr bool reduced = true;
+};
+
+/// Application whose head is not a complete redex: step the function
+template <typename Func, typename Arg>
+struct SkiReduce<App<Func, Arg>> {
+    using Result = App<typename SkiReduce<Func>::Result, Arg>;
+    static constexpr bool reduced = SkiReduce<Func>::reduced;
+};
+
+/// Alias for SkiReduce
+template <typename Term>
+using ski_reduce_t = typename SkiReduce<Term>::Result;
+
+/// Evaluation loop
+template <typename Term, size_t MaxSteps, bool Reduces = MaxSteps != 0 && SkiReduce<Term>::reduced>
+struct SkiEvalLoop {
+    using Result = Term;
+    static constexpr size_t steps = 0;
+    static constexpr bool exhausted = MaxSteps == 0 && SkiReduce<Term>::reduced;
+};
+
+/// Specialization for a term that reduces
+template <typename Term, size_t MaxSteps>
+struct SkiEvalLoop<Term, MaxSteps, true> {
+private:
+    using Next = SkiEvalLoop<ski_reduce_t<Term>, MaxSteps - 1>;
+
+public:
+    using Result = typename Next::Result;
+    static constexpr size_t steps = Next::steps + 1;
+    static constexpr bool exhausted = Next::exhausted;
+};
+
+/// Evaluation of a combinator term to weak head normal form, as Eval does for lambda terms.
+/// Stops after MaxSteps steps or at a term that no longer reduces; a combinator
+/// term has no binders, so there is no cycle check, and a result cut off by
+/// MaxSteps is flagged by exhausted instead.
+template <typename Term, size_t MaxSteps = 1000>
+struct SkiEval {
+private:
+    using Loop = SkiEvalLoop<Term, MaxSteps>;
+
+public:
+    /// Result after evaluation
+    using Result = typename Loop::Result;
+    /// Reduction steps performed
+    static constexpr size_t steps = Loop::steps;
+    /// Indicates if MaxSteps ran out on a term that still reduces, so Result is not a weak head normal form
+    static constexpr bool exhausted = Loop::exhausted;
+};
+
+/// Alias for SkiEval
+template <typename Term, size_t MaxSteps = 1000>
+using ski_eval_t = typename SkiEval<Term, MaxSteps>::Result;
+
+template <typename Term>
+struct SkiNormalize;
+
+/// Alias for SkiNormalize
+template <typename Term>
+using ski_normalize_t = typename SkiNormalize<Term>::Result;
+
+/// Normalize the arguments of a term already in weak head normal form
+template <typename Term>
+struct SkiNormalizeHead {
+    using Result = Term;
+    static constexpr size_t steps = 0;
+    static constexpr bool exhausted = false;
+};
+
+/// Specialization for App (a stuck application)
+template <typename Func, typename Arg>
+struct SkiNormalizeHead<App<Func, Arg>> {
+    using Result = App<ski_normalize_t<Func>, ski_normalize_t<Arg>>;
+    static constexpr size_t steps = SkiNormalize<Func>::steps + SkiNormalize<Arg>::steps;
+    static constexpr bool exhausted = SkiNormalize<Func>::exhausted || SkiNormalize<Arg>::exhausted;
+};
+
+/// Normalization: evaluate the head, then every argument of the stuck spine
+template <typename Term>
+struct SkiNormalize {
+    /// Result after normalization
+    using Result = typename SkiNormalizeHead<ski_eval_t<Term>>::Result;
+    /// Reduction steps performed, over every subterm
+    static constexpr size_t steps = SkiEval<Term>::steps + SkiNormalizeHead<ski_eval_t<Term>>::steps;
+    /// Indicates if the step limit cut off the evaluation of any subterm, so Result is not a normal form
+    static constexpr bool exhausted = SkiEval<Term>::exhausted || SkiNormalizeHead<ski_eval_t<Term>>::exhausted;
+};
+
+// Readback
+// ----------------
+//
+// Combinator normal forms are not lambda normal forms (Two is S B I), so a
+// closed result is read back by applying it to the free variables Var<1> and
+// Var<0> and normalizing: a numeral leaves f^n x, a boolean one of the two.
+
+/// Lower a closed combinator term of shape Numeral or Boolean
+template <typename Shape, typename Term>
+struct FromSki;
+
+/// Specialization for Numeral
+template <typename Term>
+struct FromSki<Numeral, Term> {
+private:
+    using Applied = App<App<Term, Var<1>>, Var<0>>;
+    using Body = ski_normalize_t<Applied>;
+
+    static_assert(!SkiNormalize<Applied>::exhausted, "combinator term did not normalize within the step limit");
+
+public:
+    /// Indicates if the term behaves as a numeral
+    static constexpr bool matches = NumeralBody<Body>::matches;
+
+    static_assert(matches, "combinator term does not normalize to a numeral");
+
+    /// The number of applications of f
+    static constexpr size_t value = NumeralBody<Body>::value;
+    /// The canonical Church numeral
+    using Result = church_numeral_t<value>;
+};
+
+/// Specialization for Boolean
+template <typename Term>
+struct FromSki<Boolean, Term> {
+private:
+    using Applied = App<App<Term, Var<1>>, Var<0>>;
+    using Body = ski_normalize_t<Applied>;
+
+    static_assert(!SkiNormalize<Applied>::exhausted, "combinator term did not normalize within the step limit");
+
+public:
+    /// Indicates if the term selects one of its two arguments
+    static constexpr bool matches = std::is_same_v<Body, Var<1>> || std::is_same_v<Body, Var<0>>;
+
+    static_assert(matches, "combinator term does not normalize to a boolean");
+
+    /// True when the first argument is selected
+    static constexpr bool value = std::is_same_v<Body, Var<1>>;
+    /// The Church boolean
+    using Result = std::conditional_t<value, True, False>;
+};
+
+/// Helper variable for FromSki
+template <typename Shape, typename Term>
+inline constexpr lowered_t<Shape> from_ski_v = FromSki<Shape, Term>::value;
+
+/// Alias for FromSki
+template <typename Shape, typename Term>
+using from_ski_t = typename FromSki<Shape, Term>::Result;
+
+// Runtime combinator graphs
+// ----------------
+
+/// Node kinds of a runtime combinator term; Ind forwards to the node that replaced a redex
+enum class CombinatorKind : std::uint8_t { S, K, I, B, C, Free, App, Ind };
+
+/// A node of a CombinatorGraph. App uses left and right, Free keeps its index and Ind its target in left.
+struct CombinatorNode {
+    CombinatorKind kind;
+    /// Set once normalize has reached the node
+    bool normal;
+    std::uint32_t left;
+    std::uint32_t right;
+};
+
+/// A mutable combinator graph reduced in place.
+///
+/// Every redex is overwritten by its reduct, so a shared argument is reduced
+/// once for all its uses; I and K leave an indirection to their result. Steps
+/// count rewrites across all calls, and once max_steps is reached reduction
+/// stops and leaves terms as they are.
+class CombinatorGraph {
+public:
+    using Id = std::uint32_t;
+
+    explicit CombinatorGraph(std::size_t max_steps = std::numeric_limits<std::size_t>::max()) : max_steps_(max_steps) {
+        for (const auto kind : {CombinatorKind::S, CombinatorKind::K, CombinatorKind::I, CombinatorKind::B,
+                                CombinatorKind::C}) {
+            nodes_.push_back({kind, true, 0, 0});
+        }
+    }
+
+    /// The shared node of a basis combinator
+    static auto atom(CombinatorKind kind) -> Id { return static_cast<Id>(kind); }
+
+    /// A free variable
+    auto free(std::uint32_t index) -> Id { return push({CombinatorKind::Free, true, index, 0}); }
+
+    /// An application
+    auto app(Id func, Id arg) -> Id { return push({CombinatorKind::App, false, func, arg}); }
+
+    /// The node a term currently stands for, past indirections
+    auto resolve(Id id) const -> Id {
+        while (nodes_[id].kind == CombinatorKind::Ind) {
+            id = nodes_[id].left;
+        }
+        return id;
+    }
+
+    auto node(Id id) const -> const CombinatorNode& { return nodes_[resolve(id)]; }
+    auto size() const -> std::size_t { return nodes_.size(); }
+    auto steps() const -> std::size_t { return steps_; }
+
+    /// Reduce a term to weak head normal form in place; returns its resolved id
+    auto whnf(Id root) -> Id {
+        spine_.clear();
+        Id t = resolve(root);
+        while (true) {
+            while (nodes_[t].kind == CombinatorKind::App) {
+                spine_.push_back(t);
+                t = resolve(nodes_[t].left);
+            }
+            const std::size_t arity = arity_of(nodes_[t].kind);
+            if (arity == 0 || spine_.size() < arity || steps_ == max_steps_) {
+                break;
+            }
+            const std::size_t top = spine_.size();
+            const Id redex = spine_[top - arity];
+            const Id x = nodes_[spine_[top - 1]].right;
+            const Id y = arity > 1 ? nodes_[spine_[top - 2]].right : 0;
+            const Id z = arity > 2 ? nodes_[spine_[top - 3]].right : 0;
+            rewrite(nodes_[t].kind, redex, x, y, z);
+            spine_.resize(top - arity);
+            ++steps_;
+            t = resolve(redex);
+        }
+        return resolve(root);
+    }
+
+    /// Reduce a term to normal form in place; returns its resolved id
+    auto normalize(Id root) -> Id {
+        std::vector<Id> pending{root};
+        while (!pending.empty()) {
+            const Id next = pending.back();
+            pending.pop_back();
+            if (nodes_[resolve(next)].normal) {
+                continue;
+            }
+            Id t = whnf(next);
+            while (nodes_[t].kind == CombinatorKind::App) {
+                nodes_[t].normal = true;
+                pending.push_back(nodes_[t].right);
+                t = resolve(nodes_[t].left);
+            }
+        }
+        return resolve(root);
+    }
+
+    /// Value of a numeral: the count of f in the normal form of term f x; empty for other terms
+    auto numeral(Id term) -> std::optional<std::size_t> {
+        Id t = normalize(app(app(term, free(1)), free(0)));
+        std::size_t count = 0;
+        while (nodes_[t].kind == CombinatorKind::App) {
+            const CombinatorNode& f = node(nodes_[t].left);
+            if (f.kind != CombinatorKind::Free || f.left != 1) {
+                return std::nullopt;
+            }
+            t = resolve(nodes_[t].right);
+            ++count;
+        }
+        if (nodes_[t].kind != CombinatorKind::Free || nodes_[t].left != 0) {
+            return std::nullopt;
+        }
+        return count;
+    }
+
+    /// Value of a boolean: which of two arguments the term selects; empty for other terms
+    auto boolean(Id term) -> std::optional<bool> {
+        const CombinatorNode& selected = nodes_[normalize(app(app(term, free(1)), free(0)))];
+        if (selected.kind != CombinatorKind::Free || selected.left > 1) {
+            return std::nullopt;
+        }
+        return selected.left == 1;
+    }
+
+private:
+    static auto arity_of(CombinatorKind kind) -> std::size_t {
+        switch (kind) {
+        case CombinatorKind::I:
+            return 1;
+        case CombinatorKind::K:
+            return 2;
+        case CombinatorKind::S:
+        case CombinatorKind::B:
+        case CombinatorKind::C:
+            return 3;
+        default:
+            return 0;
+        }
+    }
+
+    auto push(CombinatorNode n) -> Id {
+        nodes_.push_back(n);
+        return static_cast<Id>(nodes_.size() - 1);
+    }
+
+    /// Overwrite redex with the reduct of kind applied to x, y and z
+    void rewrite(CombinatorKind kind, Id redex, Id x, Id y, Id z) {
+        switch (kind) {
+        case CombinatorKind::I:
+        case CombinatorKind::K:
+            nodes_[redex] = {CombinatorKind::Ind, false, x, 0};
+            break;
+        case CombinatorKind::S: {
+            const Id left = app(x, z);
+            const Id right = app(y, z);
+            nodes_[redex] = {CombinatorKind::App, false, left, right};
+            break;
+        }
+        case CombinatorKind::B: {
+            const Id right = app(y, z);
+            nodes_[redex] = {CombinatorKind::App, false, x, right};
+            break;
+        }
+        case CombinatorKind::C: {
+            const Id left = app(x, z);
+            nodes_[redex] = {CombinatorKind::App, false, left, y};
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    std::vector<CombinatorNode> nodes_;
+    std::vector<Id> spine_;
+    std::size_t steps_ = 0;
+    std::size_t max_steps_;
+};
+
+/// Build a CombinatorGraph term from a combinator term type
+template <typename Term>
+struct ReifyCombinator;
+
+/// Specialization for S
+template <>
+struct ReifyCombinator<ski::S> {
+    static auto apply(CombinatorGraph&) -> CombinatorGraph::Id { return CombinatorGraph::atom(CombinatorKind::S); }
+};
+
+/// Specialization for K
+template <>
+struct ReifyCombinator<ski::K> {
+    static auto apply(CombinatorGraph&) -> CombinatorGraph::Id { return CombinatorGraph::atom(CombinatorKind::K); }
+};
+
+/// Specialization for I
+template <>
+struct ReifyCombinator<ski::I> {
+    static auto apply(CombinatorGraph&) -> CombinatorGraph::Id { return CombinatorGraph::atom(CombinatorKind::I); }
+};
+
+/// Specialization for B
+template <>
+struct ReifyCombinator<ski::B> {
+    static auto apply(CombinatorGraph&) -> CombinatorGraph::Id { return CombinatorGraph::atom(CombinatorKind::B); }
+};
+
+/// Specialization for C
+template <>
+struct ReifyCombinator<ski::C> {
+    static auto apply(CombinatorGraph&) -> CombinatorGraph::Id { return CombinatorGraph::atom(CombinatorKind::C); }
+};
+
+/// Specialization for Var (a free variable)
+template <size_t Index>
+struct ReifyCombinator<Var<Index>> {
+    static auto apply(CombinatorGraph& g) -> CombinatorGraph::Id { return g.free(static_cast<std::uint32_t>(Index)); }
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct ReifyCombinator<App<Func, Arg>> {
+    static auto apply(CombinatorGraph& g) -> CombinatorGraph::Id {
+        const auto func = ReifyCombinator<Func>::apply(g);
+        return g.app(func, ReifyCombinator<Arg>::apply(g));
+    }
+};
+
+/// Build a fresh CombinatorGraph term from a combinator term type; use to_ski_t for lambda terms
+template <typename Term>
+auto reify_combinator(CombinatorGraph& graph) -> CombinatorGraph::Id {
+    return ReifyCombinator<Term>::apply(graph);
+}
+
+} // namespace typical
@@ -1,6 +1,7 @@
 module;
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 
 
 export module typical.eq;
@@ -86,8 +87,8 @@ struct Transport;
 template <typename A, typename B, template <typename> class P>
     requires ProvablyEqual<A, B>
 struct Transport<A, B, P, eq_proof<A, B>> {
-
-    static auto apply(P<A> value) -> P<B> { return static_cast<P<B>>(value); }
+    /// A and B are the same type, so an rvalue is moved through without a copy
+    static constexpr auto apply(P<A> value) -> P<B> { return value; }
 
     using From = P<A>;
     using To = P<B>;
@@ -184,11 +185,13 @@ struct SubstPreservesEq {
 };
 
 // Arithmetic proofs
+//
+// Both sides are compared in full normal form, so convertible Church numerals coincide.
 
 template <typename M, typename N>
 struct AddCommutative {
-    using Left = eval_t<App<App<Add, M>, N>>;
-    using Right = eval_t<App<App<Add, N>, M>>;
+    using Left = normalize_t<App<App<Add, M>, N>>;
+    using Right = normalize_t<App<App<Add, N>, M>>;
 
     static constexpr bool commutative = std::is_same_v<Left, Right>;
 
@@ -197,8 +200,8 @@ struct AddCommutative {
 
 template <typename M, typename N, typename P>
 struct AddAssociative {
-    using Left = eval_t<App<App<Add, eval_t<App<App<Add, M>, N>>>, P>>;
-    using Right = eval_t<App<App<Add, M>, eval_t<App<App<Add, N>, P>>>>;
+    using Left = normalize_t<App<App<Add, normalize_t<App<App<Add, M>, N>>>, P>>;
+    using Right = normalize_t<App<App<Add, M>, normalize_t<App<App<Add, N>, P>>>>;
 
     static constexpr bool associative = std::is_same_v<Left, Right>;
 
@@ -207,7 +210,7 @@ struct AddAssociative {
 
 template <typename N>
 struct AddIdentity {
-    using Left = eval_t<App<App<Add, N>, Zero>>;
+    using Left = normalize_t<App<App<Add, N>, Zero>>;
     using Right = N;
 
     static constexpr bool is_identity = std::is_same_v<Left, Right>;
@@ -217,8 +220,8 @@ struct AddIdentity {
 
 template <typename M, typename N, typename P>
 struct MulDistributive {
-    using Left = eval_t<App<App<Mul, M>, eval_t<App<App<Add, N>, P>>>>;
-    using Right = eval_t<App<App<Add, eval_t<App<App<Mul, M>, N>>>, eval_t<App<App<Mul, M>, P>>>>;
+    using Left = normalize_t<App<App<Mul, M>, normalize_t<App<App<Add, N>, P>>>>;
+    using Right = normalize_t<App<App<Add, normalize_t<App<App<Mul, M>, N>>>, normalize_t<App<App<Mul, M>, P>>>>;
 
     static constexpr bool distributive = std::is_same_v<Left, Right>;
 
@@ -246,11 +249,11 @@ struct ListLengthProof {
 
     template <typename List1, typename List2>
     struct AppendLengthProof {
-        using Appended = eval_t<App<App<Append, List1>, List2>>;
-        using Len1 = eval_t<App<Length, List1>>;
-        using Len2 = eval_t<App<Length, List2>>;
-        using LenAppended = eval_t<App<Length, Appended>>;
-        using LenSum = eval_t<App<App<Add, Len1>, Len2>>;
+        using Appended = normalize_t<App<App<Append, List1>, List2>>;
+        using Len1 = normalize_t<App<Length, List1>>;
+        using Len2 = normalize_t<App<Length, List2>>;
+        using LenAppended = normalize_t<App<Length, Appended>>;
+        using LenSum = normalize_t<App<App<Add, Len1>, Len2>>;
 
         static constexpr bool holds = std::is_same_v<LenAppended, LenSum>;
 
@@ -260,9 +263,9 @@ struct ListLengthProof {
 
 template <typename List>
 struct ReverseLengthProof {
-    using Reversed = eval_t<App<Reverse, List>>;
-    using OrigLen = eval_t<App<Length, List>>;
-    using RevLen = eval_t<App<Length, Reversed>>;
+    using Reversed = normalize_t<App<Reverse, List>>;
+    using OrigLen = normalize_t<App<Length, List>>;
+    using RevLen = normalize_t<App<Length, Reversed>>;
 
     static constexpr bool holds = std::is_same_v<OrigLen, RevLen>;
 
@@ -271,9 +274,9 @@ struct ReverseLengthProof {
 
 template <typename Func, typename List>
 struct MapLengthProof {
-    using Mapped = eval_t<App<App<Map, Func>, List>>;
-    using OrigLen = eval_t<App<Length, List>>;
-    using MapLen = eval_t<App<Length, Mapped>>;
+    using Mapped = normalize_t<App<App<Map, Func>, List>>;
+    using OrigLen = normalize_t<App<Length, List>>;
+    using MapLen = normalize_t<App<Length, Mapped>>;
 
     static constexpr bool holds = std::is_same_v<OrigLen, MapLen>;
 
@@ -294,6 +297,159 @@ struct FunctionEq {
     };
 };
 
+// Exhaustive property checking
+
+/// Finite sequence of sample inputs
+template <typename... Ts>
+struct Samples {
+    static constexpr size_t size = sizeof...(Ts);
+};
+
+/// Explicitly listed inputs
+template <typename... Ts>
+struct ValueRange {
+    using Values = Samples<Ts...>;
+};
+
+namespace detail {
+
+template <size_t I, typename T>
+struct IndexedSample {
+    using type = T;
+};
+
+template <typename Indices, typename... Ts>
+struct IndexedSamples;
+
+template <size_t... Is, typename... Ts>
+struct IndexedSamples<std::index_sequence<Is...>, Ts...> : IndexedSample<Is, Ts>... {};
+
+template <size_t I, typename T>
+auto select_sample(IndexedSample<I, T>) -> T;
+
+template <size_t First, typename Indices>
+struct FreeVarList;
+
+template <size_t First, size_t... Is>
+struct FreeVarList<First, std::index_sequence<Is...>> {
+    using Result = BuildList<Var<First + Is>...>;
+};
+
+} // namespace detail
+
+/// I-th sample, selected by overload resolution rather than recursion
+template <size_t I, typename S>
+struct SampleAt;
+
+template <size_t I, typename... Ts>
+struct SampleAt<I, Samples<Ts...>> {
+    using Result =
+        decltype(detail::select_sample<I>(detail::IndexedSamples<std::index_sequence_for<Ts...>, Ts...>{}));
+};
+
+template <size_t I, typename S>
+using sample_at_t = typename SampleAt<I, S>::Result;
+
+/// Church numerals 0..N
+template <size_t N>
+struct ChurchRange {
+private:
+    template <size_t... Ks>
+    static auto build(std::index_sequence<Ks...>) -> Samples<church_numeral_t<Ks>...>;
+
+public:
+    using Values = decltype(build(std::make_index_sequence<N + 1>{}));
+};
+
+/// Church lists of length 0..L whose elements are the distinct free variables First, First + 1, ...
+template <size_t L, size_t First = 100>
+struct ListRange {
+private:
+    template <size_t... Ls>
+    static auto build(std::index_sequence<Ls...>)
+        -> Samples<typename detail::FreeVarList<First, std::make_index_sequence<Ls>>::Result...>;
+
+public:
+    using Values = decltype(build(std::make_index_sequence<L + 1>{}));
+};
+
+/// A proof instance holds when its Proof is an Eq rather than void
+template <typename Instance>
+inline constexpr bool proof_holds_v = !std::is_void_v<typename Instance::Proof>;
+
+/// Check a proof over the Cartesian product of its input ranges.
+///
+/// Every case is instantiated from one flat index sequence, so template depth
+/// stays constant however many cases there are; `cases` is the number of
+/// Property instantiations the check costs.
+template <template <typename...> class Property, typename... Ranges>
+struct CheckForall {
+    static_assert(sizeof...(Ranges) > 0, "CheckForall needs at least one input range.");
+    static_assert(((Ranges::Values::size > 0) && ...), "Input ranges must not be empty.");
+
+private:
+    static constexpr size_t extents[] = {Ranges::Values::size...};
+
+    /// Product of the extents after dimension K; the last range varies fastest
+    static constexpr auto stride(size_t k) -> size_t {
+        size_t result = 1;
+        for (size_t i = k + 1; i < sizeof...(Ranges); ++i) {
+            result *= extents[i];
+        }
+        return result;
+    }
+
+    template <size_t I, size_t... K>
+    static auto inputs(std::index_sequence<K...>)
+        -> Samples<sample_at_t<(I / stride(K)) % extents[K], typename Ranges::Values>...>;
+
+    template <size_t I, size_t... K>
+    static auto instance(std::index_sequence<K...>)
+        -> Property<sample_at_t<(I / stride(K)) % extents[K], typename Ranges::Values>...>;
+
+    template <size_t I>
+    using Case = decltype(instance<I>(std::index_sequence_for<Ranges...>{}));
+
+    template <size_t... Is>
+    static constexpr auto first_failure(std::index_sequence<Is...>) -> size_t {
+        constexpr bool results[] = {proof_holds_v<Case<Is>>...};
+        for (size_t i = 0; i < sizeof...(Is); ++i) {
+            if (!results[i]) {
+                return i;
+            }
+        }
+        return sizeof...(Is);
+    }
+
+    template <bool Found, size_t I>
+    struct CounterexampleAt {
+        using Result = void;
+    };
+
+    template <size_t I>
+    struct CounterexampleAt<true, I> {
+        using Result = decltype(inputs<I>(std::index_sequence_for<Ranges...>{}));
+    };
+
+public:
+    /// Number of cases checked
+    static constexpr size_t cases = (Ranges::Values::size * ...);
+
+    /// Flat index of the first failing case, or cases when all hold
+    static constexpr size_t failure = first_failure(std::make_index_sequence<cases>{});
+
+    static constexpr bool holds = failure == cases;
+
+    /// Samples<...> with the inputs of the first failing case, or void
+    using Counterexample = typename CounterexampleAt<!holds, failure>::Result;
+};
+
+template <template <typename...> class Property, typename... Ranges>
+inline constexpr bool check_forall = CheckForall<Property, Ranges...>::holds;
+
+template <template <typename...> class Property, typename... Ranges>
+using counterexample_t = typename CheckForall<Property, Ranges...>::Counterexample;
+
 // Proof tactics
 
 namespace proof_tactics {
@@ -0,0 +1,229 @@
+module;
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+export module typical.filter;
+
+import typical.lambda;
+import typical.set;
+
+export namespace typical {
+
+// Filter sets
+// ----------------
+//
+// A filter is a set expression over leaf sets: the unevaluated applications
+// App<App<set::Union, A>, B>, App<App<set::Intersertion, A>, B>,
+// App<App<set::Difference, A>, B> and App<set::Complement, A>, with EmptySet,
+// UniversalSet and set::Leaf<I> at the bottom. Leaf I is bound at runtime to
+// the I-th predicate given to make_filter.
+
+namespace set {
+
+/// Leaf set, the rows for which predicate Index holds
+template <size_t Index>
+struct Leaf {};
+
+} // namespace set
+
+/// Word-at-a-time evaluation of a filter set: bit k of each mask is row k of a 64-row block
+template <typename Set>
+struct FilterPlan {
+    static_assert(sizeof(Set) == 0, "filters are built from set::Leaf, EmptySet, UniversalSet and applications of "
+                                    "set::Union, set::Intersertion, set::Difference and set::Complement");
+};
+
+/// Specialization for Leaf
+template <size_t Index>
+struct FilterPlan<set::Leaf<Index>> {
+    /// One more than the largest leaf index
+    static constexpr size_t leaves = Index + 1;
+
+    /// Indicates if leaf I is read
+    template <size_t I>
+    static constexpr bool uses = I == Index;
+
+    template <size_t N>
+    static constexpr auto combine(const std::array<std::uint64_t, N>& masks) -> std::uint64_t {
+        return masks[Index];
+    }
+};
+
+/// Specialization for EmptySet
+template <>
+struct FilterPlan<EmptySet> {
+    static constexpr size_t leaves = 0;
+
+    template <size_t I>
+    static constexpr bool uses = false;
+
+    template <size_t N>
+    static constexpr auto combine(const std::array<std::uint64_t, N>&) -> std::uint64_t {
+        return 0;
+    }
+};
+
+/// Specialization for UniversalSet
+template <>
+struct FilterPlan<UniversalSet> {
+    static constexpr size_t leaves = 0;
+
+    template <size_t I>
+    static constexpr bool uses = false;
+
+    template <size_t N>
+    static constexpr auto combine(const std::array<std::uint64_t, N>&) -> std::uint64_t {
+        return ~std::uint64_t{0};
+    }
+};
+
+/// Operands of a binary set operation
+template <typename A, typename B>
+struct FilterPlanBinary {
+    static constexpr size_t leaves = std::max(FilterPlan<A>::leaves, FilterPlan<B>::leaves);
+
+    template <size_t I>
+    static constexpr bool uses = FilterPlan<A>::template uses<I> || FilterPlan<B>::template uses<I>;
+};
+
+/// Specialization for Union
+template <typename A, typename B>
+struct FilterPlan<App<App<set::Union, A>, B>> : FilterPlanBinary<A, B> {
+    template <size_t N>
+    static constexpr auto combine(const std::array<std::uint64_t, N>& masks) -> std::uint64_t {
+        return FilterPlan<A>::combine(masks) | FilterPlan<B>::combine(masks);
+    }
+};
+
+/// Specialization for Intersertion
+template <typename A, typename B>
+struct FilterPlan<App<App<set::Intersertion, A>, B>> : FilterPlanBinary<A, B> {
+    template <size_t N>
+    static constexpr auto combine(const std::array<std::uint64_t, N>& masks) -> std::uint64_t {
+        return FilterPlan<A>::combine(masks) & FilterPlan<B>::combine(masks);
+    }
+};
+
+/// Specialization for Difference
+template <typename A, typename B>
+struct FilterPlan<App<App<set::Difference, A>, B>> : FilterPlanBinary<A, B> {
+    template <size_t N>
+    static constexpr auto combine(const std::array<std::uint64_t, N>& masks) -> std::uint64_t {
+        return FilterPlan<A>::combine(masks) & ~FilterPlan<B>::combine(masks);
+    }
+};
+
+/// Specialization for Complement
+template <typename A>
+struct FilterPlan<App<set::Complement, A>> {
+    static constexpr size_t leaves = FilterPlan<A>::leaves;
+
+    template <size_t I>
+    static constexpr bool uses = FilterPlan<A>::template uses<I>;
+
+    template <size_t N>
+    static constexpr auto combine(const std::array<std::uint64_t, N>& masks) -> std::uint64_t {
+        return ~FilterPlan<A>::combine(masks);
+    }
+};
+
+// Filter kernels
+// ----------------
+
+/// Rows per selection word
+inline constexpr size_t filter_block = 64;
+
+/// Words of a selection bitmap over rows
+constexpr auto bitmap_words(size_t rows) -> size_t {
+    return (rows + filter_block - 1) / filter_block;
+}
+
+/// A filter set compiled against its leaf predicates.
+///
+/// Predicate I is called as predicates_I(batch, row) and its result converted
+/// to bool; batch is any record batch, typically a struct of column spans.
+/// Rows are processed in blocks of 64: every leaf the set reads is evaluated
+/// once per row into a mask word, without short-circuiting, then the set
+/// operations combine the words with bitwise and, or and not. There are no
+/// per-row branches and no indirect calls.
+template <typename Set, typename... Predicates>
+class FilterKernel {
+public:
+    static_assert(FilterPlan<Set>::leaves <= sizeof...(Predicates), "every set::Leaf needs a predicate");
+
+    explicit FilterKernel(Predicates... predicates) : predicates_(std::move(predicates)...) {}
+
+    /// Selection bitmap: bit r % 64 of word r / 64 is set when row r is in Set, and bits past rows are clear.
+    /// bitmap needs bitmap_words(rows) words; returns the number of selected rows.
+    template <typename Batch>
+    auto select(const Batch& batch, size_t rows, std::span<std::uint64_t> bitmap) const -> size_t {
+        size_t selected = 0;
+        for (size_t base = 0; base < rows; base += filter_block) {
+            const std::uint64_t word = block(batch, base, std::min(filter_block, rows - base));
+            bitmap[base / filter_block] = word;
+            selected += static_cast<size_t>(std::popcount(word));
+        }
+        return selected;
+    }
+
+    /// Indices of the selected rows in increasing order, written to the front of indices, which needs rows
+    /// entries; returns how many were written
+    template <typename Batch>
+    auto select(const Batch& batch, size_t rows, std::span<std::uint32_t> indices) const -> size_t {
+        size_t selected = 0;
+        for (size_t base = 0; base < rows; base += filter_block) {
+            const size_t count = std::min(filter_block, rows - base);
+            const std::uint64_t word = block(batch, base, count);
+            // Every row is written and the cursor advances by its bit, so the loop does not branch on the data
+            for (size_t k = 0; k < count; ++k) {
+                indices[selected] = static_cast<std::uint32_t>(base + k);
+                selected += static_cast<size_t>((word >> k) & 1);
+            }
+        }
+        return selected;
+    }
+
+private:
+    /// Mask of the rows [base, base + count) in Set
+    template <typename Batch>
+    auto block(const Batch& batch, size_t base, size_t count) const -> std::uint64_t {
+        std::array<std::uint64_t, sizeof...(Predicates)> masks{};
+        fill(batch, base, count, masks, std::index_sequence_for<Predicates...>{});
+        const std::uint64_t valid = count == filter_block ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+        return FilterPlan<Set>::combine(masks) & valid;
+    }
+
+    template <typename Batch, size_t... Is>
+    void fill(const Batch& batch, size_t base, size_t count, std::array<std::uint64_t, sizeof...(Predicates)>& masks,
+              std::index_sequence<Is...>) const {
+        ((masks[Is] = FilterPlan<Set>::template uses<Is> ? leaf<Is>(batch, base, count) : 0), ...);
+    }
+
+    template <size_t I, typename Batch>
+    auto leaf(const Batch& batch, size_t base, size_t count) const -> std::uint64_t {
+        const auto& predicate = std::get<I>(predicates_);
+        std::uint64_t mask = 0;
+        for (size_t k = 0; k < count; ++k) {
+            mask |= std::uint64_t{static_cast<bool>(predicate(batch, base + k))} << k;
+        }
+        return mask;
+    }
+
+    std::tuple<Predicates...> predicates_;
+};
+
+/// Compile Set with predicates bound to set::Leaf<0>, set::Leaf<1>, ...
+template <typename Set, typename... Predicates>
+auto make_filter(Predicates... predicates) -> FilterKernel<Set, Predicates...> {
+    return FilterKernel<Set, Predicates...>(std::move(predicates)...);
+}
+
+} // namespace typical
@@ -0,0 +1,190 @@
+module;
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+
+export module typical.fin;
+
+import typical.eq;
+import typical.nat;
+
+export namespace typical {
+
+// Bounded indices
+// ----------------
+
+template <nat::Nat N>
+class FinRange;
+
+/// An index known to be below the Peano bound N.
+///
+/// A Fin<N> can only come from a proof (of<I>, weaken, transport), a runtime
+/// check, or FinRange iteration, so containers indexed by Fin<N> need no
+/// bounds check. Has the size of a size_t.
+template <nat::Nat N>
+class Fin {
+public:
+    /// The bound as a value
+    static constexpr size_t bound = nat::to_value_v<N>;
+
+    /// Index I, proved in bounds by less_than_v
+    template <nat::Nat I>
+        requires nat::less_than_v<I, N>
+    static constexpr auto of() -> Fin {
+        return Fin(nat::to_value_v<I>);
+    }
+
+    /// Runtime check, empty if i is not below the bound
+    static constexpr auto check(size_t i) -> std::optional<Fin> {
+        if (i >= bound) {
+            return std::nullopt;
+        }
+        return Fin(i);
+    }
+
+    /// The same index under a bound M with N <= M
+    template <nat::Nat M>
+        requires nat::less_or_equal_v<N, M>
+    constexpr auto weaken() const -> Fin<M> {
+        return Fin<M>::unchecked(index_);
+    }
+
+    /// The same index under a bound M given a proof that N and M are equal
+    template <nat::Nat M, typename Proof>
+        requires ProvablyEqual<N, M> && std::is_same_v<Proof, eq_proof<N, M>>
+    constexpr auto transport() const -> Fin<M> {
+        return Fin<M>::unchecked(index_);
+    }
+
+    constexpr auto value() const -> size_t { return index_; }
+    constexpr operator size_t() const { return index_; }
+
+    constexpr auto operator==(const Fin&) const -> bool = default;
+    constexpr auto operator<=>(const Fin&) const = default;
+
+private:
+    template <nat::Nat M>
+    friend class Fin;
+    friend class FinRange<N>;
+
+    explicit constexpr Fin(size_t i) : index_(i) {}
+
+    static constexpr auto unchecked(size_t i) -> Fin { return Fin(i); }
+
+    size_t index_;
+};
+
+/// Constant index I below N
+template <size_t I, nat::Nat N>
+inline constexpr Fin<N> fin_v = Fin<N>::template of<nat::nat_t<I>>();
+
+/// Every Fin<N> in increasing order, produced without checks
+template <nat::Nat N>
+class FinRange {
+public:
+    class iterator {
+    public:
+        using value_type = Fin<N>;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr iterator() = default;
+        explicit constexpr iterator(size_t i) : i_(i) {}
+
+        constexpr auto operator*() const -> Fin<N> { return Fin<N>(i_); }
+        constexpr auto operator++() -> iterator& {
+            ++i_;
+            return *this;
+        }
+        constexpr auto operator++(int) -> iterator {
+            iterator old = *this;
+            ++i_;
+            return old;
+        }
+        constexpr auto operator==(const iterator&) const -> bool = default;
+
+    private:
+        size_t i_ = 0;
+    };
+
+    constexpr auto begin() const -> iterator { return iterator(0); }
+    constexpr auto end() const -> iterator { return iterator(Fin<N>::bound); }
+    static constexpr auto size() -> size_t { return Fin<N>::bound; }
+};
+
+/// Range over all indices below N
+template <nat::Nat N>
+constexpr auto fin_range() -> FinRange<N> {
+    return {};
+}
+
+/// Call f with every Fin<N> in increasing order
+template <nat::Nat N, typename F>
+constexpr void for_each_fin(F&& f) {
+    for (const Fin<N> i : fin_range<N>()) {
+        f(i);
+    }
+}
+
+// Fixed-extent containers
+// ----------------
+
+/// std::array of nat::to_value_v<N> elements indexed by Fin<N>
+template <typename T, nat::Nat N>
+struct FinArray {
+    std::array<T, Fin<N>::bound> elements;
+
+    constexpr auto operator[](Fin<N> i) -> T& { return elements[i.value()]; }
+    constexpr auto operator[](Fin<N> i) const -> const T& { return elements[i.value()]; }
+
+    static constexpr auto size() -> size_t { return Fin<N>::bound; }
+    constexpr auto data() -> T* { return elements.data(); }
+    constexpr auto data() const -> const T* { return elements.data(); }
+    constexpr auto begin() { return elements.begin(); }
+    constexpr auto begin() const { return elements.begin(); }
+    constexpr auto end() { return elements.end(); }
+    constexpr auto end() const { return elements.end(); }
+};
+
+/// View of nat::to_value_v<N> contiguous elements indexed by Fin<N>
+template <typename T, nat::Nat N>
+class FinSpan {
+public:
+    static constexpr size_t extent = Fin<N>::bound;
+
+    /// From a span whose static extent is the bound
+    constexpr FinSpan(std::span<T, extent> elements) : data_(elements.data()) {}
+
+    /// From a FinArray of the same bound
+    template <typename U>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+    constexpr FinSpan(FinArray<U, N>& array) : data_(array.data()) {}
+
+    /// From a const FinArray of the same bound
+    template <typename U>
+        requires std::is_convertible_v<const U (*)[], T (*)[]>
+    constexpr FinSpan(const FinArray<U, N>& array) : data_(array.data()) {}
+
+    /// Runtime check of a dynamic span, empty if it is shorter than the bound
+    static constexpr auto check(std::span<T> elements) -> std::optional<FinSpan> {
+        if (elements.size() < extent) {
+            return std::nullopt;
+        }
+        return FinSpan(elements.template first<extent>());
+    }
+
+    constexpr auto operator[](Fin<N> i) const -> T& { return data_[i.value()]; }
+
+    static constexpr auto size() -> size_t { return extent; }
+    constexpr auto data() const -> T* { return data_; }
+    constexpr auto begin() const -> T* { return data_; }
+    constexpr auto end() const -> T* { return data_ + extent; }
+
+private:
+    T* data_;
+};
+
+} // namespace typical
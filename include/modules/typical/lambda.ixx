@@ -26,6 +26,55 @@ struct App {
     using arg = Arg;
 };
 
+/// One more than the largest free index of a term, 0 for closed terms
+template <typename Term>
+struct FreeBound;
+
+/// Specialization for Var
+template <size_t Index>
+struct FreeBound<Var<Index>> {
+    static constexpr size_t value = Index + 1;
+};
+
+/// Specialization for Abs
+template <typename Body>
+struct FreeBound<Abs<Body>> {
+    static constexpr size_t value = FreeBound<Body>::value > 0 ? FreeBound<Body>::value - 1 : 0;
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct FreeBound<App<Func, Arg>> {
+    static constexpr size_t value =
+        FreeBound<Func>::value > FreeBound<Arg>::value ? FreeBound<Func>::value : FreeBound<Arg>::value;
+};
+
+/// Helper variable for FreeBound
+template <typename Term>
+inline constexpr size_t free_bound_v = FreeBound<Term>::value;
+
+/// Whether a term has no free variables
+template <typename Term>
+inline constexpr bool is_closed_v = free_bound_v<Term> == 0;
+
+/// Named combinator: a closed term Def kept opaque under Tag
+///
+/// Shift and Subst leave it untouched, and it is replaced by Def only when it
+/// reaches the head of a redex, so substitution copies one node instead of Def.
+/// That is only sound for a closed Def, so an open one is rejected when named.
+template <typename Tag, typename Def>
+    requires is_closed_v<Def>
+struct Named {
+    using tag = Tag;
+    using definition = Def;
+};
+
+/// Specialization for Named (closed by construction)
+template <typename Tag, typename Def>
+struct FreeBound<Named<Tag, Def>> {
+    static constexpr size_t value = 0;
+};
+
 /// Type traits to identify term types
 template <typename T>
 struct is_var : std::false_type {};
@@ -50,9 +99,49 @@ struct is_app : std::false_type {};
 template <typename Func, typename Arg>
 struct is_app<App<Func, Arg>> : std::true_type {};
 
+/// Specialization for Named
+template <typename T>
+struct is_named : std::false_type {};
+
+/// Specialization for Named
+template <typename Tag, typename Def>
+struct is_named<Named<Tag, Def>> : std::true_type {};
+
 /// Concept to identify lambda terms
 template <typename T>
-concept LambdaTerm = is_var<T>::value || is_abs<T>::value || is_app<T>::value;
+concept LambdaTerm = is_var<T>::value || is_abs<T>::value || is_app<T>::value || is_named<T>::value;
+
+/// Number of nodes in a term; a Named node counts as one
+template <typename Term>
+struct TermSize;
+
+/// Specialization for Var
+template <size_t Index>
+struct TermSize<Var<Index>> {
+    static constexpr size_t value = 1;
+};
+
+/// Specialization for Abs
+template <typename Body>
+struct TermSize<Abs<Body>> {
+    static constexpr size_t value = TermSize<Body>::value + 1;
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct TermSize<App<Func, Arg>> {
+    static constexpr size_t value = TermSize<Func>::value + TermSize<Arg>::value + 1;
+};
+
+/// Specialization for Named
+template <typename Tag, typename Def>
+struct TermSize<Named<Tag, Def>> {
+    static constexpr size_t value = 1;
+};
+
+/// Helper variable for TermSize
+template <typename Term>
+inline constexpr size_t term_size_v = TermSize<Term>::value;
 
 /// Shift Up (for positive shifts)
 template <typename Term, size_t Amount, size_t Cutoff = 0>
@@ -76,6 +165,12 @@ struct Shift<App<Func, Arg>, Amount, Cutoff> {
     using Result = App<typename Shift<Func, Amount, Cutoff>::Result, typename Shift<Arg, Amount, Cutoff>::Result>;
 };
 
+/// Specialization for Named (closed, so unaffected)
+template <typename Tag, typename Def, size_t Amount, size_t Cutoff>
+struct Shift<Named<Tag, Def>, Amount, Cutoff> {
+    using Result = Named<Tag, Def>;
+};
+
 /// Alias for Shift
 template <typename Term, size_t Amount, size_t Cutoff = 0>
 using shift_t = Shift<Term, Amount, Cutoff>::Result;
@@ -103,6 +198,12 @@ struct ShiftDown<App<Func, Arg>, Amount, Cutoff> {
         App<typename ShiftDown<Func, Amount, Cutoff>::Result, typename ShiftDown<Arg, Amount, Cutoff>::Result>;
 };
 
+/// Specialization for Named (closed, so unaffected)
+template <typename Tag, typename Def, size_t Amount, size_t Cutoff>
+struct ShiftDown<Named<Tag, Def>, Amount, Cutoff> {
+    using Result = Named<Tag, Def>;
+};
+
 /// Alias for ShiftDown
 template <typename Term, size_t Amount, size_t Cutoff = 0>
 using shift_down_t = typename ShiftDown<Term, Amount, Cutoff>::Result;
@@ -130,6 +231,12 @@ struct Subst<App<Func, Arg>, Index, Replacement> {
         App<typename Subst<Func, Index, Replacement>::Result, typename Subst<Arg, Index, Replacement>::Result>;
 };
 
+/// Specialization for Named (closed, so unaffected)
+template <typename Tag, typename Def, size_t Index, typename Replacement>
+struct Subst<Named<Tag, Def>, Index, Replacement> {
+    using Result = Named<Tag, Def>;
+};
+
 /// Alias for Subst
 template <typename Term, size_t Index, typename Replacement>
 using subst_t = typename Subst<Term, Index, Replacement>::Result;
@@ -144,6 +251,26 @@ struct is_value : std::false_type {};
 template <typename Body>
 struct is_value<Abs<Body>> : std::true_type {};
 
+/// Specialization for Named
+template <typename Tag, typename Def>
+struct is_value<Named<Tag, Def>> : is_value<Def> {};
+
+/// Delta expansion: the definition of a Named head, any other term unchanged
+template <typename Term>
+struct Unfold {
+    using Result = Term;
+};
+
+/// Specialization for Named
+template <typename Tag, typename Def>
+struct Unfold<Named<Tag, Def>> {
+    using Result = Def;
+};
+
+/// Alias for Unfold
+template <typename Term>
+using unfold_t = typename Unfold<Term>::Result;
+
 /// Reduce (one step)
 template <typename Term>
 struct Reduce;
@@ -162,12 +289,19 @@ struct Reduce<Abs<Body>> {
     static constexpr bool reduced = false;
 };
 
+/// Specialization for Named (only unfolded at the head of a redex)
+template <typename Tag, typename Def>
+struct Reduce<Named<Tag, Def>> {
+    using Result = Named<Tag, Def>;
+    static constexpr bool reduced = false;
+};
+
 /// Specialization for App
 template <typename Func, typename Arg>
 struct Reduce<App<Func, Arg>> {
 private:
-    using ReducedFunc = typename Reduce<Func>::Result;
-    static constexpr bool func_reduced = Reduce<Func>::reduced;
+    using ReducedFunc = unfold_t<typename Reduce<Func>::Result>;
+    static constexpr bool func_reduced = Reduce<Func>::reduced || is_named<typename Reduce<Func>::Result>::value;
 
     static constexpr bool is_beta_redex = is_abs<ReducedFunc>::value;
 
@@ -197,28 +331,160 @@ public:
 template <typename Term>
 using reduce_t = typename Reduce<Term>::Result;
 
+/// Marker for a term whose evaluation was cut short because a step led back to a recent term
+template <typename Term>
+struct Diverged {
+    using term = Term;
+};
+
+/// Type trait to identify diverged results
+template <typename T>
+struct is_diverged : std::false_type {};
+
+/// Specialization for Diverged
+template <typename Term>
+struct is_diverged<Diverged<Term>> : std::true_type {};
+
+/// The last terms visited by Eval, newest first; unused slots are void
+template <typename T0, typename T1, typename T2, typename T3>
+struct EvalHistory {
+    template <typename T>
+    static constexpr bool contains =
+        std::is_same_v<T, T0> || std::is_same_v<T, T1> || std::is_same_v<T, T2> || std::is_same_v<T, T3>;
+
+    template <typename T>
+    using push = EvalHistory<T, T0, T1, T2>;
+};
+
+/// How EvalLoop proceeds from a term
+enum class EvalStatus { Done, Cycle, Continue };
+
+/// Status of Term: Done when it does not reduce or no steps remain, Cycle when its reduct is in History
+template <typename Term, size_t MaxSteps, typename History>
+constexpr auto eval_status() -> EvalStatus {
+    if constexpr (MaxSteps == 0 || !Reduce<Term>::reduced) {
+        return EvalStatus::Done;
+    }
+    else if constexpr (History::template contains<reduce_t<Term>>) {
+        return EvalStatus::Cycle;
+    }
+    else {
+        return EvalStatus::Continue;
+    }
+}
+
+/// Evaluation loop with cycle detection
+template <typename Term, size_t MaxSteps, typename History,
+          EvalStatus Status = eval_status<Term, MaxSteps, History>()>
+struct EvalLoop {
+    using Result = Term;
+    static constexpr bool diverged = Status == EvalStatus::Cycle;
+    static constexpr size_t steps = 0;
+};
+
+/// Specialization for a term that reduces to a new term
+template <typename Term, size_t MaxSteps, typename History>
+struct EvalLoop<Term, MaxSteps, History, EvalStatus::Continue> {
+private:
+    using Step = reduce_t<Term>;
+    using Next = EvalLoop<Step, MaxSteps - 1, typename History::template push<Step>>;
+
+public:
+    using Result = typename Next::Result;
+    static constexpr bool diverged = Next::diverged;
+    static constexpr size_t steps = Next::steps + 1;
+};
+
 /// Evaluation (full reduction)
+///
+/// Stops after MaxSteps steps, at a term that no longer reduces, or as soon
+/// as a step returns one of the last four terms (Omega reduces to itself);
+/// the last case sets diverged and Result is the term before the repeat.
 template <typename Term, size_t MaxSteps = 1000>
 struct Eval {
-protected:
-    using Step = reduce_t<Term>;
-    static constexpr bool made_progress = Reduce<Term>::reduced;
+private:
+    using Loop = EvalLoop<Term, MaxSteps, EvalHistory<Term, void, void, void>>;
 
 public:
     /// Result after evaluation
-    using Result = std::conditional_t<made_progress && (MaxSteps > 0), typename Eval<Step, MaxSteps - 1>::Result, Term>;
+    using Result = typename Loop::Result;
+    /// Indicates if evaluation stopped on a cycle
+    static constexpr bool diverged = Loop::diverged;
+    /// Reduction steps performed
+    static constexpr size_t steps = Loop::steps;
 };
 
-/// Base case: prevent unsigned wraparound when MaxSteps == 0
+/// Alias for Eval
+template <typename Term, size_t MaxSteps = 1000>
+using eval_t = typename Eval<Term, MaxSteps>::Result;
+
+/// Alias for Eval, wrapping the result in Diverged when a cycle was found
+template <typename Term, size_t MaxSteps = 1000>
+using eval_checked_t =
+    std::conditional_t<Eval<Term, MaxSteps>::diverged, Diverged<eval_t<Term, MaxSteps>>, eval_t<Term, MaxSteps>>;
+
+/// Helper variable for Eval::diverged
+template <typename Term, size_t MaxSteps = 1000>
+inline constexpr bool diverges_v = Eval<Term, MaxSteps>::diverged;
+
+/// Normalization (reduction under binders)
+///
+/// Eval stops at weak head normal form; Normalize evaluates the head and then
+/// normalizes every remaining subterm, so convertible terms become identical types.
+/// A subterm whose evaluation diverged is left as Eval returned it.
 template <typename Term>
-struct Eval<Term, 0> {
-    /// Result after evaluation
+struct Normalize;
+
+/// Alias for Normalize
+template <typename Term>
+using normalize_t = typename Normalize<Term>::Result;
+
+/// Normalize the subterms of a term already in weak head normal form
+template <typename Term>
+struct NormalizeHead;
+
+/// Specialization for Var
+template <size_t Index>
+struct NormalizeHead<Var<Index>> {
+    using Result = Var<Index>;
+    static constexpr size_t steps = 0;
+};
+
+/// Specialization for Abs
+template <typename Body>
+struct NormalizeHead<Abs<Body>> {
+    using Result = Abs<normalize_t<Body>>;
+    static constexpr size_t steps = Normalize<Body>::steps;
+};
+
+/// Specialization for App (a neutral application)
+template <typename Func, typename Arg>
+struct NormalizeHead<App<Func, Arg>> {
+    using Result = App<normalize_t<Func>, normalize_t<Arg>>;
+    static constexpr size_t steps = Normalize<Func>::steps + Normalize<Arg>::steps;
+};
+
+/// Specialization for Named (read back as its definition)
+template <typename Tag, typename Def>
+struct NormalizeHead<Named<Tag, Def>> {
+    using Result = normalize_t<Def>;
+    static constexpr size_t steps = Normalize<Def>::steps;
+};
+
+/// Specialization for Diverged (left as evaluated)
+template <typename Term>
+struct NormalizeHead<Diverged<Term>> {
     using Result = Term;
+    static constexpr size_t steps = 0;
 };
 
-/// Alias for Eval
-template <typename Term, size_t MaxSteps = 1000>
-using eval_t = typename Eval<Term, MaxSteps>::Result;
+template <typename Term>
+struct Normalize {
+    /// Result after normalization
+    using Result = typename NormalizeHead<eval_checked_t<Term>>::Result;
+    /// Reduction steps performed, over every subterm
+    static constexpr size_t steps = Eval<Term>::steps + NormalizeHead<eval_checked_t<Term>>::steps;
+};
 
 
 // Church Encodings
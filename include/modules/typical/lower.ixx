@@ -0,0 +1,277 @@
+module;
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+
+export module typical.lower;
+
+import typical.lambda;
+import typical.church;
+
+export namespace typical {
+
+// Shapes
+// ----------------
+//
+// Church encodings overlap in normal form (Nothing is True, Just v is Right v),
+// so lowering is directed by a shape naming the encoding to expect.
+
+/// Church numeral, lowered to size_t
+struct Numeral {};
+
+/// Church boolean, lowered to bool
+struct Boolean {};
+
+/// Church pair, lowered to std::pair
+template <typename A, typename B>
+struct PairOf {};
+
+/// Church Maybe, lowered to std::optional
+template <typename A>
+struct MaybeOf {};
+
+/// Church Either, lowered to std::variant (index 0 for Left)
+template <typename A, typename B>
+struct EitherOf {};
+
+/// Runtime type of a shape
+template <typename Shape>
+struct Lowered;
+
+/// Specialization for Numeral
+template <>
+struct Lowered<Numeral> {
+    using type = size_t;
+};
+
+/// Specialization for Boolean
+template <>
+struct Lowered<Boolean> {
+    using type = bool;
+};
+
+/// Specialization for PairOf
+template <typename A, typename B>
+struct Lowered<PairOf<A, B>> {
+    using type = std::pair<typename Lowered<A>::type, typename Lowered<B>::type>;
+};
+
+/// Specialization for MaybeOf
+template <typename A>
+struct Lowered<MaybeOf<A>> {
+    using type = std::optional<typename Lowered<A>::type>;
+};
+
+/// Specialization for EitherOf
+template <typename A, typename B>
+struct Lowered<EitherOf<A, B>> {
+    using type = std::variant<typename Lowered<A>::type, typename Lowered<B>::type>;
+};
+
+/// Alias for Lowered
+template <typename Shape>
+using lowered_t = typename Lowered<Shape>::type;
+
+// Lowering (term to value)
+// ----------------
+
+/// Count of f applications in the body of a numeral; matches is false for other bodies
+template <typename Body>
+struct NumeralBody {
+    static constexpr bool matches = false;
+    static constexpr size_t value = 0;
+};
+
+/// Base case: x
+template <>
+struct NumeralBody<Var<0>> {
+    static constexpr bool matches = true;
+    static constexpr size_t value = 0;
+};
+
+/// Recursive case: f (...)
+template <typename Rest>
+struct NumeralBody<App<Var<1>, Rest>> {
+    static constexpr bool matches = NumeralBody<Rest>::matches;
+    static constexpr size_t value = NumeralBody<Rest>::value + 1;
+};
+
+/// Recognize a normal form of the given shape; value is only meaningful when matches is true
+template <typename Shape, typename Term>
+struct LowerTerm {
+    static constexpr bool matches = false;
+    static constexpr lowered_t<Shape> value{};
+};
+
+/// Numeral: λf.λx.f^n x
+template <typename Body>
+struct LowerTerm<Numeral, Abs<Abs<Body>>> {
+    static constexpr bool matches = NumeralBody<Body>::matches;
+    static constexpr size_t value = NumeralBody<Body>::value;
+};
+
+/// Boolean: True selects its first argument, False its second
+template <size_t Index>
+struct LowerTerm<Boolean, Abs<Abs<Var<Index>>>> {
+    static constexpr bool matches = Index <= 1;
+    static constexpr bool value = Index == 1;
+};
+
+/// Pair: λf.f a b
+template <typename A, typename B, typename First, typename Second>
+struct LowerTerm<PairOf<A, B>, Abs<App<App<Var<0>, First>, Second>>> {
+private:
+    using LowerFirst = LowerTerm<A, shift_down_t<First, 1>>;
+    using LowerSecond = LowerTerm<B, shift_down_t<Second, 1>>;
+
+public:
+    static constexpr bool matches = LowerFirst::matches && LowerSecond::matches;
+    static constexpr lowered_t<PairOf<A, B>> value{LowerFirst::value, LowerSecond::value};
+};
+
+/// Nothing: λn.λj.n
+template <typename A>
+struct LowerTerm<MaybeOf<A>, Abs<Abs<Var<1>>>> {
+    static constexpr bool matches = true;
+    static constexpr lowered_t<MaybeOf<A>> value{};
+};
+
+/// Just: λn.λj.j v
+template <typename A, typename Payload>
+struct LowerTerm<MaybeOf<A>, Abs<Abs<App<Var<0>, Payload>>>> {
+private:
+    using LowerPayload = LowerTerm<A, shift_down_t<Payload, 2>>;
+
+public:
+    static constexpr bool matches = LowerPayload::matches;
+    static constexpr lowered_t<MaybeOf<A>> value{LowerPayload::value};
+};
+
+/// Left: λl.λr.l v, Right: λl.λr.r v
+template <typename A, typename B, size_t Index, typename Payload>
+struct LowerTerm<EitherOf<A, B>, Abs<Abs<App<Var<Index>, Payload>>>> {
+private:
+    using LowerLeft = LowerTerm<A, shift_down_t<Payload, 2>>;
+    using LowerRight = LowerTerm<B, shift_down_t<Payload, 2>>;
+
+    static constexpr auto make() -> lowered_t<EitherOf<A, B>> {
+        if constexpr (Index == 1) {
+            return lowered_t<EitherOf<A, B>>(std::in_place_index<0>, LowerLeft::value);
+        }
+        else {
+            return lowered_t<EitherOf<A, B>>(std::in_place_index<1>, LowerRight::value);
+        }
+    }
+
+public:
+    static constexpr bool matches = Index == 1 ? LowerLeft::matches : Index == 0 && LowerRight::matches;
+    static constexpr lowered_t<EitherOf<A, B>> value = make();
+};
+
+/// Normalize Term and recognize it as Shape
+template <typename Shape, typename Term>
+struct Lower {
+    /// Indicates if the normal form has the expected encoding
+    static constexpr bool matches = LowerTerm<Shape, normalize_t<Term>>::matches;
+
+    static_assert(matches, "term does not normalize to the encoding of the requested shape");
+
+    /// The runtime value, a constant
+    static constexpr lowered_t<Shape> value = LowerTerm<Shape, normalize_t<Term>>::value;
+};
+
+/// Helper variable for Lower
+template <typename Shape, typename Term>
+inline constexpr lowered_t<Shape> lowered_v = Lower<Shape, Term>::value;
+
+/// Helper variable for Lower::matches, without the static_assert
+template <typename Shape, typename Term>
+inline constexpr bool lowers_v = LowerTerm<Shape, normalize_t<Term>>::matches;
+
+// Raising (value to term)
+// ----------------
+
+/// Canonical normal form of the constant Source() of shape Shape.
+/// Source is a constexpr callable (a captureless lambda or function pointer) returning lowered_t<Shape>.
+template <typename Shape, auto Source>
+struct Raise;
+
+/// Component getters, so nested shapes can be raised from their own constant
+template <auto Source>
+struct RaiseParts {
+    static constexpr auto first() { return Source().first; }
+    static constexpr auto second() { return Source().second; }
+    static constexpr auto payload() { return *Source(); }
+    template <size_t I>
+    static constexpr auto alternative() {
+        return std::get<I>(Source());
+    }
+};
+
+/// Specialization for Numeral
+template <auto Source>
+struct Raise<Numeral, Source> {
+    using Result = church_numeral_t<Source()>;
+};
+
+/// Specialization for Boolean
+template <auto Source>
+struct Raise<Boolean, Source> {
+    using Result = std::conditional_t<Source(), True, False>;
+};
+
+/// Specialization for PairOf
+template <typename A, typename B, auto Source>
+struct Raise<PairOf<A, B>, Source> {
+    using Result = Abs<App<App<Var<0>, shift_t<typename Raise<A, &RaiseParts<Source>::first>::Result, 1>>,
+                           shift_t<typename Raise<B, &RaiseParts<Source>::second>::Result, 1>>>;
+};
+
+/// Specialization for MaybeOf
+template <typename A, auto Source>
+struct Raise<MaybeOf<A>, Source> {
+private:
+    template <bool HasValue, typename = void>
+    struct Select {
+        using Result = Nothing;
+    };
+
+    template <typename Unused>
+    struct Select<true, Unused> {
+        using Result = Abs<Abs<App<Var<0>, shift_t<typename Raise<A, &RaiseParts<Source>::payload>::Result, 2>>>>;
+    };
+
+public:
+    using Result = typename Select<Source().has_value()>::Result;
+};
+
+/// Specialization for EitherOf
+template <typename A, typename B, auto Source>
+struct Raise<EitherOf<A, B>, Source> {
+private:
+    template <size_t Index, typename = void>
+    struct Select {
+        using Result =
+            Abs<Abs<App<Var<1>,
+                        shift_t<typename Raise<A, &RaiseParts<Source>::template alternative<0>>::Result, 2>>>>;
+    };
+
+    template <typename Unused>
+    struct Select<1, Unused> {
+        using Result =
+            Abs<Abs<App<Var<0>,
+                        shift_t<typename Raise<B, &RaiseParts<Source>::template alternative<1>>::Result, 2>>>>;
+    };
+
+public:
+    using Result = typename Select<Source().index()>::Result;
+};
+
+/// Alias for Raise
+template <typename Shape, auto Source>
+using raise_t = typename Raise<Shape, Source>::Result;
+
+} // namespace typical
@@ -0,0 +1,113 @@
+module;
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+export module typical.mapped;
+
+export namespace typical {
+
+// Memory-mapped files
+// ----------------
+
+/// Read-only or read-write memory mapping of a whole file (POSIX)
+class MappedFile {
+public:
+    /// Map an existing file read-only
+    static auto open_read(const std::filesystem::path& path) -> MappedFile {
+        MappedFile file;
+        file.fd_ = ::open(path.c_str(), O_RDONLY);
+        if (file.fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path.string());
+        }
+        struct stat info {};
+        if (::fstat(file.fd_, &info) != 0) {
+            throw std::system_error(errno, std::generic_category(), "fstat " + path.string());
+        }
+        file.map(static_cast<std::size_t>(info.st_size), PROT_READ);
+        return file;
+    }
+
+    /// Create (or truncate) a file of the given size and map it read-write
+    static auto create(const std::filesystem::path& path, std::size_t size) -> MappedFile {
+        MappedFile file;
+        file.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file.fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path.string());
+        }
+        if (::ftruncate(file.fd_, static_cast<off_t>(size)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate " + path.string());
+        }
+        file.map(size, PROT_READ | PROT_WRITE);
+        return file;
+    }
+
+    MappedFile() = default;
+
+    MappedFile(MappedFile&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)), data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd_ = std::exchange(other.fd_, -1);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { release(); }
+
+    auto data() const -> std::byte* { return static_cast<std::byte*>(data_); }
+    auto size() const -> std::size_t { return size_; }
+
+    /// Advise the kernel that the mapping will be read front to back
+    void advise_sequential() const {
+        if (data_ != nullptr) {
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+    }
+
+private:
+    void map(std::size_t size, int protection) {
+        size_ = size;
+        if (size == 0) {
+            return;
+        }
+        data_ = ::mmap(nullptr, size, protection, MAP_SHARED, fd_, 0);
+        if (data_ == MAP_FAILED) {
+            data_ = nullptr;
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+    }
+
+    void release() {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+            data_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace typical
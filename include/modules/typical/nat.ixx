@@ -1,6 +1,9 @@
 module;
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 
 export module typical.nat;
 
@@ -15,6 +18,10 @@ struct Z {};
 template <typename N>
 struct S {};
 
+/// Eight successors, used to walk a number eight levels per instantiation
+template <typename N>
+using S8 = S<S<S<S<S<S<S<S<N>>>>>>>>;
+
 // Convenient aliases for small natural numbers
 
 using Zero = Z;
@@ -43,6 +50,10 @@ struct is_nat<Z> : std::true_type {};
 template <typename N>
 struct is_nat<S<N>> : is_nat<N> {};
 
+/// Specialization for S8<N>
+template <typename N>
+struct is_nat<S8<N>> : is_nat<N> {};
+
 /// Concept to identify Peano natural numbers
 template <typename T>
 concept Nat = is_nat<T>::value;
@@ -78,26 +89,58 @@ struct ToValue<S<N>> {
     static constexpr size_t value = 1 + ToValue<N>::value;
 };
 
+/// Recursive case for S8<N>
+template <Nat N>
+struct ToValue<S8<N>> {
+    static constexpr size_t value = 8 + ToValue<N>::value;
+};
+
 /// Alias for ToValue
 template <Nat N>
 inline constexpr size_t to_value_v = ToValue<N>::value;
 
-/// Convert size_t to Peano number
-template <size_t N>
-struct FromValue {
-    using type = S<typename FromValue<N - 1>::type>;
+/// K successors of N
+template <size_t K, typename N>
+struct AddSuccessors {
+    using type = S<typename AddSuccessors<K - 1, N>::type>;
+};
+
+/// Base case: N itself
+template <typename N>
+struct AddSuccessors<0, N> {
+    using type = N;
+};
+
+/// Peano number 64 * M, built a block of 64 successors at a time
+template <size_t M>
+struct FromValueBlock {
+    using type = typename AddSuccessors<64, typename FromValueBlock<M - 1>::type>::type;
 };
 
 /// Specialization for 0
 template <>
-struct FromValue<0> {
+struct FromValueBlock<0> {
     using type = Z;
 };
 
+/// Convert size_t to Peano number.
+/// Instantiation depth is about N / 64 + 64, so nat_t<1024> builds under the default limit.
+template <size_t N>
+struct FromValue {
+    using type = typename AddSuccessors<N % 64, typename FromValueBlock<N / 64>::type>::type;
+};
+
 /// Alias for FromValue
 template <size_t N>
 using from_value_t = typename FromValue<N>::type;
 
+/// Entries 0..nat_table_size of nat_t build under the default template depth
+inline constexpr size_t nat_table_size = 1024;
+
+/// Peano number N, looked up in the FromValue table
+template <size_t N>
+using nat_t = from_value_t<N>;
+
 // Addition
 // ----------------
 
@@ -117,6 +160,12 @@ struct Add<S<M>, N> {
     using Result = S<typename Add<M, N>::Result>;
 };
 
+/// Recursive case for S8<M>
+template <Nat M, Nat N>
+struct Add<S8<M>, N> {
+    using Result = S8<typename Add<M, N>::Result>;
+};
+
 /// Alias for Add
 template <Nat M, Nat N>
 using add_t = typename Add<M, N>::Result;
@@ -263,6 +312,12 @@ struct Sub<S<M>, S<N>> {
     using Result = typename Sub<M, N>::Result;
 };
 
+/// Recursive case for S8<M> and S8<N>
+template <Nat M, Nat N>
+struct Sub<S8<M>, S8<N>> {
+    using Result = typename Sub<M, N>::Result;
+};
+
 /// Alias for Sub
 template <Nat M, Nat N>
 using sub_t = typename Sub<M, N>::Result;
@@ -302,6 +357,13 @@ struct LessThan<S<M>, S<N>> {
     using Proof = typename LessThan<M, N>::Proof;
 };
 
+/// Recursive case for S8<M> and S8<N>
+template <Nat M, Nat N>
+struct LessThan<S8<M>, S8<N>> {
+    static constexpr bool value = LessThan<M, N>::value;
+    using Proof = typename LessThan<M, N>::Proof;
+};
+
 /// Alias for LessThan
 template <Nat M, Nat N>
 inline constexpr bool less_than_v = LessThan<M, N>::value;
@@ -350,68 +412,48 @@ using max_t = typename Max<M, N>::Result;
 
 // Division and Modulus
 // ----------------
-
-/// Division
-template <Nat M, Nat N>
-struct Div;
-
-/// Division by zero yields zero
-template <Nat M>
-struct Div<M, Z> {
-    using Result = Z;
-};
-
-/// Zero divided by any non-zero number is zero
-template <Nat N>
-struct Div<Z, S<N>> {
-    using Result = Z;
-};
-
-/// Recursive case
+//
+// Peano numbers are unary, so Div, Mod and GCD convert to size_t once, run the
+// binary algorithms below and convert the result back through from_value_t.
+
+/// Quotient and remainder
+struct DivMod {
+    size_t quotient = 0;
+    size_t remainder = 0;
+};
+
+/// Shift-and-subtract long division, one step per bit of the dividend; division by zero yields {0, 0}
+constexpr auto long_divide(size_t dividend, size_t divisor) -> DivMod {
+    DivMod result;
+    if (divisor == 0) {
+        return result;
+    }
+    for (int bit = std::bit_width(dividend) - 1; bit >= 0; --bit) {
+        result.remainder = (result.remainder << 1) | ((dividend >> bit) & 1);
+        if (result.remainder >= divisor) {
+            result.remainder -= divisor;
+            result.quotient |= size_t{1} << bit;
+        }
+    }
+    return result;
+}
+
+/// Division (division by zero yields zero)
 template <Nat M, Nat N>
-    requires(!is_zero_v<N> && !is_zero_v<M>)
-struct Div<M, N> {
-protected:
-    using Difference = sub_t<M, N>;
-    static constexpr bool m_ge_n = less_or_equal_v<N, M>;
-
-public:
+struct Div {
     /// Result
-    using Result = std::conditional_t<m_ge_n, S<typename Div<Difference, N>::Result>, Z>;
+    using Result = from_value_t<long_divide(to_value_v<M>, to_value_v<N>).quotient>;
 };
 
 /// Alias for Div
 template <Nat M, Nat N>
 using div_t = typename Div<M, N>::Result;
 
-/// Modulus
+/// Modulus (modulus by zero yields zero)
 template <Nat M, Nat N>
-struct Mod;
-
-/// Modulus by zero yields zero
-template <Nat M>
-struct Mod<M, Z> {
-    using Result = Z;
-};
-
-/// Zero modulus any non-zero number is zero
-template <Nat N>
-struct Mod<Z, S<N>> {
+struct Mod {
     /// Result
-    using Result = Z;
-};
-
-/// Recursive case
-template <Nat M, Nat N>
-    requires(!is_zero_v<N> && !is_zero_v<M>)
-struct Mod<M, N> {
-protected:
-    static constexpr bool m_lt_n = less_than_v<M, N>;
-    using Difference = sub_t<M, N>;
-
-public:
-    /// Result
-    using Result = std::conditional_t<m_lt_n, M, typename Mod<Difference, N>::Result>;
+    using Result = from_value_t<long_divide(to_value_v<M>, to_value_v<N>).remainder>;
 };
 
 /// Alias for Mod
@@ -461,22 +503,28 @@ struct Factorial<S<N>> {
 template <Nat N>
 using factorial_t = typename Factorial<N>::Result;
 
-/// GCD (Greatest Common Divisor)
-template <Nat M, Nat N>
-struct GCD;
+/// Stein's binary GCD: strips common factors of two, then subtracts odd values
+constexpr auto binary_gcd(size_t m, size_t n) -> size_t {
+    if (m == 0 || n == 0) {
+        return m | n;
+    }
+    const int shift = std::countr_zero(m | n);
+    m >>= std::countr_zero(m);
+    do {
+        n >>= std::countr_zero(n);
+        if (m > n) {
+            std::swap(m, n);
+        }
+        n -= m;
+    } while (n != 0);
+    return m << shift;
+}
 
-/// Base case
-template <Nat M>
-struct GCD<M, Z> {
-    using Result = M;
-};
-
-/// Recursive case
+/// GCD (Greatest Common Divisor)
 template <Nat M, Nat N>
-    requires(!is_zero_v<N>)
-struct GCD<M, N> {
+struct GCD {
     /// Result
-    using Result = typename GCD<N, mod_t<M, N>>::Result;
+    using Result = from_value_t<binary_gcd(to_value_v<M>, to_value_v<N>)>;
 };
 
 /// Alias for GCD
@@ -542,5 +590,184 @@ inline constexpr bool is_even_v = IsEven<N>::value;
 template <Nat N>
 inline constexpr bool is_odd_v = !is_even_v<N>;
 
+// Runtime dispatch
+// ----------------
+//
+// A dispatch table runs a type-level algorithm at compile time for every
+// argument below a bound and stores the results as size_t. At runtime,
+// lookup(n) costs a bounds check and a load. Arguments past the table go to a
+// constexpr runtime implementation of the same function. Where the exact
+// result does not fit, that implementation wraps modulo 2^64 like any size_t
+// arithmetic.
+//
+// Instantiating the type-level algorithm costs time and memory in proportion
+// to its unary results, so a table has a second, smaller bound. Entries below
+// it come from the type-level algorithm. The remaining entries run the
+// runtime implementation in constant evaluation.
+
+/// factorial_t for dispatch tables
+struct FactorialFn {
+    static constexpr size_t arity = 1;
+    /// 20! is the largest factorial below 2^64
+    static constexpr size_t table_size = 21;
+    /// 7! = 5040 successors
+    static constexpr size_t typed_size = 8;
+
+    template <Nat N>
+    using typed = factorial_t<N>;
+
+    static constexpr auto value(size_t n) -> size_t {
+        // From 66! on there are at least 64 factors of two
+        if (n >= 66) {
+            return 0;
+        }
+        size_t result = 1;
+        for (size_t k = 2; k <= n; ++k) {
+            result *= k;
+        }
+        return result;
+    }
+};
+
+/// fibonacci_t for dispatch tables
+struct FibonacciFn {
+    static constexpr size_t arity = 1;
+    /// F(93) is the largest Fibonacci number below 2^64
+    static constexpr size_t table_size = 94;
+    /// F(15) = 610 successors
+    static constexpr size_t typed_size = 16;
+
+    template <Nat N>
+    using typed = fibonacci_t<N>;
+
+    /// Fast doubling: F(2k) = F(k) (2 F(k+1) - F(k)), F(2k+1) = F(k)^2 + F(k+1)^2
+    static constexpr auto value(size_t n) -> size_t {
+        size_t a = 0;
+        size_t b = 1;
+        for (int bit = std::bit_width(n) - 1; bit >= 0; --bit) {
+            const size_t even = a * (2 * b - a);
+            const size_t odd = a * a + b * b;
+            a = ((n >> bit) & 1) != 0 ? odd : even;
+            b = ((n >> bit) & 1) != 0 ? even + odd : odd;
+        }
+        return a;
+    }
+};
+
+/// pow_t for dispatch tables, indexed by base then exponent
+struct PowFn {
+    static constexpr size_t arity = 2;
+    static constexpr size_t table_size = 16;
+    /// 5^5 = 3125 successors
+    static constexpr size_t typed_size = 6;
+
+    template <Nat Base, Nat Exp>
+    using typed = pow_t<Base, Exp>;
+
+    /// Square-and-multiply; 0^0 = 1 as in pow_t
+    static constexpr auto value(size_t base, size_t exp) -> size_t {
+        size_t result = 1;
+        for (; exp != 0; exp >>= 1) {
+            if ((exp & 1) != 0) {
+                result *= base;
+            }
+            base *= base;
+        }
+        return result;
+    }
+};
+
+/// gcd_t for dispatch tables
+struct GcdFn {
+    static constexpr size_t arity = 2;
+    static constexpr size_t table_size = 64;
+    static constexpr size_t typed_size = 16;
+
+    template <Nat M, Nat N>
+    using typed = gcd_t<M, N>;
+
+    static constexpr auto value(size_t m, size_t n) -> size_t { return binary_gcd(m, n); }
+};
+
+/// Results of Fn for every argument below Size, or every pair of arguments below Size, in row-major order.
+///
+/// Entries whose arguments are all below TypedSize instantiate Fn::typed;
+/// the others are Fn::value run in constant evaluation.
+template <typename Fn, size_t Size = Fn::table_size, size_t TypedSize = (Fn::typed_size < Size ? Fn::typed_size : Size)>
+struct DispatchTable {
+    static_assert(Fn::arity == 1 || Fn::arity == 2, "Dispatch tables take one or two arguments.");
+    static_assert(TypedSize <= Size, "The typed entries are a prefix of the table.");
+
+    /// Number of stored results
+    static constexpr size_t entries = Fn::arity == 1 ? Size : Size * Size;
+
+protected:
+    template <size_t I>
+    static constexpr auto entry() -> size_t {
+        if constexpr (Fn::arity == 1) {
+            if constexpr (I < TypedSize) {
+                return to_value_v<typename Fn::template typed<nat_t<I>>>;
+            }
+            else {
+                return Fn::value(I);
+            }
+        }
+        else if constexpr (I / Size < TypedSize && I % Size < TypedSize) {
+            return to_value_v<typename Fn::template typed<nat_t<I / Size>, nat_t<I % Size>>>;
+        }
+        else {
+            return Fn::value(I / Size, I % Size);
+        }
+    }
+
+    template <size_t... Is>
+    static constexpr auto build(std::index_sequence<Is...>) -> std::array<size_t, entries> {
+        return {entry<Is>()...};
+    }
+
+public:
+    static constexpr std::array<size_t, entries> values = build(std::make_index_sequence<entries>{});
+
+    /// Whether the argument is in the table
+    static constexpr auto contains(size_t n) -> bool
+        requires(Fn::arity == 1)
+    {
+        return n < Size;
+    }
+
+    /// Whether the pair of arguments is in the table
+    static constexpr auto contains(size_t m, size_t n) -> bool
+        requires(Fn::arity == 2)
+    {
+        return m < Size && n < Size;
+    }
+
+    /// Fn of n: a table load in range, Fn::value outside it
+    static constexpr auto lookup(size_t n) -> size_t
+        requires(Fn::arity == 1)
+    {
+        return n < Size ? values[n] : Fn::value(n);
+    }
+
+    /// Fn of m and n: a table load in range, Fn::value outside it
+    static constexpr auto lookup(size_t m, size_t n) -> size_t
+        requires(Fn::arity == 2)
+    {
+        return m < Size && n < Size ? values[m * Size + n] : Fn::value(m, n);
+    }
+};
+
+/// Fn of n through its default DispatchTable
+template <typename Fn>
+constexpr auto lookup(size_t n) -> size_t {
+    return DispatchTable<Fn>::lookup(n);
+}
+
+/// Fn of m and n through its default DispatchTable
+template <typename Fn>
+constexpr auto lookup(size_t m, size_t n) -> size_t {
+    return DispatchTable<Fn>::lookup(m, n);
+}
+
 
 }; // namespace typical::nat
@@ -0,0 +1,270 @@
+module;
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+export module typical.native;
+
+import typical.lambda;
+import typical.lower;
+
+export namespace typical {
+
+// Dynamic values
+// ----------------
+//
+// Compiled terms are generic lambdas, typed by the C++ compiler at each use.
+// Self-application does not type that way, so the fixpoint behind Y and
+// iterations whose type changes at every step fall back to Dynamic, a
+// type-erased function from Dynamic to Dynamic (or a native number).
+
+class Dynamic;
+
+template <typename T>
+auto to_dynamic(T value) -> Dynamic;
+
+/// A type-erased function value, or a native number at the boundary
+class Dynamic {
+public:
+    using Function = std::function<Dynamic(Dynamic)>;
+
+    /// A number
+    Dynamic(std::size_t value = 0) : value_(value) {}
+
+    /// A function
+    template <typename F>
+        requires std::is_invocable_r_v<Dynamic, const F&, Dynamic>
+    static auto function(F f) -> Dynamic {
+        Dynamic d;
+        d.function_ = std::make_shared<const Function>(std::move(f));
+        return d;
+    }
+
+    auto is_function() const -> bool { return function_ != nullptr; }
+
+    /// The number; 0 for functions
+    auto value() const -> std::size_t { return value_; }
+
+    /// Apply to any compiled value, throwing std::invalid_argument if this is a number
+    template <typename A>
+    auto operator()(A arg) const -> Dynamic {
+        if (!function_) {
+            throw std::invalid_argument("a native number was applied as a function");
+        }
+        return (*function_)(to_dynamic(std::move(arg)));
+    }
+
+private:
+    std::shared_ptr<const Function> function_;
+    std::size_t value_ = 0;
+};
+
+/// Erase a compiled value: numbers and bools become numbers, callables become functions
+template <typename T>
+auto to_dynamic(T value) -> Dynamic {
+    if constexpr (std::is_same_v<T, Dynamic>) {
+        return value;
+    }
+    else if constexpr (std::is_integral_v<T>) {
+        return Dynamic(static_cast<std::size_t>(value));
+    }
+    else {
+        return Dynamic::function([value = std::move(value)](Dynamic arg) { return to_dynamic(value(std::move(arg))); });
+    }
+}
+
+/// Least fixpoint of a function under call-by-value: fix(f)(v) = f(fix(f))(v)
+inline auto fix(Dynamic f) -> Dynamic {
+    return Dynamic::function([f](Dynamic v) { return f(fix(f))(std::move(v)); });
+}
+
+// Compilation
+// ----------------
+//
+// Each Abs becomes a closure capturing its environment and each App a direct
+// call, so a term runs call-by-value, as the C++ calls it becomes. Recursion
+// through Y therefore needs guarded branches (λd. ...) as in any strict
+// language; the type-level evaluators reduce in normal order and do not.
+
+/// Environment with no bound variables
+struct NativeEnv {};
+
+/// Environment binding Var<0> to value, and Var<I + 1> to Var<I> of outer
+template <typename Value, typename Outer>
+struct BoundEnv {
+    Value value;
+    Outer outer;
+};
+
+/// The value bound to Var<Index>
+template <size_t Index, typename Env>
+constexpr auto lookup(const Env& env) {
+    static_assert(!std::is_same_v<Env, NativeEnv>, "compiled terms must be closed");
+    if constexpr (std::is_same_v<Env, NativeEnv>) {
+        return NativeEnv{};
+    }
+    else if constexpr (Index == 0) {
+        return env.value;
+    }
+    else {
+        return lookup<Index - 1>(env.outer);
+    }
+}
+
+/// Native code for a term
+template <typename Term>
+struct Native;
+
+/// Specialization for Var
+template <size_t Index>
+struct Native<Var<Index>> {
+    template <typename Env>
+    static constexpr auto run(const Env& env) {
+        return lookup<Index>(env);
+    }
+};
+
+/// Specialization for Abs
+template <typename Body>
+struct Native<Abs<Body>> {
+    template <typename Env>
+    static constexpr auto run(const Env& env) {
+        return [env](auto x) { return Native<Body>::run(BoundEnv<decltype(x), Env>{x, env}); };
+    }
+};
+
+/// Specialization for App
+template <typename Func, typename Arg>
+struct Native<App<Func, Arg>> {
+    template <typename Env>
+    static constexpr auto run(const Env& env) {
+        return Native<Func>::run(env)(Native<Arg>::run(env));
+    }
+};
+
+/// Specialization for Named (closed, so compiled without the environment)
+template <typename Tag, typename Def>
+struct Native<Named<Tag, Def>> {
+    template <typename Env>
+    static constexpr auto run(const Env&) {
+        return Native<Def>::run(NativeEnv{});
+    }
+};
+
+/// Specialization for Y, the one place recursion forces type erasure
+template <>
+struct Native<Y> {
+    template <typename Env>
+    static auto run(const Env&) {
+        return [](auto f) { return fix(to_dynamic(std::move(f))); };
+    }
+};
+
+/// A closed term as a native function object; constant-evaluable when it does not use Y
+template <LambdaTerm Term>
+constexpr auto compile() {
+    return Native<Term>::run(NativeEnv{});
+}
+
+// Boundary
+// ----------------
+
+/// f applied count times, as a loop; the loop runs on Dynamic when f changes the type of its argument
+template <typename F>
+struct NativeIterate {
+    F f;
+    std::size_t count;
+
+    template <typename X>
+    constexpr auto operator()(X x) const {
+        if constexpr (std::is_same_v<std::invoke_result_t<const F&, X>, X>) {
+            for (std::size_t i = 0; i < count; ++i) {
+                x = f(std::move(x));
+            }
+            return x;
+        }
+        else {
+            Dynamic d = to_dynamic(std::move(x));
+            for (std::size_t i = 0; i < count; ++i) {
+                d = to_dynamic(f(std::move(d)));
+            }
+            return d;
+        }
+    }
+};
+
+/// A runtime number as a Church numeral
+struct NativeNumeral {
+    std::size_t value;
+
+    template <typename F>
+    constexpr auto operator()(F f) const {
+        return NativeIterate<F>{std::move(f), value};
+    }
+};
+
+/// A runtime bool as a Church boolean; branches of different types are erased to Dynamic
+struct NativeBoolean {
+    bool value;
+
+    template <typename T>
+    constexpr auto operator()(T on_true) const {
+        return [value = value, on_true = std::move(on_true)](auto on_false) {
+            if constexpr (std::is_same_v<T, decltype(on_false)>) {
+                return value ? on_true : on_false;
+            }
+            else {
+                return value ? to_dynamic(on_true) : to_dynamic(std::move(on_false));
+            }
+        };
+    }
+};
+
+/// Successor on native numbers, used to read numerals back
+struct NativeSucc {
+    constexpr auto operator()(std::size_t n) const -> std::size_t { return n + 1; }
+    auto operator()(const Dynamic& n) const -> Dynamic { return Dynamic(n.value() + 1); }
+};
+
+/// Church encoding of a native value of shape Numeral or Boolean
+template <typename Shape>
+constexpr auto from_native(lowered_t<Shape> value) {
+    if constexpr (std::is_same_v<Shape, Numeral>) {
+        return NativeNumeral{value};
+    }
+    else {
+        static_assert(std::is_same_v<Shape, Boolean>, "only numerals and booleans cross the native boundary");
+        return NativeBoolean{value};
+    }
+}
+
+/// Native value of a compiled Church numeral or boolean, throwing std::invalid_argument on a function result
+template <typename Shape, typename T>
+constexpr auto to_native(const T& term) -> lowered_t<Shape> {
+    const auto result = [&] {
+        if constexpr (std::is_same_v<Shape, Numeral>) {
+            return term(NativeSucc{})(std::size_t{0});
+        }
+        else {
+            static_assert(std::is_same_v<Shape, Boolean>, "only numerals and booleans cross the native boundary");
+            return term(true)(false);
+        }
+    }();
+    if constexpr (std::is_same_v<std::remove_const_t<decltype(result)>, Dynamic>) {
+        if (result.is_function()) {
+            throw std::invalid_argument("compiled term does not have the requested shape");
+        }
+        return static_cast<lowered_t<Shape>>(result.value());
+    }
+    else {
+        static_assert(std::is_convertible_v<decltype(result), lowered_t<Shape>>,
+                      "compiled term does not have the requested shape");
+        return result;
+    }
+}
+
+} // namespace typical
@@ -0,0 +1,206 @@
+module;
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+export module typical.pool;
+
+export namespace typical {
+
+/// Fixed-size thread pool with one task deque per worker.
+///
+/// A worker pushes and pops tasks at the back of its own deque and, when it
+/// runs dry, steals from the front of the other workers' deques. Tasks
+/// submitted from outside the pool are distributed round-robin.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(std::size_t threads = std::thread::hardware_concurrency())
+        : queues_(std::max<std::size_t>(threads, 1)) {
+        for (auto& queue : queues_) {
+            queue = std::make_unique<Queue>();
+        }
+        workers_.reserve(queues_.size());
+        for (std::size_t i = 0; i < queues_.size(); ++i) {
+            workers_.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /// Number of worker threads
+    auto size() const -> std::size_t { return queues_.size(); }
+
+    /// Queue a task; from a worker it goes to that worker's own deque
+    void submit(Task task) {
+        const std::size_t target = current_worker_ != nullptr && current_pool_ == this
+                                       ? *current_worker_
+                                       : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(queues_[target]->mutex);
+            queues_[target]->tasks.push_back(std::move(task));
+        }
+        bool helping = false;
+        {
+            std::lock_guard lock(sleep_mutex_);
+            ++queued_;
+            helping = helpers_ > 0;
+        }
+        wake_.notify_one();
+        if (helping) {
+            done_.notify_all();
+        }
+    }
+
+    /// Block until every task submitted to the pool, by any caller, has finished; not from a worker thread, whose
+    /// own running task would never finish
+    void wait() {
+        assert(current_pool_ != this && "WorkStealingPool::wait from a worker deadlocks");
+        std::unique_lock lock(sleep_mutex_);
+        done_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+
+    /// Run body(begin, end) over [first, last) in blocks of at most grain and wait for those blocks only.
+    ///
+    /// The caller runs queued tasks while it waits, so parallel_for may be called from a worker: the nested blocks
+    /// are pushed on its own deque and it works through them itself if no other worker steals them.
+    template <typename Body>
+    void parallel_for(std::size_t first, std::size_t last, std::size_t grain, Body body) {
+        grain = std::max<std::size_t>(grain, 1);
+        if (first >= last) {
+            return;
+        }
+        std::atomic<std::size_t> remaining{(last - first + grain - 1) / grain};
+        for (std::size_t begin = first; begin < last; begin += grain) {
+            const std::size_t end = std::min(last, begin + grain);
+            submit([this, &remaining, body, begin, end] {
+                body(begin, end);
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard lock(sleep_mutex_);
+                    done_.notify_all();
+                }
+            });
+        }
+        help_until([&remaining] { return remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    auto pop_own(std::size_t self, Task& task) -> bool {
+        auto& queue = *queues_[self];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    auto steal(std::size_t self, Task& task) -> bool {
+        for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+            auto& queue = *queues_[(self + offset) % queues_.size()];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Run one task taken from the deque of self, or stolen from another; false if every deque is empty
+    auto run_one(std::size_t self) -> bool {
+        Task task;
+        if (!pop_own(self, task) && !steal(self, task)) {
+            return false;
+        }
+        {
+            std::lock_guard lock(sleep_mutex_);
+            --queued_;
+        }
+        task();
+        task = nullptr;
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard lock(sleep_mutex_);
+            done_.notify_all();
+        }
+        return true;
+    }
+
+    /// Run queued tasks on the calling thread until finished() holds, sleeping while there are none
+    template <typename Finished>
+    void help_until(Finished finished) {
+        const std::size_t self = current_pool_ == this
+                                     ? *current_worker_
+                                     : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        while (!finished()) {
+            if (run_one(self)) {
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            ++helpers_;
+            done_.wait(lock, [&] { return finished() || queued_ > 0; });
+            --helpers_;
+        }
+    }
+
+    void run(std::size_t self) {
+        current_worker_ = &self;
+        current_pool_ = this;
+        while (true) {
+            if (run_one(self)) {
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (stopping_ && queued_ == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> next_queue_{0};
+    std::atomic<std::size_t> pending_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::ptrdiff_t queued_ = 0;
+    std::size_t helpers_ = 0;
+    bool stopping_ = false;
+
+    static inline thread_local const std::size_t* current_worker_ = nullptr;
+    static inline thread_local const WorkStealingPool* current_pool_ = nullptr;
+};
+
+} // namespace typical
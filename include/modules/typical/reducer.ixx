@@ -0,0 +1,486 @@
+module;
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+export module typical.reducer;
+
+import typical.lambda;
+import typical.pool;
+
+namespace typical {
+
+/// Source of TermGraph identities for the per-thread allocation caches
+std::atomic<std::uint64_t> term_graph_ids{1};
+
+} // namespace typical
+
+export namespace typical {
+
+// Runtime terms
+// ----------------
+
+/// Node kinds of a runtime lambda term
+enum class TermKind : std::uint8_t { Var, Abs, App };
+
+/// Waiter on a node whose normal form another task is computing
+struct ReductionWaiter;
+
+/// Node of a runtime lambda term.
+///
+/// The term is immutable once built. The atomic fields only memoize its normal
+/// form, so a subterm shared by several parents is normalized once.
+struct TermNode {
+    TermKind kind = TermKind::Var;
+    /// de Bruijn index of a Var
+    std::uint32_t index = 0;
+    /// One more than the largest free index, 0 for closed terms
+    std::uint32_t free_bound = 0;
+    /// Number of nodes in the tree, saturating
+    std::uint32_t size = 1;
+    /// Body of an Abs, function of an App
+    const TermNode* left = nullptr;
+    /// Argument of an App
+    const TermNode* right = nullptr;
+
+    mutable std::atomic<const TermNode*> normal{nullptr};
+    mutable std::atomic<bool> claimed{false};
+    mutable std::atomic<ReductionWaiter*> waiters{nullptr};
+};
+
+/// Structural equality of two runtime terms
+inline auto term_equal(const TermNode* a, const TermNode* b) -> bool {
+    while (a != b) {
+        if (a->kind != b->kind) {
+            return false;
+        }
+        switch (a->kind) {
+            case TermKind::Var:
+                return a->index == b->index;
+            case TermKind::Abs:
+                a = a->left;
+                b = b->left;
+                break;
+            case TermKind::App:
+                if (!term_equal(a->left, b->left)) {
+                    return false;
+                }
+                a = a->right;
+                b = b->right;
+                break;
+        }
+    }
+    return true;
+}
+
+/// Arena of runtime term nodes.
+///
+/// Every thread allocates from its own blocks, so building and reducing terms
+/// from several pool workers takes no lock while a thread keeps to one graph.
+/// A thread switching between graphs takes the lock once per switch and picks
+/// up its arena in the other graph where it left off. Nodes live until the
+/// graph is destroyed.
+class TermGraph {
+public:
+    TermGraph() = default;
+    TermGraph(const TermGraph&) = delete;
+    TermGraph& operator=(const TermGraph&) = delete;
+
+    auto var(std::uint32_t index) -> const TermNode* {
+        auto* node = make<TermNode>();
+        node->kind = TermKind::Var;
+        node->index = index;
+        node->free_bound = index + 1;
+        return node;
+    }
+
+    auto abs(const TermNode* body) -> const TermNode* {
+        auto* node = make<TermNode>();
+        node->kind = TermKind::Abs;
+        node->left = body;
+        node->free_bound = body->free_bound > 0 ? body->free_bound - 1 : 0;
+        node->size = saturating_size(1, body->size);
+        return node;
+    }
+
+    auto app(const TermNode* func, const TermNode* arg) -> const TermNode* {
+        auto* node = make<TermNode>();
+        node->kind = TermKind::App;
+        node->left = func;
+        node->right = arg;
+        node->free_bound = std::max(func->free_bound, arg->free_bound);
+        node->size = saturating_size(saturating_size(1, func->size), arg->size);
+        return node;
+    }
+
+    /// a + b, clamped to UINT32_MAX so node counts of large shared DAGs do not wrap
+    static auto saturating_size(std::uint32_t a, std::uint32_t b) -> std::uint32_t {
+        return a > UINT32_MAX - b ? UINT32_MAX : a + b;
+    }
+
+    /// Construct a trivially destructible object that lives as long as the graph; callable from any thread
+    template <typename T, typename... Args>
+    auto make(Args&&... args) -> T* {
+        static_assert(std::is_trivially_destructible_v<T>, "Graph storage is released without running destructors.");
+        return ::new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+    }
+
+    /// Number of per-thread arenas, one for each thread that allocated from the graph
+    auto arena_count() -> std::size_t {
+        std::lock_guard lock(mutex_);
+        return locals_.size();
+    }
+
+    /// Number of blocks held by all arenas
+    auto block_count() -> std::size_t {
+        std::lock_guard lock(mutex_);
+        std::size_t count = 0;
+        for (const auto& [thread, l] : locals_) {
+            count += l->blocks.size();
+        }
+        return count;
+    }
+
+private:
+    struct Local {
+        std::vector<std::unique_ptr<std::byte[]>> blocks;
+        std::byte* cursor = nullptr;
+        std::byte* end = nullptr;
+    };
+
+    struct Cache {
+        std::uint64_t owner;
+        Local* local;
+    };
+
+    static constexpr std::size_t block_bytes = std::size_t{1} << 20;
+
+    auto local() -> Local& {
+        if (cache_.owner != id_) {
+            std::lock_guard lock(mutex_);
+            auto& l = locals_[std::this_thread::get_id()];
+            if (l == nullptr) {
+                l = std::make_unique<Local>();
+            }
+            cache_ = {id_, l.get()};
+        }
+        return *cache_.local;
+    }
+
+    auto allocate(std::size_t bytes, std::size_t align) -> void* {
+        auto& l = local();
+        void* p = l.cursor;
+        auto space = static_cast<std::size_t>(l.end - l.cursor);
+        if (l.cursor == nullptr || std::align(align, bytes, p, space) == nullptr) {
+            const std::size_t size = std::max(block_bytes, bytes + align);
+            l.blocks.push_back(std::make_unique<std::byte[]>(size));
+            l.cursor = l.blocks.back().get();
+            l.end = l.cursor + size;
+            p = l.cursor;
+            space = size;
+            std::align(align, bytes, p, space);
+        }
+        l.cursor = static_cast<std::byte*>(p) + bytes;
+        return p;
+    }
+
+    std::uint64_t id_ = term_graph_ids.fetch_add(1, std::memory_order_relaxed);
+    std::mutex mutex_;
+    std::unordered_map<std::thread::id, std::unique_ptr<Local>> locals_;
+
+    static inline thread_local Cache cache_{};
+};
+
+// Reification
+// ----------------
+
+/// Build the runtime graph of a typical.lambda term
+template <typename Term>
+struct Reify;
+
+template <size_t Index>
+struct Reify<Var<Index>> {
+    static auto apply(TermGraph& g) -> const TermNode* { return g.var(static_cast<std::uint32_t>(Index)); }
+};
+
+template <typename Body>
+struct Reify<Abs<Body>> {
+    static auto apply(TermGraph& g) -> const TermNode* { return g.abs(Reify<Body>::apply(g)); }
+};
+
+template <typename Func, typename Arg>
+struct Reify<App<Func, Arg>> {
+    static auto apply(TermGraph& g) -> const TermNode* {
+        return g.app(Reify<Func>::apply(g), Reify<Arg>::apply(g));
+    }
+};
+
+/// Named terms are inlined: the graph already shares their closed definition between all uses
+template <typename Tag, typename Def>
+struct Reify<Named<Tag, Def>> {
+    static auto apply(TermGraph& g) -> const TermNode* { return Reify<Def>::apply(g); }
+};
+
+/// Reify a term type into a graph, returning its root
+template <LambdaTerm Term>
+auto reify(TermGraph& graph) -> const TermNode* {
+    return Reify<Term>::apply(graph);
+}
+
+// Graph reduction
+// ----------------
+
+/// Pending normal form of an Abs or App, completed by its last child
+struct ReductionJoin {
+    std::atomic<int> remaining;
+    const TermNode* source;
+    const TermNode* head;
+    const TermNode* results[2];
+    ReductionJoin* parent;
+    int slot;
+};
+
+struct ReductionWaiter {
+    ReductionJoin* join;
+    int slot;
+    ReductionWaiter* next;
+};
+
+/// Graph reduction settings
+struct ReduceOptions {
+    /// Head reduction steps per subterm, as MaxSteps of Eval
+    std::size_t max_steps = 1000;
+    /// Subterms smaller than this are normalized on the current task
+    std::uint32_t spawn_threshold = 64;
+};
+
+/// Runtime normalizer for TermGraph terms.
+///
+/// Each subterm is evaluated to weak head normal form exactly as Eval does,
+/// then the children of the head are normalized, as in Normalize; the result
+/// is identical to normalize_t of the same term. On a pool the children of
+/// large neutral applications are independent tasks. A node is claimed
+/// atomically by the first task that reaches it, and tasks reaching it later
+/// park on its waiter list instead of reducing it again; no worker ever blocks.
+class GraphReducer {
+public:
+    explicit GraphReducer(TermGraph& graph, ReduceOptions options = {}) : graph_(graph), options_(options) {}
+
+    /// One reduction step, mirroring Reduce; nullptr when no step applies
+    auto step(const TermNode* t) -> const TermNode* {
+        if (t->kind != TermKind::App) {
+            return nullptr;
+        }
+        const TermNode* reduced = step(t->left);
+        const TermNode* func = reduced != nullptr ? reduced : t->left;
+        if (func->kind == TermKind::Abs) {
+            return beta(func->left, t->right);
+        }
+        return reduced != nullptr ? graph_.app(func, t->right) : nullptr;
+    }
+
+    /// Weak head normal form, mirroring Eval; sets diverged when a step leads back to one of the last four terms
+    auto whnf(const TermNode* t, bool* diverged = nullptr) -> const TermNode* {
+        const TermNode* recent[4] = {t, nullptr, nullptr, nullptr};
+        for (std::size_t i = 0; i < options_.max_steps; ++i) {
+            const TermNode* next = step(t);
+            if (next == nullptr) {
+                break;
+            }
+            for (const TermNode* seen : recent) {
+                if (seen != nullptr && seen->size == next->size && term_equal(seen, next)) {
+                    if (diverged != nullptr) {
+                        *diverged = true;
+                    }
+                    return t;
+                }
+            }
+            recent[3] = recent[2];
+            recent[2] = recent[1];
+            recent[1] = recent[0];
+            recent[0] = next;
+            t = next;
+        }
+        return t;
+    }
+
+    /// Normal form on the calling thread
+    auto normalize(const TermNode* t) -> const TermNode* {
+        ReductionJoin root{{1}, nullptr, nullptr, {nullptr, nullptr}, nullptr, 0};
+        pool_ = nullptr;
+        run(t, &root, 0);
+        return root.results[0];
+    }
+
+    /// Normal form with independent subterms reduced concurrently on a pool (not from one of its workers)
+    auto normalize(const TermNode* t, WorkStealingPool& pool) -> const TermNode* {
+        ReductionJoin root{{1}, nullptr, nullptr, {nullptr, nullptr}, nullptr, 0};
+        pool_ = &pool;
+        pool.submit([this, t, &root] { run(t, &root, 0); });
+        pool.wait();
+        pool_ = nullptr;
+        return root.results[0];
+    }
+
+private:
+    // Substitution, mirroring Shift, ShiftDown and Subst; unchanged subterms are shared
+
+    auto shift_up(const TermNode* t, std::uint32_t amount, std::uint32_t cutoff) -> const TermNode* {
+        if (t->free_bound <= cutoff) {
+            return t;
+        }
+        switch (t->kind) {
+            case TermKind::Var:
+                return graph_.var(t->index + amount);
+            case TermKind::Abs:
+                return graph_.abs(shift_up(t->left, amount, cutoff + 1));
+            case TermKind::App:
+                return graph_.app(shift_up(t->left, amount, cutoff), shift_up(t->right, amount, cutoff));
+        }
+        return t;
+    }
+
+    auto shift_down(const TermNode* t, std::uint32_t amount, std::uint32_t cutoff) -> const TermNode* {
+        if (t->free_bound <= cutoff) {
+            return t;
+        }
+        switch (t->kind) {
+            case TermKind::Var:
+                return graph_.var(t->index - amount);
+            case TermKind::Abs:
+                return graph_.abs(shift_down(t->left, amount, cutoff + 1));
+            case TermKind::App:
+                return graph_.app(shift_down(t->left, amount, cutoff), shift_down(t->right, amount, cutoff));
+        }
+        return t;
+    }
+
+    auto subst(const TermNode* t, std::uint32_t index, const TermNode* replacement) -> const TermNode* {
+        if (t->free_bound <= index) {
+            return t;
+        }
+        switch (t->kind) {
+            case TermKind::Var:
+                return t->index == index ? replacement : t;
+            case TermKind::Abs:
+                return graph_.abs(subst(t->left, index + 1, shift_up(replacement, 1, 0)));
+            case TermKind::App:
+                return graph_.app(subst(t->left, index, replacement), subst(t->right, index, replacement));
+        }
+        return t;
+    }
+
+    auto beta(const TermNode* body, const TermNode* arg) -> const TermNode* {
+        return shift_down(subst(body, 0, shift_up(arg, 1, 0)), 1, 0);
+    }
+
+    // Normalization tasks
+
+    static auto done_sentinel() -> ReductionWaiter* {
+        static ReductionWaiter sentinel{};
+        return &sentinel;
+    }
+
+    void run(const TermNode* t, ReductionJoin* join, int slot) {
+        if (const TermNode* normal = t->normal.load(std::memory_order_acquire)) {
+            complete(join, slot, normal);
+            return;
+        }
+        if (t->claimed.exchange(true, std::memory_order_acq_rel)) {
+            park(t, join, slot);
+            return;
+        }
+
+        bool diverged = false;
+        const TermNode* head = whnf(t, &diverged);
+        if (diverged) {
+            publish(t, head);
+            complete(join, slot, head);
+            return;
+        }
+        switch (head->kind) {
+            case TermKind::Var:
+                publish(t, head);
+                complete(join, slot, head);
+                return;
+            case TermKind::Abs: {
+                auto* next = graph_.make<ReductionJoin>(1, t, head, nullptr, nullptr, join, slot);
+                run(head->left, next, 0);
+                return;
+            }
+            case TermKind::App: {
+                auto* next = graph_.make<ReductionJoin>(2, t, head, nullptr, nullptr, join, slot);
+                if (pool_ != nullptr && head->right->size >= options_.spawn_threshold &&
+                    head->left->size >= options_.spawn_threshold) {
+                    const TermNode* arg = head->right;
+                    pool_->submit([this, arg, next] { run(arg, next, 1); });
+                }
+                else {
+                    run(head->right, next, 1);
+                }
+                run(head->left, next, 0);
+                return;
+            }
+        }
+    }
+
+    /// Wait for the task that claimed t, or take its result if it already finished
+    void park(const TermNode* t, ReductionJoin* join, int slot) {
+        auto* waiter = graph_.make<ReductionWaiter>(join, slot, nullptr);
+        ReductionWaiter* head = t->waiters.load(std::memory_order_acquire);
+        do {
+            if (head == done_sentinel()) {
+                complete(join, slot, t->normal.load(std::memory_order_acquire));
+                return;
+            }
+            waiter->next = head;
+        } while (!t->waiters.compare_exchange_weak(head, waiter, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire));
+    }
+
+    /// Record the normal form of t and resume every task parked on it
+    void publish(const TermNode* t, const TermNode* normal) {
+        t->normal.store(normal, std::memory_order_release);
+        ReductionWaiter* waiter = t->waiters.exchange(done_sentinel(), std::memory_order_acq_rel);
+        while (waiter != nullptr) {
+            ReductionWaiter* next = waiter->next;
+            complete(waiter->join, waiter->slot, normal);
+            waiter = next;
+        }
+    }
+
+    void complete(ReductionJoin* join, int slot, const TermNode* normal) {
+        join->results[slot] = normal;
+        if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1 || join->source == nullptr) {
+            return;
+        }
+        const TermNode* head = join->head;
+        const TermNode* result = nullptr;
+        if (head->kind == TermKind::Abs) {
+            result = join->results[0] == head->left ? head : graph_.abs(join->results[0]);
+        }
+        else {
+            result = join->results[0] == head->left && join->results[1] == head->right
+                         ? head
+                         : graph_.app(join->results[0], join->results[1]);
+        }
+        publish(join->source, result);
+        complete(join->parent, join->slot, result);
+    }
+
+    TermGraph& graph_;
+    ReduceOptions options_;
+    WorkStealingPool* pool_ = nullptr;
+};
+
+} // namespace typical
@@ -1,7 +1,285 @@
 module;
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
 
 export module typical.refine;
 
 export namespace typical {
-struct Refinement {};
+
+// Predicates
+// ----------------
+
+/// A refinement predicate: a stateless, default-constructible test on T.
+/// The predicates below avoid short-circuiting, so batch checks compile to vector compares.
+template <typename P, typename T>
+concept RefinementPredicate = std::is_empty_v<P> && std::default_initializable<P> && std::predicate<const P&, const T&>;
+
+/// x > 0
+struct Positive {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return x > T{};
+    }
+};
+
+/// x >= 0
+struct NonNegative {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return x >= T{};
+    }
+};
+
+/// x != 0
+struct NonZero {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return x != T{};
+    }
+};
+
+/// Neither infinite nor NaN
+struct Finite {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return (x >= std::numeric_limits<T>::lowest()) & (x <= std::numeric_limits<T>::max());
+    }
+};
+
+/// Lo <= x <= Hi
+template <auto Lo, auto Hi>
+struct InRange {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return (x >= static_cast<T>(Lo)) & (x <= static_cast<T>(Hi));
+    }
+};
+
+/// x < Bound
+template <auto Bound>
+struct LessThan {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return x < static_cast<T>(Bound);
+    }
+};
+
+/// x > Bound
+template <auto Bound>
+struct GreaterThan {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return x > static_cast<T>(Bound);
+    }
+};
+
+/// Conjunction of predicates
+template <typename... Ps>
+struct All {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return (true & ... & static_cast<bool>(Ps{}(x)));
+    }
+};
+
+/// Negation of a predicate
+template <typename P>
+struct Not {
+    template <typename T>
+    constexpr auto operator()(const T& x) const -> bool {
+        return !P{}(x);
+    }
+};
+
+/// Whether every value satisfying P satisfies Q: Q itself, or one of the conjuncts of All
+template <typename P, typename Q>
+struct Implies : std::is_same<P, Q> {};
+
+/// Specialization for All
+template <typename... Ps, typename Q>
+struct Implies<All<Ps...>, Q> : std::bool_constant<std::is_same_v<All<Ps...>, Q> || (Implies<Ps, Q>::value || ...)> {};
+
+/// Helper variable for Implies
+template <typename P, typename Q>
+inline constexpr bool implies_v = Implies<P, Q>::value;
+
+// Refined values
+// ----------------
+
+/// Called when a compile-time refinement fails; not constexpr, so the constant expression is rejected
+inline void refinement_failed() {}
+
+/// A T known to satisfy Predicate.
+///
+/// Has the size and layout of T. Construction from a constant is checked
+/// once, at compile time; runtime values go through refine or try_refine.
+/// A Refined converts to any refinement its predicate implies.
+template <typename T, typename Predicate>
+    requires RefinementPredicate<Predicate, T>
+class Refined {
+public:
+    using value_type = T;
+    using predicate = Predicate;
+
+    /// Construct from a constant expression, failing to compile if Predicate does not hold
+    consteval Refined(T value) : value_(value) {
+        if (!Predicate{}(value_)) {
+            refinement_failed();
+        }
+    }
+
+    /// Weaken to a refinement implied by Predicate, without re-checking
+    template <typename Q>
+        requires(!std::is_same_v<Q, Predicate> && implies_v<Predicate, Q>)
+    constexpr operator Refined<T, Q>() const {
+        return Refined<T, Q>::trusted(value_);
+    }
+
+    constexpr auto value() const -> const T& { return value_; }
+    constexpr operator const T&() const { return value_; }
+
+    /// Runtime check, empty if Predicate does not hold
+    static constexpr auto check(const T& value) -> std::optional<Refined> {
+        if (!Predicate{}(value)) {
+            return std::nullopt;
+        }
+        return trusted(value);
+    }
+
+    /// Wrap a value whose check has already been done by the caller
+    static constexpr auto trusted(const T& value) -> Refined { return Refined(value, Trusted{}); }
+
+private:
+    struct Trusted {};
+
+    constexpr Refined(const T& value, Trusted) : value_(value) {}
+
+    T value_;
+};
+
+/// Checked factory for runtime values, empty if Predicate does not hold
+template <typename Predicate, typename T>
+constexpr auto try_refine(const T& value) -> std::optional<Refined<T, Predicate>> {
+    return Refined<T, Predicate>::check(value);
+}
+
+/// Checked factory for runtime values, throwing std::invalid_argument if Predicate does not hold
+template <typename Predicate, typename T>
+constexpr auto refine(const T& value) -> Refined<T, Predicate> {
+    if (!Predicate{}(value)) {
+        throw std::invalid_argument("value does not satisfy its refinement");
+    }
+    return Refined<T, Predicate>::trusted(value);
+}
+
+// Batch validation
+// ----------------
+
+/// Values checked per branch in refine_span
+inline constexpr std::size_t refine_block = 256;
+
+/// A span of T whose every value is known to satisfy Predicate.
+///
+/// The values stay in the caller's memory as plain T, so no Refined object is
+/// ever read through a T; element access and iteration wrap each value in a
+/// Refined by value, without re-checking.
+template <typename T, typename Predicate>
+    requires RefinementPredicate<Predicate, T>
+class RefinedView {
+public:
+    using value_type = Refined<T, Predicate>;
+
+    /// Forward iterator yielding refined values
+    class iterator {
+    public:
+        using value_type = Refined<T, Predicate>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit constexpr iterator(const T* at) : at_(at) {}
+
+        constexpr auto operator*() const -> value_type { return value_type::trusted(*at_); }
+
+        constexpr auto operator++() -> iterator& {
+            ++at_;
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> iterator {
+            const iterator before = *this;
+            ++at_;
+            return before;
+        }
+
+        constexpr auto operator==(const iterator&) const -> bool = default;
+
+    private:
+        const T* at_ = nullptr;
+    };
+
+    RefinedView() = default;
+
+    /// View values the caller has already checked against Predicate
+    static constexpr auto trusted(std::span<const T> values) -> RefinedView { return RefinedView(values); }
+
+    constexpr auto size() const -> std::size_t { return values_.size(); }
+    constexpr auto empty() const -> bool { return values_.empty(); }
+    constexpr auto data() const -> const T* { return values_.data(); }
+
+    /// The underlying values
+    constexpr auto values() const -> std::span<const T> { return values_; }
+
+    constexpr auto operator[](std::size_t i) const -> value_type { return value_type::trusted(values_[i]); }
+    constexpr auto begin() const -> iterator { return iterator(values_.data()); }
+    constexpr auto end() const -> iterator { return iterator(values_.data() + values_.size()); }
+
+private:
+    explicit constexpr RefinedView(std::span<const T> values) : values_(values) {}
+
+    std::span<const T> values_;
+};
+
+/// Check a whole span against Predicate.
+///
+/// Each block of refine_block values is tested with a branch-free count of
+/// failures, which vectorizes for the predicates above; only a failing block
+/// is rescanned to find the first failing value. Returns a view of the valid
+/// prefix over the same memory, so it has the size of values exactly when
+/// every value passes.
+template <typename Predicate, typename T>
+    requires RefinementPredicate<Predicate, T>
+auto refine_span(std::span<const T> values) -> RefinedView<T, Predicate> {
+    const Predicate predicate{};
+    const T* data = values.data();
+    std::size_t valid = 0;
+    while (valid < values.size()) {
+        const std::size_t n = std::min(refine_block, values.size() - valid);
+        const T* block = data + valid;
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            failures += static_cast<std::size_t>(!predicate(block[i]));
+        }
+        if (failures != 0) {
+            valid += static_cast<std::size_t>(std::find_if_not(block, block + n, predicate) - block);
+            break;
+        }
+        valid += n;
+    }
+    return RefinedView<T, Predicate>::trusted(values.first(valid));
+}
+
+/// refine_span over a mutable span
+template <typename Predicate, typename T>
+    requires RefinementPredicate<Predicate, T>
+auto refine_span(std::span<T> values) -> RefinedView<T, Predicate> {
+    return refine_span<Predicate>(std::span<const T>(values));
+}
+
 } // namespace typical
@@ -0,0 +1,176 @@
+module;
+#include <cstddef>
+#include <type_traits>
+
+
+export module typical.scott;
+
+import typical.lambda;
+import typical.church;
+
+export namespace typical {
+
+// Scott encodings
+// ----------------
+//
+// A Scott-encoded value is its own case analysis: applied to one function per
+// constructor, it calls the function of its constructor with the constructor's
+// fields. The fields of a recursive value are stored unevaluated, so Pred,
+// Head and Tail take a constant number of steps. A Church value is its own
+// fold, so its Tail must rebuild the list. The price is that a Scott value
+// cannot iterate over itself, so recursion over one goes through Y or is
+// driven by a Church numeral. Maybe and Either are not recursive, and their
+// Scott and Church encodings coincide.
+
+namespace scott {
+
+/// Case analysis: Scrutinee applied to one case per constructor, in constructor order
+template <typename Scrutinee, typename... Cases>
+struct CaseBuilder;
+
+/// Base case: the scrutinee itself
+template <typename Scrutinee>
+struct CaseBuilder<Scrutinee> {
+    using Result = Scrutinee;
+};
+
+/// Recursive case: apply the first case, then the rest
+template <typename Scrutinee, typename First, typename... Rest>
+struct CaseBuilder<Scrutinee, First, Rest...> {
+    using Result = typename CaseBuilder<App<Scrutinee, First>, Rest...>::Result;
+};
+
+/// Alias for CaseBuilder
+template <typename Scrutinee, typename... Cases>
+using Case = typename CaseBuilder<Scrutinee, Cases...>::Result;
+
+// Scott numerals
+
+/// Zero = λz.λs.z
+using Zero = Abs<Abs<Var<1>>>;
+
+/// Succ = λn.λz.λs.s n
+using Succ = Abs<Abs<Abs<App<Var<0>, Var<2>>>>>;
+
+/// Pred = λn.n Zero (λm.m)  -- Pred 0 = 0, constant steps
+using Pred = Abs<Case<Var<0>, Zero, Id>>;
+
+/// IsZero = λn.n True (λm.False)
+using IsZero = Abs<Case<Var<0>, True, Abs<False>>>;
+
+/// Scott numeral N in normal form
+template <size_t N>
+struct ScottNumeral {
+    using Result = Abs<Abs<App<Var<0>, typename ScottNumeral<N - 1>::Result>>>;
+};
+
+/// Base case: Zero
+template <>
+struct ScottNumeral<0> {
+    using Result = Zero;
+};
+
+/// Alias for ScottNumeral
+template <size_t N>
+using numeral_t = typename ScottNumeral<N>::Result;
+
+/// Value of a Scott numeral in normal form
+template <typename Term>
+struct NumeralValue;
+
+/// Specialization for Zero
+template <>
+struct NumeralValue<Zero> {
+    static constexpr size_t value = 0;
+};
+
+/// Specialization for Succ n
+template <typename Predecessor>
+struct NumeralValue<Abs<Abs<App<Var<0>, Predecessor>>>> {
+    static constexpr size_t value = NumeralValue<Predecessor>::value + 1;
+};
+
+/// Value of the Scott numeral Term normalizes to
+template <typename Term>
+inline constexpr size_t numeral_value_v = NumeralValue<normalize_t<Term>>::value;
+
+// Scott lists
+
+/// Nil = λn.λc.n
+using Nil = Abs<Abs<Var<1>>>;
+
+/// Cons = λh.λt.λn.λc.c h t
+using Cons = Abs<Abs<Abs<Abs<App<App<Var<0>, Var<3>>, Var<2>>>>>>;
+
+/// MakeCons constructs a Scott list from head and tail
+template <typename Head, typename Tail>
+using MakeCons = App<App<Cons, Head>, Tail>;
+
+/// Head = λl.l ⊥ (λh.λt.h)  -- a free variable stands in for the head of Nil, as in the Church Head
+using Head = Abs<Case<Var<0>, Var<999>, Abs<Abs<Var<1>>>>>;
+
+/// Tail = λl.l Nil (λh.λt.t)  -- Tail Nil = Nil, constant steps
+using Tail = Abs<Case<Var<0>, Nil, Abs<Abs<Var<0>>>>>;
+
+/// IsNil = λl.l True (λh.λt.False)
+using IsNil = Abs<Case<Var<0>, True, Abs<Abs<False>>>>;
+
+/// Nth = λn.λl.Head (n Tail l)  -- element n of a Scott list, counting from 0, for a Church numeral n
+using Nth = Abs<Abs<App<Head, App<App<Var<1>, Tail>, Var<0>>>>>;
+
+/// BuildList constructs a Scott list from a variadic pack of types
+template <typename... Ts>
+struct ListBuilder;
+
+/// Base case: empty list
+template <>
+struct ListBuilder<> {
+    using Result = Nil;
+};
+
+/// Recursive case: construct Cons from head and recursively built tail
+template <typename T, typename... Rest>
+struct ListBuilder<T, Rest...> {
+    using Result = MakeCons<T, typename ListBuilder<Rest...>::Result>;
+};
+
+/// Alias for ListBuilder
+template <typename... Ts>
+using BuildList = typename ListBuilder<Ts...>::Result;
+
+// Scott Maybe and Either, identical to the Church forms
+
+using Nothing = typical::Nothing;
+using Just = typical::Just;
+
+template <typename T>
+using MakeJust = typical::MakeJust<T>;
+
+using Left = typical::Left;
+using Right = typical::Right;
+
+template <typename T>
+using MakeLeft = typical::MakeLeft<T>;
+
+template <typename T>
+using MakeRight = typical::MakeRight<T>;
+
+// Conversions
+
+/// FromChurch = λc.c Succ Zero
+using FromChurch = Abs<App<App<Var<0>, Succ>, Zero>>;
+
+/// ToChurch = Y (λr.λn.n 0 (λm.S (r m)))
+using ToChurch =
+    App<Y, Abs<Abs<Case<Var<0>, typical::Zero, Abs<App<typical::Succ, App<Var<2>, Var<0>>>>>>>>;
+
+/// FromChurchList = λl.l Cons Nil
+using FromChurchList = Abs<App<App<Var<0>, Cons>, Nil>>;
+
+/// ToChurchList = Y (λr.λl.l Nil (λh.λt.Cons h (r t)))
+using ToChurchList = App<
+    Y, Abs<Abs<Case<Var<0>, typical::Nil, Abs<Abs<App<App<typical::Cons, Var<1>>, App<Var<3>, Var<0>>>>>>>>>;
+
+} // namespace scott
+
+} // namespace typical
@@ -0,0 +1,556 @@
+module;
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+export module typical.serialize;
+
+import typical.lambda;
+import typical.mapped;
+import typical.reducer;
+
+export namespace typical {
+
+// Term corpus format
+// ----------------
+//
+// A corpus file holds any number of root terms and a table of subterms shared
+// between them. All integers in the header are little-endian.
+//
+//   0   "TLAM"                     magic
+//   4   u32 version                currently 1
+//   8   u64 root count R
+//   16  u64 shared entry count T
+//   24  u64 offsets[R + T]         byte offset of each root, then of each entry
+//   ... term code
+//
+// Term code is pre-order, one opcode byte per node:
+//
+//   0x00                Abs, followed by the body
+//   0x01 len            App, followed by the function (len bytes) and the argument
+//   0x02 k              Ref to shared entry k
+//   0x03 i              Var i for i >= 252
+//   0x04 + i            Var i for i < 252
+//
+// len, k and i are LEB128 varints. The function length lets a reader reach
+// the argument of an application without decoding the function. Shared entry
+// k may only reference entries before it, so references never form a cycle.
+
+/// Corpus format constants
+struct TermCodec {
+    static constexpr char magic[4] = {'T', 'L', 'A', 'M'};
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t header_bytes = 24;
+
+    static constexpr std::uint8_t op_abs = 0x00;
+    static constexpr std::uint8_t op_app = 0x01;
+    static constexpr std::uint8_t op_ref = 0x02;
+    static constexpr std::uint8_t op_var = 0x03;
+    static constexpr std::uint8_t op_small_var = 0x04;
+    static constexpr std::uint32_t small_var_limit = 256 - op_small_var;
+
+    static auto varint_size(std::uint64_t value) -> std::size_t {
+        std::size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    static void put_varint(std::vector<std::byte>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::byte>(value));
+    }
+
+    static void put_u64(std::byte* out, std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<std::byte>(value >> (8 * i));
+        }
+    }
+
+    static auto get_u64(const std::byte* in) -> std::uint64_t {
+        std::uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | static_cast<std::uint64_t>(in[i]);
+        }
+        return value;
+    }
+};
+
+/// Encoding settings
+struct WriteOptions {
+    /// Subterms with at least this many nodes that occur more than once go to the shared table
+    std::uint32_t min_shared_size = 8;
+};
+
+/// Serializes runtime or type-level terms into a corpus.
+///
+/// Structurally equal subterms are merged across every added term, and merged
+/// subterms that are both repeated and large enough are written once to the
+/// shared table and referenced from each occurrence.
+class TermWriter {
+public:
+    explicit TermWriter(WriteOptions options = {}) : options_(options) {}
+
+    /// Add a root term, returning its index in the corpus
+    auto add(const TermNode* term) -> std::size_t {
+        const std::uint32_t id = intern(term);
+        ++nodes_[id].uses;
+        roots_.push_back(id);
+        return roots_.size() - 1;
+    }
+
+    /// Add a term type, returning its index in the corpus
+    template <LambdaTerm Term>
+    auto add() -> std::size_t {
+        return add(reify<Term>(graph_));
+    }
+
+    /// Encode the corpus
+    auto bytes() -> std::vector<std::byte> {
+        std::vector<std::uint32_t> entries;
+        entry_of_.assign(nodes_.size(), none);
+        for (std::uint32_t id = 0; id < nodes_.size(); ++id) {
+            if (nodes_[id].uses > 1 && nodes_[id].size >= options_.min_shared_size && nodes_[id].kind != TermKind::Var) {
+                entry_of_[id] = static_cast<std::uint32_t>(entries.size());
+                entries.push_back(id);
+            }
+        }
+
+        // Interned ids are created children first, so code sizes can be filled in id order
+        code_size_.assign(nodes_.size(), 0);
+        for (std::uint32_t id = 0; id < nodes_.size(); ++id) {
+            const Node& n = nodes_[id];
+            switch (n.kind) {
+                case TermKind::Var:
+                    code_size_[id] = n.index < TermCodec::small_var_limit ? 1 : 1 + TermCodec::varint_size(n.index);
+                    break;
+                case TermKind::Abs:
+                    code_size_[id] = 1 + reference_size(n.left);
+                    break;
+                case TermKind::App:
+                    code_size_[id] = 1 + TermCodec::varint_size(reference_size(n.left)) + reference_size(n.left) +
+                                     reference_size(n.right);
+                    break;
+            }
+        }
+
+        const std::size_t count = roots_.size() + entries.size();
+        std::vector<std::byte> out(TermCodec::header_bytes + 8 * count);
+        std::memcpy(out.data(), TermCodec::magic, 4);
+        for (int i = 0; i < 4; ++i) {
+            out[4 + i] = static_cast<std::byte>(TermCodec::version >> (8 * i));
+        }
+        TermCodec::put_u64(out.data() + 8, roots_.size());
+        TermCodec::put_u64(out.data() + 16, entries.size());
+
+        std::size_t slot = 0;
+        const auto emit_top = [&](std::uint32_t id) {
+            TermCodec::put_u64(out.data() + TermCodec::header_bytes + 8 * slot++, out.size());
+            emit(out, id);
+        };
+        for (std::uint32_t id : roots_) {
+            emit_top(id);
+        }
+        for (std::uint32_t id : entries) {
+            emit_top(id);
+        }
+        return out;
+    }
+
+    /// Encode the corpus into a file
+    void write(const std::filesystem::path& path) {
+        const auto data = bytes();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            throw std::runtime_error("cannot write term corpus " + path.string());
+        }
+    }
+
+private:
+    static constexpr std::uint32_t none = UINT32_MAX;
+
+    struct Node {
+        TermKind kind;
+        std::uint32_t index;
+        std::uint32_t left;
+        std::uint32_t right;
+        std::uint32_t size;
+        std::uint32_t uses;
+
+        auto operator==(const Node& other) const -> bool {
+            return kind == other.kind && index == other.index && left == other.left && right == other.right;
+        }
+    };
+
+    struct NodeHash {
+        auto operator()(const Node& n) const -> std::size_t {
+            std::size_t h = static_cast<std::size_t>(n.kind);
+            for (std::uint32_t part : {n.index, n.left, n.right}) {
+                h ^= std::hash<std::uint32_t>{}(part) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            }
+            return h;
+        }
+    };
+
+    auto intern(const TermNode* term) -> std::uint32_t {
+        if (auto it = seen_.find(term); it != seen_.end()) {
+            return it->second;
+        }
+        Node key{term->kind, 0, none, none, 1, 0};
+        switch (term->kind) {
+            case TermKind::Var:
+                key.index = term->index;
+                break;
+            case TermKind::Abs:
+                key.left = intern(term->left);
+                key.size = TermGraph::saturating_size(1, nodes_[key.left].size);
+                break;
+            case TermKind::App:
+                key.left = intern(term->left);
+                key.right = intern(term->right);
+                key.size = TermGraph::saturating_size(TermGraph::saturating_size(1, nodes_[key.left].size),
+                                                      nodes_[key.right].size);
+                break;
+        }
+        auto [it, inserted] = ids_.try_emplace(key, static_cast<std::uint32_t>(nodes_.size()));
+        if (inserted) {
+            nodes_.push_back(key);
+            if (key.left != none) {
+                ++nodes_[key.left].uses;
+            }
+            if (key.right != none) {
+                ++nodes_[key.right].uses;
+            }
+        }
+        seen_.emplace(term, it->second);
+        return it->second;
+    }
+
+    /// Bytes taken where id occurs as a child: a Ref when it is shared, its code otherwise
+    auto reference_size(std::uint32_t id) const -> std::size_t {
+        return entry_of_[id] != none ? 1 + TermCodec::varint_size(entry_of_[id]) : code_size_[id];
+    }
+
+    void emit_child(std::vector<std::byte>& out, std::uint32_t id) const {
+        if (entry_of_[id] != none) {
+            out.push_back(static_cast<std::byte>(TermCodec::op_ref));
+            TermCodec::put_varint(out, entry_of_[id]);
+        }
+        else {
+            emit(out, id);
+        }
+    }
+
+    void emit(std::vector<std::byte>& out, std::uint32_t id) const {
+        const Node& n = nodes_[id];
+        switch (n.kind) {
+            case TermKind::Var:
+                if (n.index < TermCodec::small_var_limit) {
+                    out.push_back(static_cast<std::byte>(TermCodec::op_small_var + n.index));
+                }
+                else {
+                    out.push_back(static_cast<std::byte>(TermCodec::op_var));
+                    TermCodec::put_varint(out, n.index);
+                }
+                break;
+            case TermKind::Abs:
+                out.push_back(static_cast<std::byte>(TermCodec::op_abs));
+                emit_child(out, n.left);
+                break;
+            case TermKind::App:
+                out.push_back(static_cast<std::byte>(TermCodec::op_app));
+                TermCodec::put_varint(out, reference_size(n.left));
+                emit_child(out, n.left);
+                emit_child(out, n.right);
+                break;
+        }
+    }
+
+    WriteOptions options_;
+    TermGraph graph_;
+    std::vector<Node> nodes_;
+    std::unordered_map<Node, std::uint32_t, NodeHash> ids_;
+    std::unordered_map<const TermNode*, std::uint32_t> seen_;
+    std::vector<std::uint32_t> roots_;
+    std::vector<std::uint32_t> entry_of_;
+    std::vector<std::size_t> code_size_;
+};
+
+/// Position in the code of a corpus; shared-entry references are followed transparently
+class TermCursor {
+public:
+    /// Cursor at a root; entries is the number of shared entries its references may name
+    TermCursor(std::span<const std::byte> data, std::size_t entries, std::size_t position)
+        : data_(data), entries_(entries), position_(position) {
+        resolve();
+    }
+
+    auto kind() const -> TermKind { return kind_; }
+
+    /// de Bruijn index of a Var
+    auto index() const -> std::uint32_t { return index_; }
+
+    /// Byte offset of the node's opcode
+    auto position() const -> std::size_t { return position_; }
+
+    /// Shared entry this node was reached through, if any
+    auto entry() const -> std::optional<std::size_t> { return entry_; }
+
+    /// Body of an Abs
+    auto body() const -> TermCursor { return {data_, entries_, operand_}; }
+
+    /// Function of an App
+    auto func() const -> TermCursor { return {data_, entries_, operand_}; }
+
+    /// Argument of an App, found without decoding the function
+    auto arg() const -> TermCursor { return {data_, entries_, operand_ + func_bytes_}; }
+
+private:
+    auto byte_at(std::size_t at) const -> std::uint8_t {
+        if (at >= data_.size()) {
+            throw std::out_of_range("term code runs past the end of the corpus");
+        }
+        return static_cast<std::uint8_t>(data_[at]);
+    }
+
+    auto varint_at(std::size_t& at) const -> std::uint64_t {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t b = byte_at(at++);
+            value |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if ((b & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("malformed varint in term code");
+    }
+
+    void resolve() {
+        for (;;) {
+            std::size_t at = position_;
+            const std::uint8_t op = byte_at(at++);
+            if (op != TermCodec::op_ref) {
+                decode(op, at);
+                return;
+            }
+            const std::uint64_t k = varint_at(at);
+            if (k >= entries_) {
+                throw std::out_of_range("invalid shared entry reference in term code");
+            }
+            const std::uint64_t roots = TermCodec::get_u64(data_.data() + 8);
+            position_ = static_cast<std::size_t>(
+                TermCodec::get_u64(data_.data() + TermCodec::header_bytes + 8 * (roots + k)));
+            entry_ = static_cast<std::size_t>(k);
+            // Code inside entry k may only reference the entries before it
+            entries_ = entry_.value();
+        }
+    }
+
+    void decode(std::uint8_t op, std::size_t at) {
+        if (op >= TermCodec::op_small_var) {
+            kind_ = TermKind::Var;
+            index_ = op - TermCodec::op_small_var;
+        }
+        else if (op == TermCodec::op_var) {
+            kind_ = TermKind::Var;
+            index_ = static_cast<std::uint32_t>(varint_at(at));
+        }
+        else if (op == TermCodec::op_abs) {
+            kind_ = TermKind::Abs;
+            operand_ = at;
+        }
+        else {
+            kind_ = TermKind::App;
+            func_bytes_ = static_cast<std::size_t>(varint_at(at));
+            operand_ = at;
+        }
+    }
+
+    std::span<const std::byte> data_;
+    /// Shared entries a reference at or below this node may name
+    std::size_t entries_;
+    std::size_t position_;
+    std::optional<std::size_t> entry_;
+    TermKind kind_ = TermKind::Var;
+    std::uint32_t index_ = 0;
+    std::size_t operand_ = 0;
+    std::size_t func_bytes_ = 0;
+};
+
+/// Read-only view of an encoded corpus, either borrowed bytes or a memory-mapped file.
+///
+/// Opening checks the header only, so it costs the same for any corpus size;
+/// code is decoded lazily as cursors walk it.
+class TermCorpus {
+public:
+    /// View encoded bytes that outlive the corpus
+    explicit TermCorpus(std::span<const std::byte> data) : data_(data) { check_header(); }
+
+    /// Map a corpus file
+    static auto open(const std::filesystem::path& path) -> TermCorpus {
+        auto file = MappedFile::open_read(path);
+        file.advise_sequential();
+        const std::span<const std::byte> data(file.data(), file.size());
+        TermCorpus corpus(data);
+        corpus.file_ = std::move(file);
+        return corpus;
+    }
+
+    /// Number of root terms
+    auto size() const -> std::size_t { return roots_; }
+
+    /// Number of shared subterm entries
+    auto shared() const -> std::size_t { return entries_; }
+
+    auto bytes() const -> std::span<const std::byte> { return data_; }
+
+    /// Cursor at root term i
+    auto root(std::size_t i) const -> TermCursor {
+        if (i >= roots_) {
+            throw std::out_of_range("term corpus root index out of range");
+        }
+        return {data_, entries_, static_cast<std::size_t>(TermCodec::get_u64(data_.data() + TermCodec::header_bytes + 8 * i))};
+    }
+
+private:
+    void check_header() {
+        if (data_.size() < TermCodec::header_bytes || std::memcmp(data_.data(), TermCodec::magic, 4) != 0) {
+            throw std::runtime_error("not a term corpus");
+        }
+        std::uint32_t version = 0;
+        for (int i = 3; i >= 0; --i) {
+            version = (version << 8) | static_cast<std::uint32_t>(data_[4 + i]);
+        }
+        if (version != TermCodec::version) {
+            throw std::runtime_error("unsupported term corpus version " + std::to_string(version));
+        }
+        roots_ = static_cast<std::size_t>(TermCodec::get_u64(data_.data() + 8));
+        entries_ = static_cast<std::size_t>(TermCodec::get_u64(data_.data() + 16));
+        if (roots_ + entries_ < roots_ || (data_.size() - TermCodec::header_bytes) / 8 < roots_ + entries_) {
+            throw std::runtime_error("term corpus offset table runs past the end of the file");
+        }
+    }
+
+    MappedFile file_;
+    std::span<const std::byte> data_;
+    std::size_t roots_ = 0;
+    std::size_t entries_ = 0;
+};
+
+/// Visit every node of a term in pre-order, expanding shared entries at each occurrence
+template <typename Visitor>
+void visit(const TermCursor& root, Visitor&& visitor) {
+    std::vector<TermCursor> stack{root};
+    while (!stack.empty()) {
+        const TermCursor cursor = stack.back();
+        stack.pop_back();
+        visitor(cursor);
+        if (cursor.kind() == TermKind::Abs) {
+            stack.push_back(cursor.body());
+        }
+        else if (cursor.kind() == TermKind::App) {
+            stack.push_back(cursor.arg());
+            stack.push_back(cursor.func());
+        }
+    }
+}
+
+/// Value of a Church numeral in normal form, read in place; nullopt for any other term
+inline auto church_value(const TermCursor& term) -> std::optional<std::size_t> {
+    if (term.kind() != TermKind::Abs || term.body().kind() != TermKind::Abs) {
+        return std::nullopt;
+    }
+    std::size_t n = 0;
+    for (TermCursor at = term.body().body();; at = at.arg(), ++n) {
+        if (at.kind() == TermKind::Var) {
+            return at.index() == 0 ? std::optional<std::size_t>(n) : std::nullopt;
+        }
+        if (at.kind() != TermKind::App || at.func().kind() != TermKind::Var || at.func().index() != 1) {
+            return std::nullopt;
+        }
+    }
+}
+
+/// Build a runtime graph of a stored term, for example to reduce it; shared entries become shared nodes
+class TermLoader {
+public:
+    explicit TermLoader(TermGraph& graph) : graph_(graph) {}
+
+    /// Built with an explicit stack, so the depth of a stored term is not limited by the call stack
+    auto load(const TermCursor& term) -> const TermNode* {
+        struct Frame {
+            TermCursor cursor;
+            bool children_built;
+        };
+        std::vector<Frame> stack{{term, false}};
+        std::vector<const TermNode*> built;
+        while (!stack.empty()) {
+            const Frame frame = stack.back();
+            stack.pop_back();
+            const TermCursor& cursor = frame.cursor;
+            if (!frame.children_built) {
+                if (cursor.entry()) {
+                    if (auto it = entries_.find(*cursor.entry()); it != entries_.end()) {
+                        built.push_back(it->second);
+                        continue;
+                    }
+                }
+                if (cursor.kind() == TermKind::Var) {
+                    finish(cursor, graph_.var(cursor.index()), built);
+                    continue;
+                }
+                stack.push_back({cursor, true});
+                if (cursor.kind() == TermKind::Abs) {
+                    stack.push_back({cursor.body(), false});
+                }
+                else {
+                    stack.push_back({cursor.arg(), false});
+                    stack.push_back({cursor.func(), false});
+                }
+                continue;
+            }
+            if (cursor.kind() == TermKind::Abs) {
+                const TermNode* body = built.back();
+                built.pop_back();
+                finish(cursor, graph_.abs(body), built);
+            }
+            else {
+                const TermNode* arg = built.back();
+                built.pop_back();
+                const TermNode* func = built.back();
+                built.pop_back();
+                finish(cursor, graph_.app(func, arg), built);
+            }
+        }
+        return built.back();
+    }
+
+private:
+    void finish(const TermCursor& cursor, const TermNode* node, std::vector<const TermNode*>& built) {
+        if (cursor.entry()) {
+            entries_.emplace(*cursor.entry(), node);
+        }
+        built.push_back(node);
+    }
+
+    TermGraph& graph_;
+    std::unordered_map<std::size_t, const TermNode*> entries_;
+};
+
+} // namespace typical
@@ -0,0 +1,187 @@
+module;
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+
+export module typical.solve;
+
+import typical.calculus;
+
+export namespace typical {
+
+// Root finding
+// ----------------
+//
+// Newton and Halley iteration for f(x) = 0 with f an Expression type. The
+// first and second derivatives are derived at compile time, and f, f' and
+// f'' are evaluated in one pass over their joint nodes, so subexpressions
+// they share are computed once per iteration.
+
+/// Iteration used by the root finder
+enum class RootMethod {
+    /// x - f / f', quadratic convergence
+    Newton,
+    /// x - (f / f') / (1 - f f'' / 2f'^2), cubic convergence; falls back to the Newton step where the
+    /// denominator drops below 1/2, which is where Halley overshoots near an inflection point
+    Halley,
+};
+
+/// Root finder settings
+struct SolveOptions {
+    /// A lane has converged once |step| <= tolerance * (1 + |x|), or f(x) is exactly 0
+    double tolerance = 1e-12;
+    /// Iterations before a lane is given up
+    std::size_t max_iterations = 50;
+};
+
+/// Outcome for a single starting point
+struct Root {
+    double x = 0.0;
+    std::size_t iterations = 0;
+    bool converged = false;
+};
+
+/// Batched root finding statistics
+struct SolveStats {
+    std::size_t points = 0;
+    std::size_t converged = 0;
+    /// Iterations summed over all points
+    std::size_t iterations = 0;
+    /// Iterations of the slowest point
+    std::size_t max_iterations = 0;
+    double seconds = 0.0;
+    double points_per_second = 0.0;
+};
+
+/// One iteration step of Method for E
+template <Expression E, RootMethod Method, AccuracyPolicy Accuracy = accuracy::Libm>
+struct RootStep {
+protected:
+    using F = plan_t<E>;
+    using D1 = plan_t<derive_t<E>>;
+    using D2 = plan_t<derive_t<derive_t<E>>>;
+
+    using Pass = std::conditional_t<Method == RootMethod::Newton, EvalPass<joint_nodes_t<F, D1>, Accuracy>,
+                                    EvalPass<joint_nodes_t<F, D1, D2>, Accuracy>>;
+
+public:
+    /// Correction to subtract from x; f(x) = 0 gives 0
+    static constexpr auto step(double x) -> double {
+        if constexpr (Method == RootMethod::Newton) {
+            const auto [f, d1] = Pass::template values<F, D1>(x);
+            return approx::select(f == 0.0, 0.0, f / d1);
+        }
+        else {
+            const auto [f, d1, d2] = Pass::template values<F, D1, D2>(x);
+            // Written around the Newton step so that f' = 0 gives a non-finite step, as it does for Newton
+            const double newton = f / d1;
+            const double factor = 1.0 - 0.5 * newton * d2 / d1;
+            return approx::select(f == 0.0, 0.0, approx::select(factor >= 0.5, newton / factor, newton));
+        }
+    }
+};
+
+/// |x|, usable in constant expressions
+constexpr auto magnitude(double x) -> double {
+    return x < 0.0 ? -x : x;
+}
+
+/// Iterate Method from x0 until the step is below tolerance, x leaves the finite doubles or max_iterations
+/// is reached
+template <Expression E, RootMethod Method = RootMethod::Newton, AccuracyPolicy Accuracy = accuracy::Libm>
+constexpr auto find_root(double x0, SolveOptions options = {}) -> Root {
+    Root root{x0, 0, false};
+    while (root.iterations < options.max_iterations) {
+        const double step = RootStep<E, Method, Accuracy>::step(root.x);
+        root.x -= step;
+        ++root.iterations;
+        if (!(magnitude(root.x) <= std::numeric_limits<double>::max())) {
+            break;
+        }
+        if (magnitude(step) <= options.tolerance * (1.0 + magnitude(root.x))) {
+            root.converged = true;
+            break;
+        }
+    }
+    return root;
+}
+
+/// Starting points iterated together
+inline constexpr std::size_t solve_block = 256;
+
+/// Find a root from every starting point; roots needs starts.size() entries and receives NaN where a
+/// point did not converge.
+///
+/// Starting points are taken solve_block at a time. Every iteration runs the
+/// step over all live lanes of the block in one loop with no data-dependent
+/// branches, which the compiler vectorizes when the Accuracy policy has no
+/// calls. Each lane then gets its own convergence mask, and a compaction
+/// moves the live lanes to the front, so finished lanes cost nothing in
+/// later iterations.
+template <Expression E, RootMethod Method = RootMethod::Newton, AccuracyPolicy Accuracy = accuracy::Libm>
+auto find_roots(std::span<const double> starts, std::span<double> roots, SolveOptions options = {})
+    -> SolveStats {
+    const auto start = std::chrono::steady_clock::now();
+    SolveStats stats;
+    stats.points = starts.size();
+
+    std::array<double, solve_block> x{};
+    std::array<double, solve_block> step{};
+    std::array<std::uint32_t, solve_block> lane{};
+    std::array<std::uint8_t, solve_block> done{};
+    std::array<std::uint8_t, solve_block> converged{};
+
+    for (std::size_t base = 0; base < starts.size(); base += solve_block) {
+        std::size_t live = std::min(solve_block, starts.size() - base);
+        for (std::size_t k = 0; k < live; ++k) {
+            x[k] = starts[base + k];
+            lane[k] = static_cast<std::uint32_t>(k);
+        }
+        for (std::size_t iteration = 1; live != 0 && iteration <= options.max_iterations; ++iteration) {
+            for (std::size_t k = 0; k < live; ++k) {
+                step[k] = RootStep<E, Method, Accuracy>::step(x[k]);
+            }
+            for (std::size_t k = 0; k < live; ++k) {
+                x[k] -= step[k];
+                const bool ok = std::abs(step[k]) <= options.tolerance * (1.0 + std::abs(x[k]));
+                // NaN fails both tests, so a lane that left the finite doubles is done without converging
+                const bool escaped = !(std::abs(x[k]) <= std::numeric_limits<double>::max());
+                converged[k] = static_cast<std::uint8_t>(ok && !escaped);
+                done[k] = static_cast<std::uint8_t>(ok || escaped || iteration >= options.max_iterations);
+            }
+            // Finished lanes are written out; live lanes move to the front with the cursor advanced by their mask
+            std::size_t kept = 0;
+            for (std::size_t k = 0; k < live; ++k) {
+                if (done[k] != 0) {
+                    roots[base + lane[k]] = converged[k] != 0 ? x[k] : std::numeric_limits<double>::quiet_NaN();
+                    stats.converged += converged[k];
+                    stats.iterations += iteration;
+                    stats.max_iterations = std::max(stats.max_iterations, iteration);
+                }
+                x[kept] = x[k];
+                lane[kept] = lane[k];
+                kept += static_cast<std::size_t>(done[k] == 0);
+            }
+            live = kept;
+        }
+        // Lanes left only when max_iterations is 0; as in find_root, no step runs and nothing converges
+        for (std::size_t k = 0; k < live; ++k) {
+            roots[base + lane[k]] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (stats.seconds > 0.0) {
+        stats.points_per_second = static_cast<double>(stats.points) / stats.seconds;
+    }
+    return stats;
+}
+
+} // namespace typical
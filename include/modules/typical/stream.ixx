@@ -0,0 +1,124 @@
+module;
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+
+
+export module typical.stream;
+
+export import typical.mapped;
+import typical.calculus;
+import typical.pool;
+
+export namespace typical {
+
+// Streaming evaluation
+// ----------------
+
+/// Streaming evaluation settings
+struct StreamOptions {
+    /// Bytes of input per task; the default keeps a chunk and its output in L2
+    std::size_t chunk_bytes = 256 * 1024;
+    /// Worker threads, 0 for one per hardware thread
+    std::size_t threads = 0;
+};
+
+/// Streaming evaluation statistics
+struct StreamStats {
+    std::size_t samples = 0;
+    std::size_t chunks = 0;
+    std::size_t threads = 0;
+    double seconds = 0.0;
+    /// Input plus output bytes per second, in units of 10^9
+    double gigabytes_per_second = 0.0;
+};
+
+/// Decode a little-endian double
+inline auto load_le(const std::byte* p) -> double {
+    std::uint64_t bits = 0;
+    for (int i = 7; i >= 0; --i) {
+        bits = (bits << 8) | static_cast<std::uint64_t>(p[i]);
+    }
+    return std::bit_cast<double>(bits);
+}
+
+/// Encode a little-endian double
+inline void store_le(std::byte* p, double value) {
+    auto bits = std::bit_cast<std::uint64_t>(value);
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<std::byte>(bits & 0xff);
+        bits >>= 8;
+    }
+}
+
+/// Evaluate Expr over samples [begin, end) of a mapped column, writing into a mapped output column
+template <Expression Expr, AccuracyPolicy Accuracy = accuracy::Libm>
+void evaluate_column(const std::byte* in, std::byte* out, std::size_t begin, std::size_t end) {
+    if constexpr (std::endian::native == std::endian::little) {
+        const auto* x = reinterpret_cast<const double*>(in);
+        auto* y = reinterpret_cast<double*>(out);
+        for (std::size_t i = begin; i < end; ++i) {
+            y[i] = evaluate<Expr, Accuracy>(x[i]);
+        }
+    }
+    else {
+        for (std::size_t i = begin; i < end; ++i) {
+            store_le(out + i * sizeof(double), evaluate<Expr, Accuracy>(load_le(in + i * sizeof(double))));
+        }
+    }
+}
+
+/// Evaluate Expr over a raw little-endian double column on a pool, writing to a mapped output file other than the
+/// input
+template <Expression Expr, AccuracyPolicy Accuracy = accuracy::Libm>
+auto stream_evaluate(const std::filesystem::path& input, const std::filesystem::path& output,
+                     WorkStealingPool& pool, StreamOptions options = {}) -> StreamStats {
+    const auto start = std::chrono::steady_clock::now();
+
+    // Creating the output truncates it, which would pull the mapped input out from under the workers
+    if (std::filesystem::exists(output) && std::filesystem::equivalent(input, output)) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                "output is the input column: " + output.string());
+    }
+    auto in = MappedFile::open_read(input);
+    if (in.size() % sizeof(double) != 0) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                "column size is not a multiple of 8: " + input.string());
+    }
+    in.advise_sequential();
+    auto out = MappedFile::create(output, in.size());
+
+    const std::size_t samples = in.size() / sizeof(double);
+    const std::size_t grain = std::max<std::size_t>(options.chunk_bytes / sizeof(double), 1);
+    const std::byte* source = in.data();
+    std::byte* target = out.data();
+
+    pool.parallel_for(0, samples, grain, [source, target](std::size_t begin, std::size_t end) {
+        evaluate_column<Expr, Accuracy>(source, target, begin, end);
+    });
+
+    StreamStats stats;
+    stats.samples = samples;
+    stats.chunks = (samples + grain - 1) / grain;
+    stats.threads = pool.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (stats.seconds > 0.0) {
+        stats.gigabytes_per_second = 2.0 * static_cast<double>(in.size()) / stats.seconds / 1e9;
+    }
+    return stats;
+}
+
+/// Evaluate Expr over a column file on a pool sized by options.threads
+template <Expression Expr, AccuracyPolicy Accuracy = accuracy::Libm>
+auto stream_evaluate(const std::filesystem::path& input, const std::filesystem::path& output,
+                     StreamOptions options = {}) -> StreamStats {
+    WorkStealingPool pool(options.threads != 0 ? options.threads : std::thread::hardware_concurrency());
+    return stream_evaluate<Expr, Accuracy>(input, output, pool, options);
+}
+
+} // namespace typical
@@ -0,0 +1,185 @@
+module;
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+export module typical.vec;
+
+import typical.eq;
+import typical.nat;
+import typical.fin;
+
+export namespace typical {
+
+// Length-indexed vectors
+// ----------------
+
+template <typename T, nat::Nat N>
+class Vec;
+
+template <typename T, nat::Nat N, nat::Nat M>
+auto append(Vec<T, N> left, Vec<T, M> right) -> Vec<T, nat::add_t<N, M>>;
+
+template <nat::Nat K, typename T, nat::Nat N>
+    requires nat::less_or_equal_v<K, N>
+auto split_at(Vec<T, N> vec) -> std::pair<Vec<T, K>, Vec<T, nat::sub_t<N, K>>>;
+
+template <typename T, typename U, nat::Nat N>
+auto zip(Vec<T, N> left, Vec<U, N> right) -> Vec<std::pair<T, U>, N>;
+
+template <typename T, nat::Nat N, nat::Nat M>
+auto concat(Vec<Vec<T, M>, N> rows) -> Vec<T, nat::mul_t<N, M>>;
+
+/// A heap vector holding exactly nat::to_value_v<N> elements.
+///
+/// The length is part of the type, so append, zip, split_at and concat
+/// compute their result lengths with add_t, sub_t and mul_t and never check
+/// sizes at runtime. Moving a Vec, and transporting it along an Eq proof to
+/// another length type, moves the buffer without touching the elements. As
+/// with the standard containers, a moved-from or released Vec may only be
+/// destroyed or assigned to.
+template <typename T, nat::Nat N>
+class Vec {
+public:
+    using value_type = T;
+    using length = N;
+
+    /// Length of every Vec<T, N>
+    static constexpr size_t extent = Fin<N>::bound;
+
+    /// The same element type at another length, for Transport
+    template <typename M>
+    using with_length = Vec<T, M>;
+
+    /// Default-constructed elements
+    Vec() : elements_(extent) {}
+
+    /// Copies of one value
+    explicit Vec(const T& value) : elements_(extent, value) {}
+
+    Vec(const Vec&) = default;
+    Vec& operator=(const Vec&) = default;
+    Vec(Vec&&) noexcept = default;
+    Vec& operator=(Vec&&) noexcept = default;
+
+    /// Element i is f(i)
+    template <typename F>
+        requires std::is_invocable_r_v<T, F&, Fin<N>>
+    static auto generate(F&& f) -> Vec {
+        std::vector<T> elements;
+        elements.reserve(extent);
+        for (const Fin<N> i : fin_range<N>()) {
+            elements.push_back(f(i));
+        }
+        return Vec(std::move(elements));
+    }
+
+    /// Take over a std::vector, empty if its length is not the extent
+    static auto check(std::vector<T> elements) -> std::optional<Vec> {
+        if (elements.size() != extent) {
+            return std::nullopt;
+        }
+        return Vec(std::move(elements));
+    }
+
+    auto operator[](Fin<N> i) -> T& { return elements_[i.value()]; }
+    auto operator[](Fin<N> i) const -> const T& { return elements_[i.value()]; }
+
+    static constexpr auto size() -> size_t { return extent; }
+    auto data() -> T* { return elements_.data(); }
+    auto data() const -> const T* { return elements_.data(); }
+    auto begin() { return elements_.begin(); }
+    auto begin() const { return elements_.begin(); }
+    auto end() { return elements_.end(); }
+    auto end() const { return elements_.end(); }
+
+    /// Fixed-extent view of the elements
+    auto view() -> FinSpan<T, N> { return FinSpan<T, N>(std::span<T, extent>(elements_.data(), extent)); }
+    auto view() const -> FinSpan<const T, N> {
+        return FinSpan<const T, N>(std::span<const T, extent>(elements_.data(), extent));
+    }
+
+    /// Give up the buffer as a std::vector
+    auto release() && -> std::vector<T> { return std::move(elements_); }
+
+    /// The same buffer under a length M proved equal to N
+    template <nat::Nat M, typename Proof>
+        requires ProvablyEqual<N, M> && std::is_same_v<Proof, eq_proof<N, M>>
+    auto transport() && -> Vec<T, M> {
+        return Transport<N, M, with_length, Proof>::apply(std::move(*this));
+    }
+
+    auto operator==(const Vec&) const -> bool = default;
+
+private:
+    template <typename U, nat::Nat M>
+    friend class Vec;
+
+    template <typename U, nat::Nat A, nat::Nat B>
+    friend auto append(Vec<U, A> left, Vec<U, B> right) -> Vec<U, nat::add_t<A, B>>;
+
+    template <nat::Nat K, typename U, nat::Nat A>
+        requires nat::less_or_equal_v<K, A>
+    friend auto split_at(Vec<U, A> vec) -> std::pair<Vec<U, K>, Vec<U, nat::sub_t<A, K>>>;
+
+    template <typename U, typename V, nat::Nat A>
+    friend auto zip(Vec<U, A> left, Vec<V, A> right) -> Vec<std::pair<U, V>, A>;
+
+    template <typename U, nat::Nat A, nat::Nat B>
+    friend auto concat(Vec<Vec<U, B>, A> rows) -> Vec<U, nat::mul_t<A, B>>;
+
+    /// Adopt a buffer whose length the caller has established
+    explicit Vec(std::vector<T> elements) : elements_(std::move(elements)) {}
+
+    std::vector<T> elements_;
+};
+
+/// Elements of left then right, moved into the buffer of left (which grows if it has no room)
+template <typename T, nat::Nat N, nat::Nat M>
+auto append(Vec<T, N> left, Vec<T, M> right) -> Vec<T, nat::add_t<N, M>> {
+    std::vector<T> elements = std::move(left).release();
+    elements.insert(elements.end(), std::make_move_iterator(right.elements_.begin()),
+                    std::make_move_iterator(right.elements_.end()));
+    return Vec<T, nat::add_t<N, M>>(std::move(elements));
+}
+
+/// The first K elements and the rest, reusing the buffer of vec for the first part
+template <nat::Nat K, typename T, nat::Nat N>
+    requires nat::less_or_equal_v<K, N>
+auto split_at(Vec<T, N> vec) -> std::pair<Vec<T, K>, Vec<T, nat::sub_t<N, K>>> {
+    std::vector<T> front = std::move(vec).release();
+    const auto cut = front.begin() + static_cast<std::ptrdiff_t>(nat::to_value_v<K>);
+    std::vector<T> back(std::make_move_iterator(cut), std::make_move_iterator(front.end()));
+    front.erase(cut, front.end());
+    return {Vec<T, K>(std::move(front)), Vec<T, nat::sub_t<N, K>>(std::move(back))};
+}
+
+/// Pairs of corresponding elements; both sides have length N by type
+template <typename T, typename U, nat::Nat N>
+auto zip(Vec<T, N> left, Vec<U, N> right) -> Vec<std::pair<T, U>, N> {
+    std::vector<std::pair<T, U>> elements;
+    elements.reserve(Vec<T, N>::extent);
+    for (size_t i = 0; i < Vec<T, N>::extent; ++i) {
+        elements.emplace_back(std::move(left.elements_[i]), std::move(right.elements_[i]));
+    }
+    return Vec<std::pair<T, U>, N>(std::move(elements));
+}
+
+/// N rows of M elements, row after row
+template <typename T, nat::Nat N, nat::Nat M>
+auto concat(Vec<Vec<T, M>, N> rows) -> Vec<T, nat::mul_t<N, M>> {
+    std::vector<T> elements;
+    elements.reserve(Vec<T, N>::extent * Vec<T, M>::extent);
+    for (auto& row : rows.elements_) {
+        std::vector<T> cells = std::move(row).release();
+        elements.insert(elements.end(), std::make_move_iterator(cells.begin()), std::make_move_iterator(cells.end()));
+    }
+    return Vec<T, nat::mul_t<N, M>>(std::move(elements));
+}
+
+} // namespace typical
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+import typical.calculus;
+import typical.bytecode;
+
+using namespace typical;
+
+// ============================================================================
+// Test Compile-Time Kernels
+// ============================================================================
+
+static_assert(approx::exp<14>(0.0) == 1.0, "exp 0");
+static_assert(approx::log<9>(1.0) == 0.0, "log 1");
+static_assert(approx::sqrt<3>(9.0) == 3.0, "sqrt 9");
+static_assert(approx::sin<9, 9>(0.0) == 0.0 && approx::cos<9, 9>(0.0) == 1.0, "sin 0 and cos 0");
+static_assert(approx::sin_coefficients<9>.size() == 8 && approx::sin_coefficients<9>[0] == -1.0 / 6.0,
+              "sin series in r^2 after the linear term");
+static_assert(evaluate<Exp<X>, accuracy::Ulp>(0.0) == 1.0, "Approximate evaluation is constant-evaluable");
+static_assert(evaluate<Add<Sqrt<X>, Log<X>>, accuracy::Ulp>(1.0) == 1.0, "sqrt 1 + log 1");
+static_assert(AccuracyPolicy<accuracy::Libm> && AccuracyPolicy<accuracy::Fast> && !AccuracyPolicy<float>,
+              "Only policies pass as the accuracy argument");
+
+namespace {
+
+// ============================================================================
+// Accuracy Sweeps Against libm
+// ============================================================================
+
+constexpr std::size_t samples = 200001;
+
+bool near(double a, double b, double tolerance) {
+    return std::fabs(a - b) <= tolerance * (1.0 + std::fabs(b));
+}
+
+struct Domain {
+    double lo;
+    double hi;
+};
+
+template <typename Kernel, typename Reference>
+auto sweep(Kernel kernel, Reference reference, std::initializer_list<Domain> domains) -> KernelError {
+    KernelError worst;
+    for (const auto& d : domains) {
+        const KernelError e = measure_error(kernel, reference, d.lo, d.hi, samples);
+        if (e.max_ulp > worst.max_ulp) {
+            worst.max_ulp = e.max_ulp;
+            worst.worst = e.worst;
+        }
+        worst.max_relative = std::max(worst.max_relative, e.max_relative);
+    }
+    return worst;
+}
+
+// Domains whose results are normal doubles, so relative error is meaningful
+template <typename Policy>
+auto sweep_all() -> std::vector<KernelError> {
+    const std::initializer_list<Domain> trig = {{-4.0, 4.0}, {-1e5, 1e5}, {1e-300, 1e-3}};
+    return {
+        sweep([](double x) { return Policy::sin(x); }, [](double x) { return std::sin(x); }, trig),
+        sweep([](double x) { return Policy::cos(x); }, [](double x) { return std::cos(x); }, trig),
+        sweep([](double x) { return Policy::tan(x); }, [](double x) { return std::tan(x); }, trig),
+        sweep([](double x) { return Policy::exp(x); }, [](double x) { return std::exp(x); },
+              {{-1.0, 1.0}, {-708.0, 709.7}}),
+        sweep([](double x) { return Policy::log(x); }, [](double x) { return std::log(x); },
+              {{0.5, 2.0}, {1e-3, 1e3}, {1e-310, 1e-300}, {1e300, 1.7e308}}),
+        sweep([](double x) { return Policy::sqrt(x); }, [](double x) { return std::sqrt(x); },
+              {{0.0, 4.0}, {0.0, 1e-300}, {1e300, 1.7e308}}),
+    };
+}
+
+bool test_ulp_policy() {
+    // sin, cos, tan, exp, log, sqrt
+    const double bounds[] = {2.0, 2.0, 4.0, 1.0, 1.0, 1.0};
+    const auto errors = sweep_all<accuracy::Ulp>();
+    for (std::size_t k = 0; k < errors.size(); ++k) {
+        if (errors[k].max_ulp > bounds[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_fast_policy() {
+    for (const auto& e : sweep_all<accuracy::Fast>()) {
+        if (e.max_relative > 1e-6) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Test Special Inputs
+// ============================================================================
+
+template <typename Policy>
+bool test_special_inputs() {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    auto same = [](double a, double b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+    for (double x : {0.0, -0.0, inf, -inf, nan, -1.0}) {
+        if (!same(Policy::log(x), std::log(x)) || !same(Policy::sqrt(x), std::sqrt(x))) {
+            return false;
+        }
+    }
+    for (double x : {0.0, inf, -inf, nan, 710.0, -746.0}) {
+        if (!same(Policy::exp(x), std::exp(x))) {
+            return false;
+        }
+    }
+    // Past 2^20 π/2 the reduction is no longer exact, so the trigonometric kernels give NaN instead of a wrong value
+    for (double x : {inf, -inf, nan, approx::trig_limit, -1e7, 0x1p52, 1e300}) {
+        if (!std::isnan(Policy::sin(x)) || !std::isnan(Policy::cos(x)) || !std::isnan(Policy::tan(x))) {
+            return false;
+        }
+    }
+    const double edge = std::nextafter(approx::trig_limit, 0.0);
+    if (!near(Policy::sin(edge), std::sin(edge), 1e-6) || !near(Policy::cos(-edge), std::cos(-edge), 1e-6)) {
+        return false;
+    }
+    // Subnormal inputs and results
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    return std::fabs(Policy::log(tiny) / std::log(tiny) - 1.0) < 1e-6 &&
+           std::fabs(Policy::sqrt(tiny) / std::sqrt(tiny) - 1.0) < 1e-6 && Policy::exp(-740.0) > 0.0 &&
+           Policy::exp(-740.0) < std::numeric_limits<double>::min();
+}
+
+bool test_ulp_distance() {
+    return ulp_distance(1.0, std::nextafter(1.0, 2.0)) == 1.0 && ulp_distance(0.0, -0.0) == 0.0 &&
+           ulp_distance(-std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::denorm_min()) == 2.0 &&
+           std::isinf(ulp_distance(1.0, std::numeric_limits<double>::quiet_NaN()));
+}
+
+// ============================================================================
+// Test Evaluation Under a Policy
+// ============================================================================
+
+using F = Add<Mul<Sin<X>, Exp<Neg<X>>>, Div<Log<Add<X, C_<2>>>, Sqrt<Add<Cos<X>, C_<2>>>>>;
+
+bool test_evaluate() {
+    for (double x = -1.5; x < 3.0; x += 0.013) {
+        const double exact = evaluate<F>(x);
+        const auto d = value_and_derivative<F>(x);
+        const auto fast = value_and_derivative<F, accuracy::Fast>(x);
+        if (!near(evaluate<F, accuracy::Ulp>(x), exact, 1e-14) || !near(fast.value, exact, 1e-5) ||
+            !near(fast.derivative, d.derivative, 1e-5)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_program() {
+    const Program program = compile<F>();
+    std::vector<double> xs;
+    for (double x = -1.5; x < 3.0; x += 0.0013) {
+        xs.push_back(x);
+    }
+    std::vector<double> exact(xs.size());
+    std::vector<double> ulp(xs.size());
+    std::vector<double> fast(xs.size());
+    program.evaluate(xs, exact);
+    program.evaluate<accuracy::Ulp>(xs, ulp);
+    program.evaluate<accuracy::Fast>(xs, fast);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        if (!near(ulp[i], exact[i], 1e-14) || !near(fast[i], exact[i], 1e-5)) {
+            return false;
+        }
+    }
+    return program.evaluate<accuracy::Fast>(xs[7]) == fast[7];
+}
+
+} // namespace
+
+int main() {
+    if (!test_ulp_policy() || !test_fast_policy()) {
+        return 1;
+    }
+    if (!test_special_inputs<accuracy::Ulp>() || !test_special_inputs<accuracy::Fast>() || !test_ulp_distance()) {
+        return 1;
+    }
+    if (!test_evaluate() || !test_program()) {
+        return 1;
+    }
+    return 0;
+}
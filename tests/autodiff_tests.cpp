@@ -0,0 +1,125 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+import typical.calculus;
+import typical.autodiff;
+
+using namespace typical;
+
+// ============================================================================
+// Test Indexed Variables
+// ============================================================================
+
+static_assert(Expression<X_<0>>, "Indexed variables should be expressions");
+static_assert(!is_constant_v<Mul<C_<2>, X_<3>>>, "Indexed variables are not constant");
+static_assert(arity_v<Add<X_<0>, Mul<X_<2>, Sin<X_<1>>>>> == 3, "Arity is one more than the largest index");
+static_assert(arity_v<Sin<C_<1>>> == 0, "Constants take no variables");
+static_assert(std::is_same_v<simplify_t<Add<X_<1>, X_<0>>>, Add<X_<0>, X_<1>>>, "Indexed variables sort by index");
+static_assert(std::is_same_v<simplify_t<Add<X_<1>, X_<1>>>, Mul<C_<2>, X_<1>>>, "Equal variables still combine");
+static_assert(std::is_same_v<derive_t<Mul<X, X_<0>>>, X_<0>>, "Indexed variables are constant with respect to X");
+
+// ============================================================================
+// Test Tape Layout
+// ============================================================================
+
+// Only products, quotients and functions record partials
+static_assert(GradientTape<Add<X_<0>, Neg<X_<1>>>>::partials == 0, "Sums record nothing");
+static_assert(GradientTape<Mul<X_<0>, X_<1>>>::partials == 2, "A product records both partials");
+static_assert(GradientTape<Sin<Mul<X_<0>, X_<1>>>>::partials == 3, "A function records one");
+static_assert(GradientTape<Mul<Sin<X_<0>>, X_<1>>>::arity == 2, "Tape arity");
+static_assert(sizeof(GradientTape<Mul<X_<0>, X_<1>>>) == 8 * sizeof(double), "Values, partials and adjoints only");
+
+// ============================================================================
+// Test Gradients
+// ============================================================================
+
+using Bilinear = Add<Mul<X_<0>, X_<1>>, Mul<C_<3>, X_<2>>>;
+
+static_assert(value_and_gradient<Bilinear>(std::array{2.0, 5.0, 7.0}).value == 31.0, "xy + 3z at (2, 5, 7)");
+static_assert(value_and_gradient<Bilinear>(std::array{2.0, 5.0, 7.0}).gradient[0] == 5.0, "d/dx (xy + 3z) = y");
+static_assert(value_and_gradient<Bilinear>(std::array{2.0, 5.0, 7.0}).gradient[1] == 2.0, "d/dy (xy + 3z) = x");
+static_assert(value_and_gradient<Bilinear>(std::array{2.0, 5.0, 7.0}).gradient[2] == 3.0, "d/dz (xy + 3z) = 3");
+
+// Repeated variables accumulate adjoints
+static_assert(value_and_gradient<Pow<X_<0>, 3>>(std::array{2.0}).gradient[0] == 12.0, "d/dx x^3 at 2");
+static_assert(value_and_gradient<Div<X_<0>, X_<1>>>(std::array{3.0, 2.0}).gradient[1] == -0.75,
+              "d/dy x / y at (3, 2)");
+
+// Variables simplified away have a zero gradient
+static_assert(value_and_gradient<Add<X_<0>, Mul<C_<0>, X_<1>>>>(std::array{1.0, 4.0}).gradient[1] == 0.0,
+              "0 * y contributes nothing");
+
+namespace {
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-12 * (1.0 + std::fabs(b)); }
+
+// f(a, b, c) = a sin(b c) + exp(a / c) - sqrt(b)^3
+using Model = Sub<Add<Mul<X_<0>, Sin<Mul<X_<1>, X_<2>>>>, Exp<Div<X_<0>, X_<2>>>>, Pow<X_<1>, 1.5>>;
+
+auto model(double a, double b, double c) -> double {
+    return a * std::sin(b * c) + std::exp(a / c) - std::pow(b, 1.5);
+}
+
+auto model_gradient(double a, double b, double c) -> std::array<double, 3> {
+    return {std::sin(b * c) + std::exp(a / c) / c, a * c * std::cos(b * c) - 1.5 * std::sqrt(b),
+            a * b * std::cos(b * c) - a * std::exp(a / c) / (c * c)};
+}
+
+bool test_gradient() {
+    const auto r = value_and_gradient<Model>(std::array{0.7, 1.3, 2.1});
+    const auto g = model_gradient(0.7, 1.3, 2.1);
+    return near(r.value, model(0.7, 1.3, 2.1)) && near(r.gradient[0], g[0]) && near(r.gradient[1], g[1]) &&
+           near(r.gradient[2], g[2]);
+}
+
+bool test_batch() {
+    GradientTape<Model> tape;
+    const std::size_t count = 100;
+    std::vector<double> points(count * 3);
+    for (std::size_t i = 0; i < count; ++i) {
+        points[i * 3] = 0.01 * static_cast<double>(i);
+        points[i * 3 + 1] = 0.5 + 0.02 * static_cast<double>(i);
+        points[i * 3 + 2] = 1.0 + 0.03 * static_cast<double>(i);
+    }
+    std::vector<double> values(count);
+    std::vector<double> gradients(count * 3);
+    tape.gradient_batch(points, values, gradients);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double* p = &points[i * 3];
+        const auto g = model_gradient(p[0], p[1], p[2]);
+        if (!near(values[i], model(p[0], p[1], p[2]))) {
+            return false;
+        }
+        for (std::size_t k = 0; k < 3; ++k) {
+            if (!near(gradients[i * 3 + k], g[k])) {
+                return false;
+            }
+        }
+    }
+
+    // Spans too short for values.size() points are rejected before anything is read or written
+    for (const auto& [p, g] : {std::pair{count * 3 - 1, count * 3}, std::pair{count * 3, count * 3 - 1}}) {
+        try {
+            tape.gradient_batch(std::span<const double>(points).first(p), values, std::span<double>(gradients).first(g));
+            return false;
+        }
+        catch (const std::invalid_argument&) {
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    if (!test_gradient() || !test_batch()) {
+        return 1;
+    }
+    return 0;
+}
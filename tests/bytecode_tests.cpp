@@ -0,0 +1,226 @@
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+import typical.calculus;
+import typical.bytecode;
+
+using namespace typical;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+bool near(double a, double b) { return std::fabs(a - b) <= 1e-12 * (1.0 + std::fabs(b)); }
+
+template <typename E>
+bool matches_compile_time(const Program& program) {
+    for (double x = 0.05; x < 3.0; x += 0.17) {
+        if (!near(program.evaluate(x), evaluate<E>(x))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename E>
+bool lowers_exactly() {
+    return matches_compile_time<E>(compile<E>());
+}
+
+// ============================================================================
+// Test Graph Construction
+// ============================================================================
+
+bool test_graph() {
+    ExprGraph g;
+    const auto x = g.var();
+    const auto a = g.sin(x);
+    const auto b = g.sin(g.var());
+    // Structurally equal nodes are shared and ids are topological
+    return a == b && x < a && g.size() == 2;
+}
+
+// ============================================================================
+// Test Lowering from Compile-Time Expressions
+// ============================================================================
+
+bool test_lowering() {
+    return lowers_exactly<X>() && lowers_exactly<Add<Sin<X>, C_<2>>>() &&
+           lowers_exactly<Div<Sub<Pow<X, 3>, C_<1>>, Add<X, C_<2>>>>() &&
+           lowers_exactly<Mul<Exp<Neg<X>>, Cos<Mul<C_<3>, X>>>>() && lowers_exactly<Add<Tan<Sqrt<X>>, Log<X>>>() &&
+           lowers_exactly<Pow<X, -2>>() && lowers_exactly<Pow<X, 0.5>>() &&
+           lowers_exactly<Sub<C_<1>, Div<C_<2>, X>>>() && lowers_exactly<derive_t<Mul<Sin<X>, Exp<Sin<X>>>>>();
+}
+
+// ============================================================================
+// Test Parsing
+// ============================================================================
+
+bool test_parser() {
+    const auto p = compile("sin(x)^2 + 2 * exp(-x / 3) - 1.5e-1");
+    for (double x = -2.0; x < 2.0; x += 0.3) {
+        const double expected = std::pow(std::sin(x), 2) + 2.0 * std::exp(-x / 3.0) - 0.15;
+        if (!near(p.evaluate(x), expected)) {
+            return false;
+        }
+    }
+    if (!near(compile("-x^2").evaluate(3.0), -9.0) || !near(compile("x^-1").evaluate(4.0), 0.25) ||
+        !near(compile("2 - 3 - 4").evaluate(0.0), -5.0) || !near(compile("8 / 4 / 2").evaluate(0.0), 1.0)) {
+        return false;
+    }
+
+    const char* bad[] = {"", "x +", "sin x", "foo(x)", "x ^ x", "(x", "x)", "2 $ 3"};
+    for (const char* text : bad) {
+        try {
+            compile(text);
+            return false;
+        }
+        catch (const std::invalid_argument&) {
+        }
+    }
+
+    // Nesting is capped instead of overflowing the stack; long runs of unary minus need no nesting
+    const auto nested = [](std::size_t depth) {
+        return std::string(depth, '(') + "x" + std::string(depth, ')');
+    };
+    if (!near(compile(nested(ExprParser::max_depth - 1)).evaluate(2.0), 2.0) ||
+        !near(compile(std::string(100000, '-') + "x").evaluate(2.0), 2.0)) {
+        return false;
+    }
+    try {
+        compile(nested(100000));
+        return false;
+    }
+    catch (const std::invalid_argument&) {
+    }
+    return true;
+}
+
+// ============================================================================
+// Test Constant Folding and Register Allocation
+// ============================================================================
+
+bool test_folding() {
+    // Everything constant collapses into one load
+    const auto k = compile("sin(1) * 2 + exp(0)");
+    if (k.instructions().size() != 1 || !near(k.evaluate(7.0), std::sin(1.0) * 2.0 + 1.0)) {
+        return false;
+    }
+
+    // Constant subtrees become immediates: x, (x * k), (k + .)
+    const auto p = compile("(1 + 2) * x + sqrt(16)");
+    if (p.instructions().size() != 3 || p.instructions()[1].code != OpCode::MulK ||
+        p.instructions()[2].code != OpCode::AddK || !near(p.evaluate(2.0), 10.0)) {
+        return false;
+    }
+
+    // A long chain reuses registers instead of growing with its length
+    const auto chain = compile("sin(cos(sin(cos(sin(cos(x + 1) * 2) - 3) / 4) + 5) * 6)");
+    if (chain.registers() > 2) {
+        return false;
+    }
+
+    // x + 1, x + 2, ... all live until the final sum need more registers than 16 bits can name
+    ExprGraph graph;
+    const auto x = graph.var();
+    std::vector<ExprGraph::Id> terms;
+    for (int i = 1; i <= 65536; ++i) {
+        terms.push_back(graph.add(x, graph.constant(i)));
+    }
+    auto sum = terms[0];
+    for (std::size_t i = 1; i < terms.size(); ++i) {
+        sum = graph.add(sum, terms[i]);
+    }
+    try {
+        compile(graph, sum);
+        return false;
+    }
+    catch (const std::length_error&) {
+    }
+    return true;
+}
+
+// ============================================================================
+// Test Batch Evaluation
+// ============================================================================
+
+bool test_batch() {
+    using F = Add<Mul<X, Sin<X>>, Div<C_<1>, Add<X, C_<2>>>>;
+    const auto program = compile<F>();
+
+    std::vector<double> xs(3 * Program::block + 17);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = 0.01 * static_cast<double>(i);
+    }
+    std::vector<double> ys(xs.size());
+    program.evaluate(xs, ys);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        if (!near(ys[i], evaluate<F>(xs[i]))) {
+            return false;
+        }
+    }
+
+    // Short inputs use a shorter register stride
+    program.evaluate(std::span<const double>(xs.data() + 5, 3), std::span<double>(ys.data(), 3));
+    if (!near(ys[0], evaluate<F>(xs[5])) || !near(ys[2], evaluate<F>(xs[7])) ||
+        !near(program.evaluate(1.5), evaluate<F>(1.5))) {
+        return false;
+    }
+
+    // An output shorter than the inputs is rejected before anything is written
+    try {
+        program.evaluate(xs, std::span<double>(ys.data(), xs.size() - 1));
+        return false;
+    }
+    catch (const std::invalid_argument&) {
+    }
+    return true;
+}
+
+// ============================================================================
+// Test Evaluation Plans
+// ============================================================================
+
+bool test_plans() {
+    // A dense degree-6 polynomial: x, the leading (x * k) and (k + .), then one multiply-add per degree
+    using P = Add<Mul<C_<7>, Pow<X, 6>>,
+                  Add<Mul<C_<6>, Pow<X, 5>>,
+                      Add<Mul<C_<5>, Pow<X, 4>>,
+                          Add<Mul<C_<4>, Pow<X, 3>>, Add<Mul<C_<3>, Pow<X, 2>>, Add<Mul<C_<2>, X>, C_<1>>>>>>>;
+    const auto horner = compile<P>();
+    if (horner.instructions().size() != 8 || !matches_compile_time<P>(horner)) {
+        return false;
+    }
+    for (std::size_t i = 3; i < horner.instructions().size(); ++i) {
+        if (horner.instructions()[i].code != OpCode::MulAddK) {
+            return false;
+        }
+    }
+
+    // Integral powers are square-and-multiply chains, half-integral ones use sqrt
+    const auto chain = compile<Pow<X, 12>>();
+    if (chain.instructions().size() != 5 || !lowers_exactly<Pow<Sin<X>, 7>>() || !lowers_exactly<Pow<X, 2.5>>()) {
+        return false;
+    }
+
+    // Text formulas fuse a product of registers plus a constant too
+    const auto text = compile("sin(x) * cos(x) + 2");
+    return text.instructions().size() == 4 && text.instructions()[3].code == OpCode::MulAddK &&
+           near(text.evaluate(0.5), std::sin(0.5) * std::cos(0.5) + 2.0);
+}
+
+} // namespace
+
+int main() {
+    if (!test_graph() || !test_lowering() || !test_parser() || !test_folding() || !test_batch() ||
+        !test_plans()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+import typical.lambda;
+import typical.church;
+import typical.reducer;
+import typical.cache;
+
+using namespace typical;
+
+// ============================================================================
+// Test Compile-Time Hashes
+// ============================================================================
+
+static_assert(term_hash_v<Id> == term_hash_v<Abs<Var<0>>>, "Hashes are structural");
+static_assert(!(term_hash_v<Abs<Var<0>>> == term_hash_v<Abs<Var<1>>>), "Free indices are part of the hash");
+static_assert(!(term_hash_v<App<Var<0>, Var<1>>> == term_hash_v<App<Var<1>, Var<0>>>), "Application is ordered");
+static_assert(!(term_hash_v<Abs<Abs<Var<0>>>> == term_hash_v<Abs<Var<0>>>), "Binders are counted");
+static_assert(term_hash_v<named::Reverse> == term_hash_v<Reverse>, "Named terms hash as their definition");
+
+namespace {
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+using Product = App<App<Mul, church_numeral_t<6>>, church_numeral_t<7>>;
+using Paired = MakePair<Product, church_numeral_t<3>>;
+
+/// Normalize Term through cache and compare with GraphReducer
+template <typename Term>
+auto cached_matches(NormalFormCache& cache) -> bool {
+    TermGraph g;
+    CachedReducer cached(g, cache);
+    GraphReducer reducer(g);
+    return term_equal(cached.normalize<Term>(), reducer.normalize(reify<Term>(g)));
+}
+
+auto temp_log(const char* name) -> std::filesystem::path {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path;
+}
+
+// ============================================================================
+// Test Runtime Hashes
+// ============================================================================
+
+auto test_hash() -> bool {
+    TermGraph g;
+    TermHasher hash;
+    GraphReducer reducer(g);
+    return hash(reify<church_numeral_t<100>>(g)) == term_hash_v<church_numeral_t<100>> &&
+           hash(reify<Paired>(g)) == term_hash_v<Paired> &&
+           hash(reducer.normalize(reify<Product>(g))) == term_hash_v<church_numeral_t<42>> &&
+           !(hash(reify<church_numeral_t<41>>(g)) == term_hash_v<church_numeral_t<42>>);
+}
+
+// ============================================================================
+// Test Memory Tier
+// ============================================================================
+
+auto test_memory() -> bool {
+    NormalFormCache cache;
+    if (!cached_matches<Product>(cache)) {
+        return false;
+    }
+    const CacheStats cold = cache.stats();
+    if (cold.hits() != 0 || cold.misses == 0 || cold.stores == 0 || cold.memory_entries != cold.stores ||
+        cold.file_entries != 0) {
+        return false;
+    }
+
+    // The whole term is found at its root, in a fresh graph
+    if (!cached_matches<Product>(cache) || cache.stats().memory_hits != 1 || cache.stats().misses != cold.misses) {
+        return false;
+    }
+
+    // A larger term reuses the product as a subterm
+    if (!cached_matches<Paired>(cache)) {
+        return false;
+    }
+    return cache.stats().memory_hits == 2;
+}
+
+auto test_eviction() -> bool {
+    using Reversed = App<Reverse, BuildList<One, Two, church_numeral_t<3>>>;
+    NormalFormCache cache(CacheOptions{512});
+    if (!cached_matches<Paired>(cache) || !cached_matches<Reversed>(cache)) {
+        return false;
+    }
+    const CacheStats stats = cache.stats();
+    return stats.evictions > 0 && stats.memory_bytes <= 512 && stats.memory_entries + stats.evictions == stats.stores;
+}
+
+auto test_inexact() -> bool {
+    // Omega diverges, so its result depends on the step limit and is not stored
+    NormalFormCache cache(CacheOptions{std::size_t{1} << 20, 1});
+    return cached_matches<App<Abs<App<Var<0>, Var<1>>>, Omega>>(cache) && cache.stats().stores == 0 &&
+           cached_matches<App<App<Const, Id>, Omega>>(cache) && cache.stats().stores > 0;
+}
+
+// ============================================================================
+// Test File Tier
+// ============================================================================
+
+auto test_file() -> bool {
+    const auto path = temp_log("typical_cache_tests.tnfc");
+    std::size_t stored = 0;
+    {
+        NormalFormCache cache(path);
+        if (!cached_matches<Paired>(cache)) {
+            return false;
+        }
+        stored = cache.stats().stores;
+        if (cache.stats().file_entries != stored) {
+            return false;
+        }
+    }
+
+    // A new process finds the normal form on disk without reducing anything
+    bool ok = false;
+    {
+        NormalFormCache cache(path);
+        ok = cache.stats().file_entries == stored && cached_matches<Paired>(cache) && cache.stats().file_hits == 1 &&
+             cache.stats().misses == 0 && cached_matches<Paired>(cache) && cache.stats().memory_hits == 1;
+    }
+    std::filesystem::remove(path);
+    return ok;
+}
+
+auto test_torn_tail() -> bool {
+    const auto path = temp_log("typical_cache_torn_tests.tnfc");
+    std::size_t stored = 0;
+    std::size_t valid = 0;
+    {
+        NormalFormCache cache(path);
+        cached_matches<Paired>(cache);
+        stored = cache.stats().file_entries;
+        valid = cache.stats().file_bytes;
+    }
+
+    // A record cut short by a crash is dropped along with nothing before it
+    std::filesystem::resize_file(path, valid - 5);
+    std::size_t kept = 0;
+    {
+        NormalFormLog log(path);
+        kept = log.size();
+    }
+    const bool truncated = kept == stored - 1 && std::filesystem::file_size(path) < valid - 5;
+
+    // Garbage after the last record is dropped as well, and the log stays appendable
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "not a record, but long enough to pass for a record header";
+    }
+    bool ok = false;
+    {
+        NormalFormCache cache(path);
+        ok = cache.stats().file_entries == kept && cached_matches<Paired>(cache) &&
+             cache.stats().file_entries == stored;
+    }
+    {
+        NormalFormLog log(path);
+        ok = ok && log.size() == stored;
+    }
+    std::filesystem::remove(path);
+    return truncated && ok;
+}
+
+auto test_exclusive() -> bool {
+    const auto path = temp_log("typical_cache_exclusive_tests.tnfc");
+    bool refused = false;
+    bool ok = false;
+    {
+        NormalFormCache first(path);
+        cached_matches<Paired>(first);
+
+        // A second handle would append at the same offset as the first, so it is refused
+        try {
+            NormalFormLog second(path);
+        }
+        catch (const std::system_error&) {
+            refused = true;
+        }
+        ok = cached_matches<Paired>(first) && first.stats().memory_hits == 1;
+    }
+
+    // Once the first handle is closed the log opens again, with every record intact
+    {
+        NormalFormLog reopened(path);
+        ok = ok && reopened.size() > 0 && reopened.bytes() == std::filesystem::file_size(path);
+    }
+    std::filesystem::remove(path);
+    return refused && ok;
+}
+
+auto test_foreign_file() -> bool {
+    const auto path = temp_log("typical_cache_foreign_tests.tnfc");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "TLAM but not a normal-form log";
+    }
+    bool threw = false;
+    try {
+        NormalFormLog log(path);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    // The file is left as it was
+    const bool untouched = std::filesystem::file_size(path) == 30;
+    std::filesystem::remove(path);
+    return threw && untouched;
+}
+
+} // namespace
+
+int main() {
+    if (!test_hash()) {
+        return 1;
+    }
+    if (!test_memory() || !test_eviction() || !test_inexact()) {
+        return 1;
+    }
+    if (!test_file() || !test_torn_tail() || !test_exclusive() || !test_foreign_file()) {
+        return 1;
+    }
+    return 0;
+}
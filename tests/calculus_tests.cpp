@@ -0,0 +1,228 @@
+#include <cmath>
+#include <type_traits>
+
+import typical.calculus;
+
+using namespace typical;
+
+// ============================================================================
+// Test Expression Classification
+// ============================================================================
+
+static_assert(Expression<X>, "X should be an expression");
+static_assert(Expression<C_<3>>, "Const should be an expression");
+static_assert(Expression<Neg<X>>, "Neg should be an expression");
+static_assert(Expression<Tan<X>>, "Tan should be an expression");
+static_assert(Expression<Sqrt<X>>, "Sqrt should be an expression");
+static_assert(!Expression<int>, "int should not be an expression");
+
+static_assert(is_constant_v<Add<C_<1>, Mul<C_<2>, C_<3>>>>, "Constant tree should be constant");
+static_assert(is_constant_v<Neg<Sqrt<C_<4>>>>, "Neg of Sqrt of constant should be constant");
+static_assert(!is_constant_v<Add<C_<1>, X>>, "Tree containing X should not be constant");
+
+// ============================================================================
+// Test Structural Ordering
+// ============================================================================
+
+static_assert(expr_less_v<C_<1>, X>, "Constants sort before the variable");
+static_assert(expr_less_v<C_<1>, C_<2>>, "Constants sort by value");
+static_assert(expr_less_v<X, Sin<X>>, "Variable sorts before compound nodes");
+static_assert(expr_less_v<Sin<C_<1>>, Sin<X>>, "Same kind sorts by operand");
+static_assert(!expr_less_v<X, X>, "Order should be strict");
+
+// ============================================================================
+// Test Constant Folding
+// ============================================================================
+
+static_assert(std::is_same_v<simplify_t<Add<C_<2>, C_<3>>>, C_<5>>, "2 + 3 = 5");
+static_assert(std::is_same_v<simplify_t<Sub<C_<2>, C_<3>>>, C_<-1>>, "2 - 3 = -1");
+static_assert(std::is_same_v<simplify_t<Mul<Add<C_<1>, C_<2>>, C_<4>>>, C_<12>>, "(1 + 2) * 4 = 12");
+static_assert(std::is_same_v<simplify_t<Div<C_<8>, C_<2>>>, C_<4>>, "8 / 2 = 4");
+static_assert(std::is_same_v<simplify_t<Div<C_<1>, C_<2>>>, Div<C_<1>, C_<2>>>, "Inexact integer division is kept");
+static_assert(std::is_same_v<simplify_t<Div<C_<1.0>, C_<2.0>>>, C_<0.5>>, "Floating division folds");
+static_assert(std::is_same_v<simplify_t<Pow<C_<3>, 2>>, C_<9>>, "3^2 = 9");
+static_assert(std::is_same_v<simplify_t<Neg<C_<7>>>, C_<-7>>, "-(7) = -7");
+static_assert(std::is_same_v<simplify_t<Sin<Add<C_<1>, C_<1>>>>, Sin<C_<2>>>, "Sin argument is folded");
+
+// ============================================================================
+// Test Identity Elimination
+// ============================================================================
+
+static_assert(std::is_same_v<simplify_t<Mul<C_<1>, X>>, X>, "1 * X = X");
+static_assert(std::is_same_v<simplify_t<Mul<X, C_<1>>>, X>, "X * 1 = X");
+static_assert(std::is_same_v<simplify_t<Mul<Sin<X>, C_<0>>>, C_<0>>, "E * 0 = 0");
+static_assert(std::is_same_v<simplify_t<Add<X, C_<0>>>, X>, "X + 0 = X");
+static_assert(std::is_same_v<simplify_t<Add<C_<0>, Exp<X>>>, Exp<X>>, "0 + E = E");
+static_assert(std::is_same_v<simplify_t<Sub<X, C_<0>>>, X>, "X - 0 = X");
+static_assert(std::is_same_v<simplify_t<Sub<C_<0>, X>>, Neg<X>>, "0 - X = -X");
+static_assert(std::is_same_v<simplify_t<Sub<Sin<X>, Sin<X>>>, C_<0>>, "E - E = 0");
+static_assert(std::is_same_v<simplify_t<Div<X, C_<1>>>, X>, "X / 1 = X");
+static_assert(std::is_same_v<simplify_t<Pow<X, 1>>, X>, "X^1 = X");
+static_assert(std::is_same_v<simplify_t<Pow<X, 0>>, C_<1>>, "X^0 = 1");
+static_assert(std::is_same_v<simplify_t<Pow<Pow<X, 2>, 3>>, Pow<X, 6>>, "(X^2)^3 = X^6");
+static_assert(std::is_same_v<simplify_t<Neg<Neg<X>>>, X>, "-(-X) = X");
+static_assert(std::is_same_v<simplify_t<Log<Exp<X>>>, X>, "log(exp(X)) = X");
+static_assert(std::is_same_v<simplify_t<Mul<X, X>>, Pow<X, 2>>, "X * X = X^2");
+static_assert(std::is_same_v<simplify_t<Add<X, X>>, Mul<C_<2>, X>>, "X + X = 2 * X");
+
+// Nested identities collapse through several levels
+static_assert(std::is_same_v<simplify_t<Mul<C_<1>, Add<Pow<X, 1>, Mul<C_<0>, Sin<X>>>>>, X>,
+              "1 * (X^1 + 0 * sin X) = X");
+
+// ============================================================================
+// Test Canonical Operand Order
+// ============================================================================
+
+static_assert(std::is_same_v<simplify_t<Add<X, C_<2>>>, Add<C_<2>, X>>, "Constants move left in Add");
+static_assert(std::is_same_v<simplify_t<Mul<X, C_<2>>>, Mul<C_<2>, X>>, "Constants move left in Mul");
+static_assert(std::is_same_v<simplify_t<Add<Sin<X>, X>>, simplify_t<Add<X, Sin<X>>>>, "Add is order independent");
+static_assert(std::is_same_v<simplify_t<Mul<Cos<X>, Sin<X>>>, simplify_t<Mul<Sin<X>, Cos<X>>>>,
+              "Mul is order independent");
+static_assert(std::is_same_v<simplify_t<Sub<Sin<X>, X>>, Sub<Sin<X>, X>>, "Sub keeps its operand order");
+static_assert(std::is_same_v<simplify_t<Add<C_<1>, Add<C_<2>, X>>>, Add<C_<3>, X>>, "Constants are collected in Add");
+static_assert(std::is_same_v<simplify_t<Mul<C_<2>, Mul<X, C_<3>>>>, Mul<C_<6>, X>>, "Constants are collected in Mul");
+
+// ============================================================================
+// Test Symbolic Differentiation
+// ============================================================================
+
+static_assert(std::is_same_v<derive_t<X>, C_<1>>, "d/dx x = 1");
+static_assert(std::is_same_v<derive_t<C_<5>>, C_<0>>, "d/dx c = 0");
+static_assert(std::is_same_v<derive_t<Add<X, C_<3>>>, C_<1>>, "d/dx (x + 3) = 1");
+static_assert(std::is_same_v<derive_t<Mul<C_<3>, X>>, C_<3>>, "d/dx 3x = 3");
+static_assert(std::is_same_v<derive_t<Pow<X, 3>>, Mul<C_<3>, Pow<X, 2>>>, "d/dx x^3 = 3x^2");
+static_assert(std::is_same_v<derive_t<Pow<X, 2>>, Mul<C_<2>, X>>, "d/dx x^2 = 2x");
+static_assert(std::is_same_v<derive_t<Sin<X>>, Cos<X>>, "d/dx sin x = cos x");
+static_assert(std::is_same_v<derive_t<Cos<X>>, Neg<Sin<X>>>, "d/dx cos x = -sin x");
+static_assert(std::is_same_v<derive_t<Exp<X>>, Exp<X>>, "d/dx exp x = exp x");
+static_assert(std::is_same_v<derive_t<Log<X>>, Div<C_<1>, X>>, "d/dx log x = 1/x");
+static_assert(std::is_same_v<derive_t<Neg<X>>, C_<-1>>, "d/dx -x = -1");
+
+// Chain rule
+static_assert(std::is_same_v<derive_t<Sin<Mul<C_<2>, X>>>, Mul<C_<2>, Cos<Mul<C_<2>, X>>>>,
+              "d/dx sin 2x = 2 cos 2x");
+static_assert(std::is_same_v<derive_t<Exp<Sin<X>>>, simplify_t<Mul<Exp<Sin<X>>, Cos<X>>>>,
+              "d/dx exp(sin x) = exp(sin x) cos x");
+
+// Product rule
+static_assert(std::is_same_v<derive_t<Mul<X, Sin<X>>>, simplify_t<Add<Sin<X>, Mul<X, Cos<X>>>>>,
+              "d/dx x sin x = sin x + x cos x");
+
+// Quotient rule
+static_assert(std::is_same_v<derive_t<Div<C_<1>, X>>, Div<C_<-1>, Pow<X, 2>>>, "d/dx 1/x = -1/x^2");
+
+// ============================================================================
+// Test Evaluation
+// ============================================================================
+
+static_assert(evaluate<X>(3.0) == 3.0, "x at 3");
+static_assert(evaluate<Add<Mul<C_<2>, X>, C_<1>>>(3.0) == 7.0, "2x + 1 at 3");
+static_assert(evaluate<Div<X, Sub<X, C_<1>>>>(3.0) == 1.5, "x / (x - 1) at 3");
+static_assert(evaluate<Neg<Mul<X, X>>>(4.0) == -16.0, "-(x * x) at 4");
+
+// Shared subexpressions are evaluated once
+static_assert(node_count_v<Mul<Sin<X>, Exp<Sin<X>>>> == 4, "X, sin x, exp(sin x) and the product");
+static_assert(node_count_v<Add<Mul<X, X>, Mul<X, X>>> == 3, "Repeated product is one node");
+static_assert(node_count_v<derive_t<Exp<Exp<Exp<X>>>>> < 8, "Nested exp derivative shares its factors");
+
+// Fused value and derivative
+static_assert(value_and_derivative<Add<Mul<C_<3>, X>, C_<1>>>(2.0).value == 7.0, "3x + 1 at 2");
+static_assert(value_and_derivative<Add<Mul<C_<3>, X>, C_<1>>>(2.0).derivative == 3.0, "d/dx (3x + 1) at 2");
+static_assert(value_and_derivative<Mul<X, Add<X, C_<1>>>>(2.0).derivative == 5.0, "d/dx x(x + 1) at 2");
+static_assert(value_and_derivative<Div<C_<1>, X>>(2.0).derivative == -0.25, "d/dx 1/x at 2");
+
+// ============================================================================
+// Test Evaluation Plans
+// ============================================================================
+
+// Dense polynomial sum over k of (k + 1) x^k, as written by hand
+template <int K>
+struct Dense {
+    using type = Add<Mul<C_<K + 1>, Pow<X, K>>, typename Dense<K - 1>::type>;
+};
+
+template <>
+struct Dense<0> {
+    using type = C_<1>;
+};
+
+using Dense12 = Dense<12>::type;
+
+// Sums of monomials become one Horner node
+static_assert(std::is_same_v<plan_t<Add<Mul<C_<3>, Pow<X, 2>>, Add<Mul<C_<2>, X>, C_<1>>>>, Horner<3, 2, 1>>,
+              "3x^2 + 2x + 1 in Horner form");
+static_assert(std::is_same_v<plan_t<Add<Mul<C_<2>, X>, C_<1>>>, Horner<2, 1>>, "2x + 1 is one multiply-add");
+static_assert(std::is_same_v<plan_t<Sub<Pow<X, 3>, X>>, Horner<1, 0, -1, 0>>, "Missing terms are zero coefficients");
+static_assert(std::is_same_v<plan_t<Mul<X, Add<X, C_<1>>>>, Horner<1, 1, 0>>, "A monomial times a sum is expanded");
+static_assert(std::is_same_v<plan_t<Sin<Add<X, Pow<X, 2>>>>, Sin<Horner<1, 1, 0>>>, "Polynomial arguments are planned");
+static_assert(node_count_v<plan_t<Dense12>> == 1, "A dense degree-12 polynomial is one node");
+static_assert(std::is_same_v<plan_t<Dense12>, Horner<13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1>>,
+              "Coefficients from the highest degree down");
+
+// Products and powers of sums are not expanded
+static_assert(std::is_same_v<plan_t<Mul<Add<X, C_<1>>, Add<X, C_<2>>>>, Mul<Horner<1, 1>, Horner<1, 2>>>,
+              "Product of sums keeps its factors");
+static_assert(std::is_same_v<plan_t<Pow<Add<X, C_<1>>, 2>>, Mul<Horner<1, 1>, Horner<1, 1>>>,
+              "Power of a sum squares the planned sum");
+
+// Sparse polynomials keep their terms when that is cheaper
+static_assert(std::is_same_v<plan_t<Add<Pow<X, 4>, C_<1>>>, Add<C_<1>, Mul<Mul<X, X>, Mul<X, X>>>>,
+              "x^4 + 1 is two squarings and an add");
+
+// Square-and-multiply chains
+static_assert(std::is_same_v<plan_t<Pow<X, 2>>, Mul<X, X>>, "x^2");
+static_assert(std::is_same_v<plan_t<Pow<X, 5>>, Mul<X, Mul<Mul<X, X>, Mul<X, X>>>>, "x^5 = x (x^2)^2");
+static_assert(node_count_v<plan_t<Pow<X, 12>>> == 5, "x^12 from x, x^2, x^3, x^6 and x^12");
+static_assert(std::is_same_v<plan_t<Pow<X, -2>>, Div<C_<1>, Mul<X, X>>>, "Negative powers divide once");
+static_assert(std::is_same_v<plan_t<Pow<Sin<X>, 3.0>>, Mul<Sin<X>, Mul<Sin<X>, Sin<X>>>>,
+              "Integral floating exponents are chains");
+
+// Half-integral powers route to Sqrt
+static_assert(std::is_same_v<plan_t<Pow<X, 0.5>>, Sqrt<X>>, "x^0.5 = sqrt x");
+static_assert(std::is_same_v<plan_t<Pow<X, 2.5>>, Mul<Mul<X, X>, Sqrt<X>>>, "x^2.5 = x^2 sqrt x");
+static_assert(std::is_same_v<plan_t<Pow<X, -1.5>>, Div<C_<1>, Mul<X, Sqrt<X>>>>, "x^-1.5 = 1 / (x sqrt x)");
+static_assert(std::is_same_v<plan_t<Pow<X, 0.3>>, Pow<X, 0.3>>, "Other exponents are left to std::pow");
+
+// Planned evaluation
+static_assert(evaluate<Dense12>(2.0) == 98305.0, "Dense degree-12 polynomial at 2");
+static_assert(evaluate<Pow<X, 12>>(2.0) == 4096.0, "x^12 at 2");
+static_assert(evaluate<Pow<X, -2>>(4.0) == 0.0625, "x^-2 at 4");
+static_assert(value_and_derivative<Add<Pow<X, 3>, Mul<C_<2>, X>>>(2.0).value == 12.0, "x^3 + 2x at 2");
+static_assert(value_and_derivative<Add<Pow<X, 3>, Mul<C_<2>, X>>>(2.0).derivative == 14.0, "d/dx (x^3 + 2x) at 2");
+static_assert(std::is_same_v<derive_t<Horner<3, 2, 1>>, Horner<6, 2>>, "d/dx of a Horner node");
+static_assert(std::is_same_v<derive_t<Horner<3, 2>>, C_<3>>, "d/dx of a linear Horner node");
+
+namespace {
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-12 * (1.0 + std::fabs(b)); }
+
+} // namespace
+
+int main() {
+    using F = Mul<Sin<X>, Exp<Cos<X>>>;
+    const double x = 0.7;
+    const auto d = value_and_derivative<F>(x);
+    const double v = std::sin(x) * std::exp(std::cos(x));
+    const double dv = std::cos(x) * std::exp(std::cos(x)) - std::sin(x) * std::sin(x) * std::exp(std::cos(x));
+
+    if (!near(d.value, v) || !near(evaluate<F>(x), v)) {
+        return 1;
+    }
+    if (!near(d.derivative, dv) || !near(evaluate<derive_t<F>>(x), dv)) {
+        return 1;
+    }
+    if (!near(value_and_derivative<Sqrt<Tan<X>>>(x).derivative, evaluate<derive_t<Sqrt<Tan<X>>>>(x))) {
+        return 1;
+    }
+    if (!near(value_and_derivative<Log<Pow<X, 3>>>(x).derivative, 3.0 / x)) {
+        return 1;
+    }
+    if (!near(evaluate<Pow<X, 2.5>>(x), std::pow(x, 2.5)) || !near(evaluate<Pow<X, -3>>(x), std::pow(x, -3.0))) {
+        return 1;
+    }
+    if (!near(value_and_derivative<Pow<Cos<X>, 1.5>>(x).derivative,
+              -1.5 * std::sqrt(std::cos(x)) * std::sin(x))) {
+        return 1;
+    }
+    return 0;
+}
@@ -178,4 +178,71 @@ static_assert(std::is_same_v<SumNil, Zero>, "Sum of empty list should be Zero");
 using ProductNil = eval_t<App<Product, Nil>>;
 static_assert(std::is_same_v<ProductNil, One>, "Product of empty list should be One");
 
+// ============================================================================
+// Test Named Combinators
+// ============================================================================
+
+using Three = church_numeral_t<3>;
+using Numbers = BuildList<One, Two, Three>;
+using NamedNumbers = named::MakeCons<One, named::MakeCons<Two, named::MakeCons<Three, Nil>>>;
+
+// Named nodes are opaque to substitution and unfold only at the head of a redex
+static_assert(term_size_v<named::Reverse> == 1, "A named combinator should count as one node");
+static_assert(std::is_same_v<subst_t<named::Cons, 0, Var<5>>, named::Cons>, "Substitution should skip named nodes");
+static_assert(std::is_same_v<eval_t<named::Add>, named::Add>, "A named combinator alone should not unfold");
+static_assert(std::is_same_v<eval_t<App<named::Succ, Zero>>, eval_t<App<Succ, Zero>>>,
+              "A named head should unfold and reduce like its definition");
+
+// Only closed definitions can be named, since substitution never looks inside
+struct OpenTag {};
+template <typename Def>
+concept Nameable = requires { typename Named<OpenTag, Def>; };
+static_assert(free_bound_v<Abs<App<Var<0>, Var<2>>>> == 2 && is_closed_v<Add>, "Free bounds count open binders");
+static_assert(Nameable<Abs<Var<0>>> && !Nameable<Abs<Var<1>>> && !Nameable<App<Add, Var<0>>>,
+              "An open definition should not be nameable");
+
+// Read-back produces the same normal forms as the inlined definitions
+static_assert(std::is_same_v<normalize_t<named::Map>, normalize_t<Map>>, "Named Map should read back as Map");
+static_assert(std::is_same_v<normalize_t<NamedNumbers>, normalize_t<Numbers>>, "Named Cons lists should read back");
+static_assert(std::is_same_v<normalize_t<App<App<named::Map, Succ>, NamedNumbers>>,
+                             normalize_t<App<App<Map, Succ>, Numbers>>>,
+              "Named Map should give the same normal form");
+static_assert(std::is_same_v<normalize_t<App<App<named::Filter, Abs<True>>, NamedNumbers>>,
+                             normalize_t<App<App<Filter, Abs<True>>, Numbers>>>,
+              "Named Filter should give the same normal form");
+static_assert(std::is_same_v<normalize_t<App<named::Reverse, NamedNumbers>>, normalize_t<App<Reverse, Numbers>>>,
+              "Named Reverse should give the same normal form");
+static_assert(std::is_same_v<normalize_t<App<named::Sum, NamedNumbers>>, church_numeral_t<6>>,
+              "Named Sum should give the same normal form");
+static_assert(std::is_same_v<normalize_t<App<named::Length, NamedNumbers>>, Three>,
+              "Named Length should give the same normal form");
+
+// Intermediate terms stay small
+using Letters = BuildList<Var<100>, Var<101>, Var<102>, Var<103>, Var<104>, Var<105>>;
+using NamedLetters =
+    named::MakeCons<Var<100>, named::MakeCons<Var<101>, named::MakeCons<Var<102>, named::MakeCons<Var<103>,
+                    named::MakeCons<Var<104>, named::MakeCons<Var<105>, Nil>>>>>>;
+static_assert(term_size_v<eval_t<App<named::Reverse, NamedLetters>>> * 2 < term_size_v<eval_t<App<Reverse, Letters>>>,
+              "Named Reverse should keep its weak head normal form small");
+static_assert(std::is_same_v<normalize_t<App<named::Reverse, NamedLetters>>, normalize_t<App<Reverse, Letters>>>,
+              "Named Reverse should give the same normal form on longer lists");
+
+// ============================================================================
+// Test Church Numeral Table
+// ============================================================================
+
+static_assert(std::is_same_v<church_numeral_t<0>, Zero>, "Entry 0 should be Zero");
+static_assert(std::is_same_v<church_numeral_t<2>, Two>, "Entry 2 should be Two");
+static_assert(std::is_same_v<church_numeral_t<3>, normalize_t<App<Succ, Two>>>, "Entry 3 is the normal form of Succ 2");
+static_assert(std::is_same_v<church_numeral_t<5>, normalize_t<App<App<Add, Two>, church_numeral_t<3>>>>,
+              "Entry 5 is the normal form of 2 + 3");
+static_assert(std::is_same_v<church_numeral_t<6>, normalize_t<App<App<Mul, Two>, church_numeral_t<3>>>>,
+              "Entry 6 is the normal form of 2 * 3");
+static_assert(is_abs<church_numeral_t<numeral_table_size>>::value, "Last table entry is a numeral");
+static_assert(std::is_same_v<church_sum_t<7, 9>, normalize_t<App<App<Add, church_numeral_t<7>>, church_numeral_t<9>>>>,
+              "church_sum_t is the normal form of Add");
+static_assert(std::is_same_v<church_product_t<4, 5>,
+                             normalize_t<App<App<Mul, church_numeral_t<4>>, church_numeral_t<5>>>>,
+              "church_product_t is the normal form of Mul");
+
 int main() { return 0; }
@@ -0,0 +1,147 @@
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+import typical.lambda;
+import typical.church;
+import typical.lower;
+import typical.combinator;
+
+using namespace typical;
+
+// ============================================================================
+// Test Bracket Abstraction
+// ============================================================================
+
+static_assert(std::is_same_v<to_ski_t<Id>, ski::I>, "λx.x is I");
+static_assert(std::is_same_v<to_ski_t<True>, ski::K>, "λx.λy.x is K by eta");
+static_assert(std::is_same_v<to_ski_t<False>, App<ski::K, ski::I>>, "λx.λy.y is K I");
+static_assert(std::is_same_v<to_ski_t<One>, ski::I>, "λf.λx.f x is I by eta");
+static_assert(std::is_same_v<to_ski_t<Two>, App<App<ski::S, ski::B>, ski::I>>, "λf.λx.f (f x) is S B I");
+static_assert(std::is_same_v<to_ski_t<Abs<App<Var<1>, Var<0>>>>, Var<0>>, "Free variables drop below the binder");
+static_assert(std::is_same_v<to_ski_t<Abs<Abs<App<Var<0>, Var<1>>>>>, App<ski::C, ski::I>>,
+              "λx.λy.y x is C I");
+static_assert(std::is_same_v<to_ski_t<named::Add>, to_ski_t<Add>>, "Named terms translate as their definition");
+static_assert(combinator_size_v<to_ski_t<Mul>> < term_size_v<Mul> * 3, "Turner's rules keep Mul small");
+
+// ============================================================================
+// Test Combinator Reduction
+// ============================================================================
+
+static_assert(std::is_same_v<ski_reduce_t<App<App<ski::K, Var<3>>, Var<4>>>, Var<3>>, "K x y = x");
+static_assert(std::is_same_v<ski_reduce_t<App<App<App<ski::S, Var<1>>, Var<2>>, Var<3>>>,
+                             App<App<Var<1>, Var<3>>, App<Var<2>, Var<3>>>>,
+              "S f g x = f x (g x)");
+static_assert(std::is_same_v<ski_reduce_t<App<App<App<ski::B, Var<1>>, Var<2>>, Var<3>>>,
+                             App<Var<1>, App<Var<2>, Var<3>>>>,
+              "B f g x = f (g x)");
+static_assert(std::is_same_v<ski_reduce_t<App<App<App<ski::C, Var<1>>, Var<2>>, Var<3>>>,
+                             App<App<Var<1>, Var<3>>, Var<2>>>,
+              "C f g x = f x g");
+static_assert(!SkiReduce<App<App<ski::S, ski::K>, ski::K>>::reduced, "S needs three arguments");
+static_assert(std::is_same_v<ski_eval_t<App<App<App<ski::S, ski::K>, ski::K>, Var<7>>>, Var<7>>, "S K K = I");
+static_assert(SkiEval<App<App<App<ski::S, ski::K>, ski::K>, Var<7>>>::steps == 2, "S K K x takes two steps");
+using SkiOmega = App<App<App<ski::S, ski::I>, ski::I>, App<App<ski::S, ski::I>, ski::I>>;
+static_assert(SkiEval<SkiOmega, 50>::steps == 50 && SkiEval<SkiOmega, 50>::exhausted,
+              "S I I (S I I) runs until the step limit and is flagged");
+static_assert(!SkiEval<App<App<App<ski::S, ski::K>, ski::K>, Var<7>>, 2>::exhausted &&
+                  SkiEval<App<App<App<ski::S, ski::K>, ski::K>, Var<7>>, 1>::exhausted,
+              "A result is exhausted only if it still reduces");
+static_assert(!SkiNormalize<App<Var<5>, App<App<ski::S, ski::I>, ski::I>>>::exhausted &&
+                  SkiNormalize<App<Var<5>, SkiOmega>>::exhausted,
+              "Normalization flags an exhausted argument");
+static_assert(std::is_same_v<ski_normalize_t<App<Var<5>, App<ski::I, Var<6>>>>, App<Var<5>, Var<6>>>,
+              "Arguments of a stuck head are normalized");
+
+// ============================================================================
+// Test Readback
+// ============================================================================
+
+using Three = church_numeral_t<3>;
+
+static_assert(from_ski_v<Numeral, to_ski_t<App<App<Add, Two>, Three>>> == 5, "2 + 3 = 5");
+static_assert(from_ski_v<Numeral, to_ski_t<App<App<Mul, Three>, Three>>> == 9, "3 * 3 = 9");
+static_assert(from_ski_v<Numeral, to_ski_t<App<named::Sum, BuildList<One, Two, Three>>>> == 6, "Sum [1, 2, 3] = 6");
+static_assert(from_ski_v<Numeral, to_ski_t<App<Length, BuildList<Zero, Zero, Zero, Zero>>>> == 4, "Length = 4");
+static_assert(std::is_same_v<from_ski_t<Numeral, to_ski_t<App<Succ, Three>>>, church_numeral_t<4>>,
+              "Numerals read back as canonical Church numerals");
+static_assert(from_ski_v<Boolean, to_ski_t<App<IsJust, MakeJust<One>>>>, "IsJust (Just 1)");
+static_assert(!from_ski_v<Boolean, to_ski_t<App<IsLeft, MakeRight<One>>>>, "IsLeft (Right 1)");
+static_assert(std::is_same_v<from_ski_t<Boolean, to_ski_t<App<IsNothing, Nothing>>>, True>, "IsNothing Nothing");
+
+// Readback agrees with lowering the lambda term
+static_assert(from_ski_v<Numeral, to_ski_t<App<App<Mul, Two>, App<App<Add, Three>, One>>>> ==
+                  lowered_v<Numeral, App<App<Mul, Two>, App<App<Add, Three>, One>>>,
+              "2 * (3 + 1) either way");
+
+// Steps of both normalizers are exposed for comparison
+static_assert(Normalize<App<App<App<App<Add, Two>, Three>, Var<1>>, Var<0>>>::steps > 0, "Lambda steps");
+static_assert(SkiNormalize<App<App<to_ski_t<App<App<Add, Two>, Three>>, Var<1>>, Var<0>>>::steps > 0, "SKI steps");
+
+namespace {
+
+auto numeral(CombinatorGraph& g, std::size_t n) -> CombinatorGraph::Id {
+    // Successor is S B, zero is K I
+    const auto succ = g.app(CombinatorGraph::atom(CombinatorKind::S), CombinatorGraph::atom(CombinatorKind::B));
+    auto term = g.app(CombinatorGraph::atom(CombinatorKind::K), CombinatorGraph::atom(CombinatorKind::I));
+    for (std::size_t i = 0; i < n; ++i) {
+        term = g.app(succ, term);
+    }
+    return term;
+}
+
+bool test_runtime_numerals() {
+    CombinatorGraph g;
+    const auto mul = reify_combinator<to_ski_t<Mul>>(g);
+    const auto add = reify_combinator<to_ski_t<Add>>(g);
+    const auto term = g.app(g.app(mul, numeral(g, 30)), g.app(g.app(add, numeral(g, 12)), numeral(g, 5)));
+    return g.numeral(term) == std::optional<std::size_t>{510} && g.steps() > 0;
+}
+
+bool test_runtime_agrees() {
+    CombinatorGraph g;
+    using Term = to_ski_t<App<named::Sum, BuildList<Two, Three, Three>>>;
+    return g.numeral(reify_combinator<Term>(g)) == std::optional<std::size_t>{from_ski_v<Numeral, Term>} &&
+           g.boolean(reify_combinator<to_ski_t<App<IsJust, MakeJust<One>>>>(g)) == std::optional<bool>{true} &&
+           g.boolean(reify_combinator<to_ski_t<Two>>(g)) == std::nullopt &&
+           g.numeral(reify_combinator<to_ski_t<True>>(g)) == std::nullopt;
+}
+
+/// The numeral n behind `depth` applications of I
+auto delayed(CombinatorGraph& g, std::size_t n, std::size_t depth) -> CombinatorGraph::Id {
+    auto term = numeral(g, n);
+    for (std::size_t i = 0; i < depth; ++i) {
+        term = g.app(CombinatorGraph::atom(CombinatorKind::I), term);
+    }
+    return term;
+}
+
+bool test_sharing() {
+    // (λn. n + n) m shares m between both uses of n, so the I steps in front of it run once
+    CombinatorGraph shared;
+    const auto twice = reify_combinator<to_ski_t<Abs<App<App<Add, Var<0>>, Var<0>>>>>(shared);
+    if (shared.numeral(shared.app(twice, delayed(shared, 9, 20))) != std::optional<std::size_t>{18}) {
+        return false;
+    }
+    CombinatorGraph copied;
+    const auto add = reify_combinator<to_ski_t<Add>>(copied);
+    const auto sum = copied.app(copied.app(add, delayed(copied, 9, 20)), delayed(copied, 9, 20));
+    return copied.numeral(sum) == std::optional<std::size_t>{18} && shared.steps() + 15 < copied.steps();
+}
+
+bool test_step_limit() {
+    CombinatorGraph g(100);
+    const auto sii = g.app(g.app(CombinatorGraph::atom(CombinatorKind::S), CombinatorGraph::atom(CombinatorKind::I)),
+                           CombinatorGraph::atom(CombinatorKind::I));
+    g.whnf(g.app(sii, sii));
+    return g.steps() == 100;
+}
+
+} // namespace
+
+int main() {
+    if (!test_runtime_numerals() || !test_runtime_agrees() || !test_sharing() || !test_step_limit()) {
+        return 1;
+    }
+    return 0;
+}
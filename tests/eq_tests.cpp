@@ -0,0 +1,71 @@
+#include <type_traits>
+
+import typical.lambda;
+import typical.church;
+import typical.eq;
+
+using namespace typical;
+
+// ============================================================================
+// Test Normalization
+// ============================================================================
+
+using Three = Abs<Abs<App<Var<1>, App<Var<1>, App<Var<1>, Var<0>>>>>>;
+
+static_assert(std::is_same_v<normalize_t<App<Succ, Two>>, Three>, "Succ 2 normalizes to 3");
+static_assert(std::is_same_v<normalize_t<App<App<Add, One>, Two>>, normalize_t<App<App<Add, Two>, One>>>,
+              "1 + 2 and 2 + 1 share a normal form");
+static_assert(std::is_same_v<normalize_t<Id>, Id>, "Normal forms are fixed points");
+
+// ============================================================================
+// Test Input Ranges
+// ============================================================================
+
+static_assert(ChurchRange<3>::Values::size == 4, "Numerals 0..3");
+static_assert(std::is_same_v<sample_at_t<0, ChurchRange<3>::Values>, Zero>, "First numeral is Zero");
+static_assert(std::is_same_v<sample_at_t<2, ChurchRange<3>::Values>, Two>, "Third numeral is Two");
+static_assert(std::is_same_v<sample_at_t<3, ChurchRange<3>::Values>, Three>, "Fourth numeral is Three");
+
+static_assert(ListRange<2>::Values::size == 3, "Lists of length 0..2");
+static_assert(std::is_same_v<sample_at_t<0, ListRange<2>::Values>, Nil>, "Shortest list is Nil");
+static_assert(std::is_same_v<sample_at_t<2, ListRange<2>::Values>, BuildList<Var<100>, Var<101>>>,
+              "Elements are distinct free variables");
+
+// ============================================================================
+// Test Exhaustive Proof Checking
+// ============================================================================
+
+static_assert(check_forall<AddCommutative, ChurchRange<3>, ChurchRange<3>>, "Add is commutative on 0..3");
+static_assert(check_forall<AddIdentity, ChurchRange<4>>, "Zero is a right identity on 0..4");
+static_assert(check_forall<AddAssociative, ChurchRange<2>, ChurchRange<2>, ChurchRange<2>>,
+              "Add is associative on 0..2");
+static_assert(check_forall<MulDistributive, ChurchRange<2>, ChurchRange<2>, ChurchRange<2>>,
+              "Mul distributes over Add on 0..2");
+static_assert(check_forall<ReverseLengthProof, ListRange<3>>, "Reverse preserves length up to 3");
+static_assert(check_forall<MapLengthProof, ValueRange<Succ, Id>, ListRange<3>>, "Map preserves length up to 3");
+
+static_assert(CheckForall<AddAssociative, ChurchRange<2>, ChurchRange<2>, ChurchRange<2>>::cases == 27,
+              "Cost is the size of the product");
+static_assert(std::is_void_v<counterexample_t<AddCommutative, ChurchRange<2>, ChurchRange<2>>>,
+              "No counterexample when the property holds");
+
+// ============================================================================
+// Test Counterexample Reporting
+// ============================================================================
+
+/// Deliberately false: M + N = M
+template <typename M, typename N>
+struct AddIgnoresRight {
+    using Left = normalize_t<App<App<Add, M>, N>>;
+    using Right = normalize_t<M>;
+
+    using Proof = std::conditional_t<std::is_same_v<Left, Right>, Eq<Left, Right>, void>;
+};
+
+using Failing = CheckForall<AddIgnoresRight, ChurchRange<2>, ChurchRange<2>>;
+
+static_assert(!Failing::holds, "False property is refuted");
+static_assert(Failing::failure == 1, "Cases are ordered with the last range fastest");
+static_assert(std::is_same_v<Failing::Counterexample, Samples<Zero, One>>, "First counterexample is 0 + 1");
+
+int main() { return 0; }
@@ -0,0 +1,96 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+import typical.lambda;
+import typical.set;
+import typical.filter;
+
+using namespace typical;
+
+using A = set::Leaf<0>;
+using B = set::Leaf<1>;
+using C = set::Leaf<2>;
+
+// (A ∩ B) ∪ ¬C
+using Query = App<App<set::Union, App<App<set::Intersertion, A>, B>>, App<set::Complement, C>>;
+
+// ============================================================================
+// Test Plans
+// ============================================================================
+
+static_assert(FilterPlan<Query>::leaves == 3, "Three leaves");
+static_assert(FilterPlan<App<App<set::Difference, C>, A>>::template uses<0>, "Difference reads both operands");
+static_assert(!FilterPlan<App<App<set::Difference, C>, A>>::template uses<1>, "Leaf 1 is not read");
+static_assert(FilterPlan<Query>::combine(std::array<std::uint64_t, 3>{0b1100, 0b1010, 0b0011}) ==
+                  (0b1000 | ~std::uint64_t{0b0011}),
+              "(A & B) | ~C on words");
+static_assert(FilterPlan<App<App<set::Intersertion, UniversalSet>, App<set::Complement, EmptySet>>>::combine(
+                  std::array<std::uint64_t, 0>{}) == ~std::uint64_t{0},
+              "Constant sets");
+static_assert(bitmap_words(0) == 0 && bitmap_words(64) == 1 && bitmap_words(65) == 2, "Bitmap sizes");
+
+namespace {
+
+struct Batch {
+    std::span<const std::int32_t> price;
+    std::span<const std::int32_t> quantity;
+    std::span<const std::uint8_t> flag;
+};
+
+auto in_query(const Batch& b, std::size_t i) -> bool {
+    return (b.price[i] > 50 && b.quantity[i] < 20) || b.flag[i] == 0;
+}
+
+bool test_query(std::size_t rows) {
+    std::vector<std::int32_t> price(rows);
+    std::vector<std::int32_t> quantity(rows);
+    std::vector<std::uint8_t> flag(rows);
+    std::uint32_t state = 12345;
+    for (std::size_t i = 0; i < rows; ++i) {
+        state = state * 1664525u + 1013904223u;
+        price[i] = static_cast<std::int32_t>(state >> 25);
+        quantity[i] = static_cast<std::int32_t>((state >> 9) & 63);
+        flag[i] = static_cast<std::uint8_t>((state >> 3) & 3);
+    }
+    const Batch batch{price, quantity, flag};
+
+    const auto filter = make_filter<Query>([](const Batch& b, std::size_t i) { return b.price[i] > 50; },
+                                           [](const Batch& b, std::size_t i) { return b.quantity[i] < 20; },
+                                           [](const Batch& b, std::size_t i) { return b.flag[i] != 0; });
+
+    std::vector<std::uint64_t> bitmap(bitmap_words(rows));
+    std::vector<std::uint32_t> indices(rows);
+    const std::size_t from_bitmap = filter.select(batch, rows, std::span<std::uint64_t>(bitmap));
+    const std::size_t from_indices = filter.select(batch, rows, std::span<std::uint32_t>(indices));
+    if (from_bitmap != from_indices) {
+        return false;
+    }
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+        const bool in = in_query(batch, i);
+        if (((bitmap[i / 64] >> (i % 64)) & 1) != static_cast<std::uint64_t>(in)) {
+            return false;
+        }
+        if (in && indices[expected++] != i) {
+            return false;
+        }
+    }
+    // No bits past the last row, even under a complement
+    if (rows % 64 != 0 && (bitmap.back() >> (rows % 64)) != 0) {
+        return false;
+    }
+    return expected == from_bitmap;
+}
+
+} // namespace
+
+int main() {
+    if (!test_query(0) || !test_query(1) || !test_query(64) || !test_query(1000)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+import typical.eq;
+import typical.nat;
+import typical.fin;
+
+using namespace typical;
+
+// ============================================================================
+// Test Proof-Based Construction
+// ============================================================================
+
+using Four = nat::Four;
+using Three = nat::Three;
+
+static_assert(Fin<Four>::bound == 4, "Fin<Four> should have bound 4");
+static_assert(sizeof(Fin<Four>) == sizeof(std::size_t), "Fin should be a plain index");
+static_assert(Fin<Four>::of<Three>().value() == 3, "of<I> should hold I");
+static_assert(fin_v<2, Four> == Fin<Four>::of<nat::Two>(), "fin_v should match of<I>");
+
+// of<I> is only available when less_than_v<I, N> holds
+template <typename N, typename I>
+concept CanIndex = requires { Fin<N>::template of<I>(); };
+static_assert(CanIndex<Four, Three>, "3 < 4");
+static_assert(!CanIndex<Four, Four>, "4 is not below 4");
+static_assert(!CanIndex<nat::Zero, nat::Zero>, "Fin<Zero> has no values");
+
+// Weakening requires less_or_equal_v, transport an Eq proof
+static_assert(fin_v<1, Three>.weaken<Four>() == fin_v<1, Four>, "Weakening should keep the index");
+static_assert(fin_v<1, Three>.weaken<Three>() == fin_v<1, Three>, "Weakening to the same bound");
+template <typename N, typename M>
+concept CanWeaken = requires(Fin<N> i) { i.template weaken<M>(); };
+static_assert(!CanWeaken<Four, Three>, "A bound cannot shrink");
+
+using TwoPlusTwo = nat::add_t<nat::Two, nat::Two>;
+static_assert(fin_v<3, TwoPlusTwo>.transport<Four, eq_proof<TwoPlusTwo, Four>>() == fin_v<3, Four>,
+              "Transport along 2 + 2 = 4");
+
+// Runtime checks
+static_assert(Fin<Four>::check(3).has_value() && !Fin<Four>::check(4).has_value(), "check should test the bound");
+
+// ============================================================================
+// Test Iteration And Containers
+// ============================================================================
+
+constexpr auto sum_squares() -> std::size_t {
+    FinArray<std::size_t, Four> squares{};
+    for (const Fin<Four> i : fin_range<Four>()) {
+        squares[i] = i.value() * i.value();
+    }
+    std::size_t total = 0;
+    for_each_fin<Four>([&](Fin<Four> i) { total += squares[i]; });
+    return total;
+}
+
+static_assert(sum_squares() == 14, "0 + 1 + 4 + 9");
+static_assert(FinRange<nat::Zero>::size() == 0 && fin_range<nat::Zero>().begin() == fin_range<nat::Zero>().end(),
+              "Fin<Zero> has an empty range");
+static_assert(sizeof(FinArray<int, Four>) == sizeof(std::array<int, 4>), "FinArray should add no storage");
+
+namespace {
+
+auto test_spans() -> bool {
+    using N = nat::nat_t<100>;
+    std::vector<int> values(150);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+    if (FinSpan<int, N>::check(std::span<int>(values).first(99))) {
+        return false;
+    }
+    const auto view = FinSpan<int, N>::check(values);
+    if (!view) {
+        return false;
+    }
+    long total = 0;
+    for (const Fin<N> i : fin_range<N>()) {
+        total += (*view)[i];
+    }
+
+    FinArray<int, Four> array{{5, 6, 7, 8}};
+    FinSpan<const int, Four> fixed(array);
+    std::array<int, 4> raw{1, 2, 3, 4};
+    FinSpan<int, Four> over_raw{std::span<int, 4>(raw)};
+    over_raw[fin_v<0, Four>] = 10;
+    return total == 4950 && fixed[fin_v<3, Four>] == 8 && raw[0] == 10 && view->size() == 100;
+}
+
+} // namespace
+
+int main() {
+    if (!test_spans()) {
+        return 1;
+    }
+    return 0;
+}
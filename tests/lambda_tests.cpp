@@ -227,6 +227,38 @@ using LimitedEval = eval_t<App<Id, App<Id, App<Id, Var<0>>>>, 1>;
 // Y combinator should be an abstraction
 static_assert(is_abs<Y>::value, "Y combinator should be an abstraction");
 
+// ============================================================================
+// Test Divergence Detection
+// ============================================================================
+
+// Omega reduces to itself: evaluation stops after the first step
+static_assert(std::is_same_v<eval_t<Omega>, Omega>, "Omega should evaluate to itself");
+static_assert(Eval<Omega>::diverged, "Omega should be flagged as diverged");
+static_assert(Eval<Omega>::steps == 0, "Omega should stop without taking a step");
+static_assert(std::is_same_v<eval_checked_t<Omega>, Diverged<Omega>>, "eval_checked_t should wrap Omega in Diverged");
+
+// Unguarded fixpoint of Id: Yn Id -> W W -> Id (W W) -> W W
+using YNaive = Abs<App<Abs<App<Var<1>, App<Var<0>, Var<0>>>>, Abs<App<Var<1>, App<Var<0>, Var<0>>>>>>;
+using LoopW = Abs<App<Id, App<Var<0>, Var<0>>>>;
+static_assert(diverges_v<App<YNaive, Id>>, "Y Id should be flagged as diverged");
+static_assert(std::is_same_v<eval_t<App<YNaive, Id>>, App<Id, App<LoopW, LoopW>>>, "Y Id should stop before the repeat");
+static_assert(is_diverged<eval_checked_t<App<YNaive, Id>>>::value, "eval_checked_t should flag Y Id");
+
+// Normalize leaves a diverged subterm as Eval returned it
+static_assert(std::is_same_v<normalize_t<Omega>, Omega>, "Omega should normalize to itself");
+static_assert(std::is_same_v<normalize_t<Abs<App<YNaive, Id>>>, Abs<App<Id, App<LoopW, LoopW>>>>,
+              "Normalize should stop at a diverged body");
+
+// The eta-expanded Y stops at a weak head normal form instead
+static_assert(!diverges_v<App<Y, Id>>, "Y Id should reach an abstraction");
+static_assert(is_abs<eval_t<App<Y, Id>>>::value, "Y Id should reach an abstraction");
+
+// Terminating terms stop as soon as they reach a normal form
+static_assert(!diverges_v<App<App<Add, Two>, Two>>, "2 + 2 should terminate");
+static_assert(Eval<App<Id, App<Id, Var<0>>>>::steps == 2, "Id (Id x) should take two steps");
+static_assert(std::is_same_v<eval_checked_t<App<Id, Var<3>>>, Var<3>>, "eval_checked_t should not wrap normal forms");
+static_assert(std::is_same_v<LimitedEval, App<Id, App<Id, Var<0>>>>, "A step limit of one should take one step");
+
 // ============================================================================
 // Compilation Success Message
 // ============================================================================
@@ -0,0 +1,85 @@
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+import typical.lambda;
+import typical.church;
+import typical.lower;
+
+using namespace typical;
+
+// ============================================================================
+// Test Runtime Types
+// ============================================================================
+
+static_assert(std::is_same_v<lowered_t<PairOf<Numeral, Boolean>>, std::pair<std::size_t, bool>>, "Pair lowers to pair");
+static_assert(std::is_same_v<lowered_t<MaybeOf<Numeral>>, std::optional<std::size_t>>, "Maybe lowers to optional");
+static_assert(std::is_same_v<lowered_t<EitherOf<Numeral, Boolean>>, std::variant<std::size_t, bool>>,
+              "Either lowers to variant");
+static_assert(std::is_trivially_copyable_v<lowered_t<MaybeOf<Numeral>>>, "Optional numerals are trivially copyable");
+static_assert(std::is_trivially_copyable_v<lowered_t<EitherOf<Numeral, Boolean>>>, "Either payloads are trivially copyable");
+static_assert(std::is_trivially_copy_constructible_v<lowered_t<PairOf<Numeral, Numeral>>>,
+              "Pairs of numerals are trivially copy constructible");
+
+// ============================================================================
+// Test Lowering
+// ============================================================================
+
+using Three = church_numeral_t<3>;
+
+static_assert(lowered_v<Numeral, App<App<Add, Two>, Three>> == 5, "2 + 3 lowers to 5");
+static_assert(lowered_v<Boolean, App<IsJust, MakeJust<One>>>, "IsJust (Just 1) lowers to true");
+static_assert(!lowered_v<Boolean, App<IsLeft, MakeRight<One>>>, "IsLeft (Right 1) lowers to false");
+
+static_assert(lowered_v<PairOf<Numeral, Boolean>, MakePair<Two, True>> == std::pair<std::size_t, bool>{2, true},
+              "Pair 2 True");
+static_assert(lowered_v<PairOf<Numeral, Numeral>, App<Snd, MakePair<Zero, MakePair<One, Two>>>> ==
+                  std::pair<std::size_t, std::size_t>{1, 2},
+              "Snd of a nested pair");
+static_assert(lowered_v<MaybeOf<Numeral>, MakeJust<App<Succ, Two>>> == std::optional<std::size_t>(3), "Just 3");
+static_assert(!lowered_v<MaybeOf<Numeral>, Nothing>.has_value(), "Nothing");
+static_assert(lowered_v<Numeral, App<App<FromMaybe, Two>, Nothing>> == 2, "FromMaybe 2 Nothing");
+static_assert(std::get<0>(lowered_v<EitherOf<Numeral, Boolean>, MakeLeft<One>>) == 1, "Left 1");
+static_assert(lowered_v<EitherOf<Numeral, Boolean>, MakeRight<False>>.index() == 1 &&
+                  !std::get<1>(lowered_v<EitherOf<Numeral, Boolean>, MakeRight<False>>),
+              "Right False");
+static_assert(lowered_v<MaybeOf<PairOf<Boolean, Numeral>>, MakeJust<MakePair<False, One>>> ==
+                  std::optional<std::pair<bool, std::size_t>>({false, 1}),
+              "Just (Pair False 1)");
+
+// Shapes that do not match are reported, not guessed
+static_assert(!lowers_v<Boolean, Two>, "2 is not a boolean");
+static_assert(!lowers_v<PairOf<Numeral, Numeral>, Id>, "Id is not a pair");
+static_assert(!lowers_v<MaybeOf<Numeral>, MakeJust<True>> && lowers_v<MaybeOf<Boolean>, MakeJust<True>>,
+              "Payloads are checked against their shape");
+
+// ============================================================================
+// Test Raising
+// ============================================================================
+
+static_assert(std::is_same_v<raise_t<Numeral, [] { return std::size_t{3}; }>, Three>, "Raise 3");
+static_assert(std::is_same_v<raise_t<Boolean, [] { return false; }>, False>, "Raise false");
+static_assert(std::is_same_v<raise_t<PairOf<Numeral, Boolean>, [] { return std::pair<std::size_t, bool>{2, true}; }>,
+                             normalize_t<MakePair<Two, True>>>,
+              "Raise a pair to its normal form");
+static_assert(std::is_same_v<raise_t<MaybeOf<Numeral>, [] { return std::optional<std::size_t>(1); }>,
+                             normalize_t<MakeJust<One>>>,
+              "Raise Just 1");
+static_assert(std::is_same_v<raise_t<MaybeOf<Numeral>, [] { return std::optional<std::size_t>(); }>, Nothing>,
+              "Raise Nothing");
+static_assert(std::is_same_v<raise_t<EitherOf<Numeral, Boolean>, [] { return std::variant<std::size_t, bool>(true); }>,
+                             normalize_t<MakeRight<True>>>,
+              "Raise Right True");
+
+// Round trip
+constexpr auto nested() {
+    return std::optional<std::pair<bool, std::size_t>>(std::pair<bool, std::size_t>{true, 4});
+}
+using NestedShape = MaybeOf<PairOf<Boolean, Numeral>>;
+static_assert(lowered_v<NestedShape, raise_t<NestedShape, nested>> == nested(), "Raise then lower");
+static_assert(lowered_v<Numeral, App<App<Mul, raise_t<Numeral, [] { return std::size_t{6}; }>>, Three>> == 18,
+              "Raised values compute at the type level");
+
+int main() { return 0; }
@@ -1,3 +1,4 @@
+#include <cstddef>
 #include <type_traits>
 
 import typical.nat;
@@ -77,6 +78,10 @@ static_assert(to_value_v<from_value_t<5>> == 5, "Roundtrip 5");
 static_assert(to_value_v<from_value_t<10>> == 10, "Roundtrip 10");
 static_assert(to_value_v<from_value_t<15>> == 15, "Roundtrip 15");
 
+// Test nat_t table
+static_assert(std::is_same_v<nat_t<10>, Ten>, "nat_t<10> should be Ten");
+static_assert(std::is_same_v<nat_t<nat_table_size>, S<nat_t<nat_table_size - 1>>>, "Last table entry is a successor");
+
 static_assert(std::is_same_v<from_value_t<to_value_v<Zero>>, Zero>, "Roundtrip Zero");
 static_assert(std::is_same_v<from_value_t<to_value_v<Five>>, Five>, "Roundtrip Five");
 static_assert(std::is_same_v<from_value_t<to_value_v<Ten>>, Ten>, "Roundtrip Ten");
@@ -106,6 +111,14 @@ static_assert(to_value_v<add_t<Three, Two>> == 5, "3 + 2 = 5");
 static_assert(to_value_v<add_t<Four, Six>> == 10, "4 + 6 = 10");
 static_assert(to_value_v<add_t<Seven, Three>> == 10, "7 + 3 = 10");
 
+// Large operands walk eight successors per instantiation
+static_assert(std::is_same_v<add_t<nat_t<1000>, nat_t<1003>>, nat_t<2003>>, "1000 + 1003 = 2003");
+static_assert(std::is_same_v<sub_t<nat_t<2003>, nat_t<1000>>, nat_t<1003>>, "2003 - 1000 = 1003");
+static_assert(std::is_same_v<sub_t<nat_t<1003>, nat_t<2003>>, Z>, "1003 - 2003 = 0");
+static_assert(less_than_v<nat_t<1000>, nat_t<1001>> && !less_than_v<nat_t<1001>, nat_t<1000>> &&
+                  !less_than_v<nat_t<1000>, nat_t<1000>>,
+              "Comparison of large numbers");
+
 // Addition commutativity (spot check)
 static_assert(std::is_same_v<add_t<Two, Three>, add_t<Three, Two>>, "2 + 3 = 3 + 2");
 static_assert(std::is_same_v<add_t<One, Four>, add_t<Four, One>>, "1 + 4 = 4 + 1");
@@ -321,6 +334,12 @@ static_assert(std::is_same_v<add_t<mul_t<div_t<Seven, Three>, Three>, mod_t<Seve
               "7 = (7/3)*3 + (7%3)");
 static_assert(std::is_same_v<add_t<mul_t<div_t<Ten, Three>, Three>, mod_t<Ten, Three>>, Ten>, "10 = (10/3)*3 + (10%3)");
 
+// Long division on larger values
+static_assert(long_divide(1000, 7).quotient == 142 && long_divide(1000, 7).remainder == 6, "1000 = 142*7 + 6");
+static_assert(long_divide(7, 0).quotient == 0 && long_divide(7, 0).remainder == 0, "Division by zero yields {0, 0}");
+static_assert(std::is_same_v<div_t<nat_t<1000>, nat_t<7>>, nat_t<142>>, "1000 / 7 = 142");
+static_assert(std::is_same_v<mod_t<nat_t<1000>, nat_t<7>>, Six>, "1000 % 7 = 6");
+
 // ============================================================================
 // Test Power
 // ============================================================================
@@ -395,6 +414,13 @@ static_assert(std::is_same_v<gcd_t<Eight, from_value_t<12>>, Four>, "gcd(8, 12)
 static_assert(std::is_same_v<gcd_t<Six, Nine>, gcd_t<Nine, Six>>, "gcd is commutative");
 static_assert(std::is_same_v<gcd_t<Four, Ten>, gcd_t<Ten, Four>>, "gcd is commutative");
 
+// Binary GCD on larger values
+static_assert(binary_gcd(840, 600) == 120, "gcd(840, 600) = 120");
+static_assert(binary_gcd(1024, 96) == 32, "gcd(1024, 96) = 32");
+static_assert(binary_gcd(0, 0) == 0, "gcd(0, 0) = 0");
+static_assert(std::is_same_v<gcd_t<nat_t<840>, nat_t<600>>, nat_t<120>>, "gcd(840, 600) = 120");
+static_assert(std::is_same_v<gcd_t<nat_t<1009>, nat_t<1013>>, One>, "Distinct primes are coprime");
+
 // ============================================================================
 // Test Fibonacci
 // ============================================================================
@@ -490,4 +516,56 @@ static_assert(to_value_v<add_t<factorial_t<Three>, factorial_t<Two>>> == 8, "Com
 // 2^3 + 3^2 = 17
 static_assert(to_value_v<add_t<pow_t<Two, Three>, pow_t<Three, Two>>> == 17, "Complex expression 5");
 
-int main() { return 0; }
+// ============================================================================
+// Test Runtime Dispatch Tables
+// ============================================================================
+
+// Typed entries and constant-evaluated entries agree at the boundary
+static_assert(FactorialFn::value(7) == to_value_v<factorial_t<Seven>>, "Factorial implementations agree");
+static_assert(FibonacciFn::value(15) == to_value_v<fibonacci_t<from_value_t<15>>>, "Fibonacci implementations agree");
+static_assert(PowFn::value(5, 5) == to_value_v<pow_t<Five, Five>>, "Pow implementations agree");
+static_assert(GcdFn::value(12, 8) == to_value_v<gcd_t<from_value_t<12>, Eight>>, "GCD implementations agree");
+
+static_assert(lookup<FactorialFn>(5) == 120, "5! from the typed part of the table");
+static_assert(lookup<FactorialFn>(20) == 2432902008176640000ULL, "20! from the evaluated part of the table");
+static_assert(lookup<FactorialFn>(21) == FactorialFn::value(21) && lookup<FactorialFn>(70) == 0,
+              "Past the table, factorials wrap modulo 2^64");
+static_assert(lookup<FibonacciFn>(10) == 55 && lookup<FibonacciFn>(93) == 12200160415121876738ULL, "Fibonacci");
+static_assert(lookup<FibonacciFn>(94) == 1293530146158671551ULL, "F(94) wraps modulo 2^64");
+static_assert(lookup<PowFn>(2, 10) == 1024 && lookup<PowFn>(0, 0) == 1, "Pow from the table");
+static_assert(lookup<PowFn>(3, 40) == 12157665459056928801ULL, "Pow past the table");
+static_assert(lookup<GcdFn>(12, 8) == 4 && lookup<GcdFn>(0, 9) == 9 && lookup<GcdFn>(100, 75) == 25, "GCD");
+
+// Table size and typed prefix are chosen per table
+static_assert(DispatchTable<FactorialFn>::entries == 21 && DispatchTable<GcdFn>::entries == 64 * 64, "Default sizes");
+static_assert(DispatchTable<FibonacciFn, 4>::entries == 4 && !DispatchTable<FibonacciFn, 4>::contains(4) &&
+                  DispatchTable<FibonacciFn, 4>::lookup(12) == 144,
+              "A small table falls back past its end");
+static_assert(DispatchTable<PowFn, 8, 0>::values[2 * 8 + 7] == 128, "A table with no typed entries");
+
+namespace {
+
+auto test_dispatch() -> bool {
+    // Runtime arguments, read through volatile so the lookups are not folded
+    volatile std::size_t limit = 200;
+    for (std::size_t n = 0; n < limit; ++n) {
+        if (lookup<FactorialFn>(n) != FactorialFn::value(n) || lookup<FibonacciFn>(n) != FibonacciFn::value(n)) {
+            return false;
+        }
+        for (std::size_t m = 0; m < limit; m += 7) {
+            if (lookup<PowFn>(m, n) != PowFn::value(m, n) || lookup<GcdFn>(m, n) != GcdFn::value(m, n)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    if (!test_dispatch()) {
+        return 1;
+    }
+    return 0;
+}
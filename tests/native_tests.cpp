@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+import typical.lambda;
+import typical.church;
+import typical.lower;
+import typical.native;
+
+using namespace typical;
+
+using Three = church_numeral_t<3>;
+
+// λn. n (λd. False) True
+using IsZero = Abs<App<App<Var<0>, Abs<False>>, True>>;
+
+// λb. b False True
+using Not = Abs<App<App<Var<0>, False>, True>>;
+
+// Y (λr.λn. IsZero n (λd. 0) (λd. n + r (Pred n)) Id), with guarded branches for call-by-value
+using SumTo = App<Y, Abs<Abs<App<App<App<App<IsZero, Var<0>>, Abs<Zero>>,
+                                     Abs<App<App<Add, Var<1>>, App<Var<2>, App<Pred, Var<1>>>>>>,
+                                 Id>>>>;
+
+// ============================================================================
+// Test Static Compilation
+// ============================================================================
+
+static_assert(to_native<Numeral>(compile<App<App<Add, Two>, Three>>()) == 5, "2 + 3 runs as native calls");
+static_assert(to_native<Numeral>(compile<App<named::Sum, BuildList<One, Two, Three>>>()) == 6, "Named terms compile");
+static_assert(to_native<Boolean>(compile<App<IsJust, MakeJust<One>>>()), "IsJust (Just 1)");
+static_assert(!to_native<Boolean>(compile<App<IsZero, Three>>()), "IsZero 3");
+static_assert(to_native<Numeral>(compile<App<Pred, Three>>()) == 2, "Pred types statically on a static numeral");
+
+// Runtime data at the boundary, still constant-evaluable
+static_assert(to_native<Numeral>(compile<Mul>()(from_native<Numeral>(6))(from_native<Numeral>(7))) == 42, "6 * 7");
+static_assert(to_native<Numeral>(compile<Succ>()(from_native<Numeral>(99))) == 100, "Succ 99");
+static_assert(to_native<Boolean>(compile<Abs<Abs<Var<1>>>>()(from_native<Boolean>(false))(true)) == false,
+              "Const false");
+static_assert(std::is_same_v<decltype(compile<Mul>()(from_native<Numeral>(6))(from_native<Numeral>(7))(NativeSucc{})(
+                                 std::size_t{0})),
+                             std::size_t>,
+              "Homogeneous iteration stays native");
+
+namespace {
+
+bool test_dynamic_iteration() {
+    // Pred changes the type of its accumulator at every step, so a runtime numeral iterates on Dynamic
+    const auto pred = compile<Pred>();
+    return to_native<Numeral>(pred(from_native<Numeral>(10))) == 9 &&
+           to_native<Numeral>(pred(from_native<Numeral>(0))) == 0 &&
+           to_native<Boolean>(compile<Not>()(from_native<Boolean>(true))) == false;
+}
+
+bool test_recursion() {
+    const auto sum_to = compile<SumTo>();
+    return to_native<Numeral>(sum_to(from_native<Numeral>(0))) == 0 &&
+           to_native<Numeral>(sum_to(from_native<Numeral>(4))) == 10 &&
+           to_native<Numeral>(sum_to(Native<Three>::run(NativeEnv{}))) == 6;
+}
+
+bool test_runtime_list() {
+    // A list of runtime length has no static type, so it is built on Dynamic
+    Dynamic list = to_dynamic(compile<Nil>());
+    const auto cons = compile<Cons>();
+    for (std::size_t i = 1; i <= 10; ++i) {
+        list = to_dynamic(cons(from_native<Numeral>(i))(list));
+    }
+    return to_native<Numeral>(compile<Sum>()(list)) == 55 && to_native<Numeral>(compile<Length>()(list)) == 10;
+}
+
+bool test_shape_mismatch() {
+    try {
+        to_native<Numeral>(to_dynamic(compile<App<Cons, One>>()));
+    }
+    catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main() {
+    if (!test_dynamic_iteration() || !test_recursion() || !test_runtime_list() || !test_shape_mismatch()) {
+        return 1;
+    }
+    return 0;
+}
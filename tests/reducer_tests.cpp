@@ -0,0 +1,149 @@
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+import typical.lambda;
+import typical.church;
+import typical.pool;
+import typical.reducer;
+
+using namespace typical;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+auto church(TermGraph& g, std::size_t n) -> const TermNode* {
+    const TermNode* body = g.var(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        body = g.app(g.var(1), body);
+    }
+    return g.abs(g.abs(body));
+}
+
+/// Map (λn. n * n) over a list of count numerals of the given value
+auto squares(TermGraph& g, std::size_t count, std::size_t value) -> const TermNode* {
+    const TermNode* list = reify<Nil>(g);
+    const TermNode* cons = reify<Cons>(g);
+    for (std::size_t i = 0; i < count; ++i) {
+        list = g.app(g.app(cons, church(g, value)), list);
+    }
+    const TermNode* square = reify<Abs<App<App<Mul, Var<0>>, Var<0>>>>(g);
+    return g.app(g.app(reify<Map>(g), square), list);
+}
+
+/// Reduce Term at runtime and compare with its type-level normal form
+template <typename Term>
+auto matches_type_level() -> bool {
+    TermGraph g;
+    GraphReducer reducer(g);
+    return term_equal(reducer.normalize(reify<Term>(g)), reify<normalize_t<Term>>(g));
+}
+
+// ============================================================================
+// Test Reification
+// ============================================================================
+
+auto test_reify() -> bool {
+    TermGraph g;
+    const TermNode* id = reify<Id>(g);
+    const TermNode* open = reify<App<Var<3>, Abs<Var<0>>>>(g);
+    return id->kind == TermKind::Abs && id->left->kind == TermKind::Var && id->free_bound == 0 && id->size == 2 &&
+           open->free_bound == 4 && open->size == 4 && term_equal(open->right, id) && !term_equal(open, id);
+}
+
+/// Alternating between two graphs on one thread reuses the thread's arena in each
+auto test_graph_switching() -> bool {
+    TermGraph a;
+    TermGraph b;
+    for (int i = 0; i < 2000; ++i) {
+        a.var(0);
+        b.var(0);
+    }
+    return a.arena_count() == 1 && b.arena_count() == 1 && a.block_count() == 1 && b.block_count() == 1;
+}
+
+// ============================================================================
+// Test Sequential Reduction
+// ============================================================================
+
+auto test_sequential() -> bool {
+    return matches_type_level<App<App<Add, One>, Two>>() && matches_type_level<App<App<Mul, Two>, Two>>() &&
+           matches_type_level<App<App<Map, Succ>, BuildList<Var<100>, Var<101>, Var<102>>>>() &&
+           matches_type_level<App<Reverse, BuildList<Var<100>, Var<101>>>>() &&
+           // Named combinators are inlined by reify and read back to the same normal form
+           matches_type_level<App<named::Reverse, named::MakeCons<Var<100>, named::MakeCons<Var<101>, Nil>>>>() &&
+           // Normal order discards the diverging argument
+           matches_type_level<App<App<Const, Id>, Omega>>() &&
+           // A head that reduces back to a recent term stops there, like Eval
+           matches_type_level<Omega>() &&
+           matches_type_level<App<Abs<App<Abs<App<Var<1>, App<Var<0>, Var<0>>>>, Abs<App<Var<1>, App<Var<0>, Var<0>>>>>>, Id>>();
+}
+
+// ============================================================================
+// Test Sharing
+// ============================================================================
+
+auto test_sharing() -> bool {
+    TermGraph g;
+    GraphReducer reducer(g);
+    // (λx. f x x) applied to a closed redex: both copies are one node, normalized once
+    const TermNode* arg = reify<App<App<Add, Two>, Two>>(g);
+    const TermNode* result = reducer.normalize(g.app(reify<Abs<App<App<Var<1>, Var<0>>, Var<0>>>>(g), arg));
+    return result->kind == TermKind::App && result->left->right == result->right &&
+           arg->normal.load() == result->right && term_equal(result->right, reify<church_numeral_t<4>>(g));
+}
+
+// ============================================================================
+// Test Parallel Reduction
+// ============================================================================
+
+auto test_parallel() -> bool {
+    TermGraph sequential_graph;
+    GraphReducer sequential(sequential_graph);
+    const TermNode* expected = sequential.normalize(squares(sequential_graph, 200, 6));
+
+    WorkStealingPool pool(4);
+    for (std::uint32_t threshold : {1u, 16u, 64u}) {
+        TermGraph g;
+        ReduceOptions options;
+        options.spawn_threshold = threshold;
+        GraphReducer reducer(g, options);
+        if (!term_equal(reducer.normalize(squares(g, 200, 6), pool), expected)) {
+            return false;
+        }
+    }
+
+    // One list shared by both components of a pair is reduced once
+    TermGraph g;
+    GraphReducer reducer(g);
+    const TermNode* list = squares(g, 50, 4);
+    const TermNode* result = reducer.normalize(g.app(g.app(reify<Pair>(g), list), list), pool);
+    const TermNode* twice = sequential.normalize(
+        sequential_graph.app(sequential_graph.app(reify<Pair>(sequential_graph), squares(sequential_graph, 50, 4)),
+                             squares(sequential_graph, 50, 4)));
+    return term_equal(result, twice) && list->normal.load() != nullptr;
+}
+
+} // namespace
+
+int main() {
+    if (!test_reify()) {
+        return 1;
+    }
+    if (!test_graph_switching()) {
+        return 1;
+    }
+    if (!test_sequential()) {
+        return 1;
+    }
+    if (!test_sharing()) {
+        return 1;
+    }
+    if (!test_parallel()) {
+        return 1;
+    }
+    return 0;
+}
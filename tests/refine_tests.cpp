@@ -0,0 +1,117 @@
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+import typical.refine;
+
+using namespace typical;
+
+// ============================================================================
+// Test Compile-Time Refinement
+// ============================================================================
+
+using Percent = Refined<int, InRange<0, 100>>;
+using Probability = Refined<double, All<Finite, InRange<0, 1>>>;
+
+constexpr Percent half = 50;
+constexpr Probability likely = 0.75;
+
+static_assert(half.value() == 50, "A constant refinement should keep its value");
+static_assert(likely == 0.75, "A refined value should convert to its value type");
+static_assert(sizeof(Percent) == sizeof(int), "Refined should add no storage");
+static_assert(std::is_trivially_copyable_v<Probability>, "Refined should be trivially copyable");
+
+// Predicates
+static_assert(Positive{}(1) && !Positive{}(0), "Positive");
+static_assert(NonNegative{}(0) && !NonNegative{}(-1), "NonNegative");
+static_assert(NonZero{}(-3) && !NonZero{}(0), "NonZero");
+static_assert(Finite{}(1.0) && !Finite{}(std::numeric_limits<double>::infinity()) &&
+                  !Finite{}(std::numeric_limits<double>::quiet_NaN()),
+              "Finite");
+static_assert(LessThan<10>{}(9) && !LessThan<10>{}(10) && GreaterThan<10>{}(11), "Bounds");
+static_assert(Not<Positive>{}(0) && All<>{}(0), "Not and empty All");
+
+// Implied refinements convert without a check
+static_assert(implies_v<All<Finite, InRange<0, 1>>, Finite>, "A conjunction implies its conjuncts");
+static_assert(!implies_v<Finite, All<Finite, Positive>>, "A conjunct does not imply the conjunction");
+static_assert(std::is_convertible_v<Probability, Refined<double, Finite>>, "Probability should weaken to Finite");
+static_assert(!std::is_convertible_v<Refined<double, Finite>, Probability>, "Finite should not strengthen");
+static_assert(Refined<double, Finite>(likely).value() == 0.75, "Weakening should keep the value");
+
+// Runtime values cannot use the compile-time constructor
+static_assert(!std::is_constructible_v<Percent, std::optional<int>>, "Only values convert to Refined");
+
+// ============================================================================
+// Test Runtime Factories
+// ============================================================================
+
+namespace {
+
+auto test_factories() -> bool {
+    volatile int input = 42;
+    const auto ok = try_refine<InRange<0, 100>>(static_cast<int>(input));
+    const auto bad = try_refine<InRange<0, 100>>(static_cast<int>(input) * 10);
+    if (!ok || ok->value() != 42 || bad) {
+        return false;
+    }
+    try {
+        refine<Positive>(-static_cast<int>(input));
+        return false;
+    }
+    catch (const std::invalid_argument&) {
+    }
+    return refine<Positive>(static_cast<int>(input)).value() == 42;
+}
+
+// ============================================================================
+// Test Batch Validation
+// ============================================================================
+
+auto test_batch() -> bool {
+    std::vector<double> values(3 * refine_block + 17);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<double>(i % 100) / 100.0;
+    }
+
+    const auto all = refine_span<All<Finite, InRange<0, 1>>>(std::span<const double>(values));
+    if (all.size() != values.size() || all.data() != values.data() ||
+        all[refine_block + 3].value() != values[refine_block + 3]) {
+        return false;
+    }
+    // Iteration yields refined values that convert to weaker refinements without a check
+    double total = 0.0;
+    for (const Refined<double, Finite> x : all) {
+        total += x;
+    }
+    if (total != std::accumulate(values.begin(), values.end(), 0.0)) {
+        return false;
+    }
+
+    // The result stops at the first failing value
+    const std::size_t bad = 2 * refine_block + 5;
+    values[bad] = std::numeric_limits<double>::quiet_NaN();
+    values[bad + 1] = -1.0;
+    const auto prefix = refine_span<All<Finite, InRange<0, 1>>>(std::span<double>(values));
+    if (prefix.size() != bad) {
+        return false;
+    }
+
+    const std::vector<int> counts{3, 1, 0, 4};
+    const auto positive = refine_span<Positive>(std::span<const int>(counts));
+    return positive.size() == 2 && refine_span<NonNegative>(std::span<const int>(counts)).size() == counts.size() &&
+           refine_span<Positive>(std::span<const int>()).empty();
+}
+
+} // namespace
+
+int main() {
+    if (!test_factories() || !test_batch()) {
+        return 1;
+    }
+    return 0;
+}
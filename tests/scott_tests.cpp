@@ -0,0 +1,111 @@
+#include <cstddef>
+#include <type_traits>
+
+import typical.lambda;
+import typical.church;
+import typical.reducer;
+import typical.scott;
+
+using namespace typical;
+
+// ============================================================================
+// Test Scott Numerals
+// ============================================================================
+
+static_assert(scott::numeral_value_v<scott::numeral_t<5>> == 5, "numeral_t builds normal forms");
+static_assert(scott::numeral_value_v<App<scott::Pred, scott::numeral_t<5>>> == 4, "Pred 5 = 4");
+static_assert(scott::numeral_value_v<App<scott::Pred, scott::Zero>> == 0, "Pred 0 = 0");
+static_assert(scott::numeral_value_v<App<scott::Succ, App<scott::Succ, scott::Zero>>> == 2, "Succ (Succ 0) = 2");
+static_assert(std::is_same_v<normalize_t<App<scott::IsZero, scott::Zero>>, True>, "IsZero 0");
+static_assert(std::is_same_v<normalize_t<App<scott::IsZero, scott::numeral_t<3>>>, False>, "IsZero 3");
+
+// Pred takes the same steps for any numeral; the Church Pred rebuilds all n applications
+static_assert(Normalize<App<scott::Pred, scott::numeral_t<4>>>::steps ==
+                  Normalize<App<scott::Pred, scott::numeral_t<64>>>::steps,
+              "Scott Pred is constant");
+static_assert(Normalize<App<Pred, church_numeral_t<4>>>::steps < Normalize<App<Pred, church_numeral_t<64>>>::steps,
+              "Church Pred grows with n");
+static_assert(std::is_same_v<normalize_t<App<Pred, church_numeral_t<9>>>, church_numeral_t<8>>, "Church Pred 9 = 8");
+static_assert(std::is_same_v<normalize_t<App<Pred, Zero>>, Zero>, "Church Pred 0 = 0");
+
+// ============================================================================
+// Test Scott Lists
+// ============================================================================
+
+using Letters = scott::BuildList<Var<100>, Var<101>, Var<102>>;
+using ChurchLetters = BuildList<Var<100>, Var<101>, Var<102>>;
+
+static_assert(std::is_same_v<normalize_t<App<scott::Head, Letters>>, Var<100>>, "Head");
+static_assert(std::is_same_v<normalize_t<App<scott::Tail, Letters>>,
+                             normalize_t<scott::BuildList<Var<101>, Var<102>>>>,
+              "Tail");
+static_assert(std::is_same_v<normalize_t<App<scott::Tail, scott::Nil>>, scott::Nil>, "Tail Nil = Nil");
+static_assert(std::is_same_v<normalize_t<App<scott::IsNil, scott::Nil>>, True> &&
+                  std::is_same_v<normalize_t<App<scott::IsNil, Letters>>, False>,
+              "IsNil");
+static_assert(std::is_same_v<normalize_t<App<App<scott::Nth, Two>, Letters>>, Var<102>>, "Nth 2");
+static_assert(std::is_same_v<normalize_t<App<App<Nth, Two>, ChurchLetters>>, Var<102>>, "Church Nth 2");
+
+// Case analysis binds the constructor fields
+static_assert(std::is_same_v<normalize_t<scott::Case<Letters, Var<50>, Abs<Abs<App<Var<1>, Var<0>>>>>>,
+                             normalize_t<App<Var<100>, scott::BuildList<Var<101>, Var<102>>>>>,
+              "Case on Cons");
+static_assert(std::is_same_v<normalize_t<scott::Case<scott::MakeJust<Var<7>>, Var<50>, Id>>, Var<7>> &&
+                  std::is_same_v<normalize_t<scott::Case<scott::Nothing, Var<50>, Id>>, Var<50>>,
+              "Case on Maybe");
+static_assert(std::is_same_v<normalize_t<scott::Case<scott::MakeRight<Var<7>>, Abs<Var<50>>, Id>>, Var<7>>,
+              "Case on Either");
+
+// Tail reaches weak head normal form in constant steps; indexing grows linearly instead of quadratically
+using Long = scott::BuildList<Var<100>, Var<101>, Var<102>, Var<103>, Var<104>, Var<105>, Var<106>, Var<107>>;
+using ChurchLong = BuildList<Var<100>, Var<101>, Var<102>, Var<103>, Var<104>, Var<105>, Var<106>, Var<107>>;
+
+static_assert(Eval<App<scott::Tail, Long>>::steps == Eval<App<scott::Tail, Letters>>::steps,
+              "Scott Tail is constant");
+static_assert(Normalize<App<App<scott::Nth, church_numeral_t<6>>, Long>>::steps * 4 <
+                  Normalize<App<App<Nth, church_numeral_t<6>>, ChurchLong>>::steps,
+              "Scott indexing takes a fraction of the Church steps");
+
+// ============================================================================
+// Test Conversions
+// ============================================================================
+
+static_assert(std::is_same_v<normalize_t<App<scott::FromChurch, church_numeral_t<6>>>, scott::numeral_t<6>>,
+              "FromChurch");
+static_assert(std::is_same_v<normalize_t<App<scott::ToChurch, scott::numeral_t<6>>>, church_numeral_t<6>>,
+              "ToChurch");
+static_assert(std::is_same_v<normalize_t<App<scott::ToChurch, App<scott::FromChurch, Zero>>>, Zero>,
+              "Zero round-trips");
+static_assert(std::is_same_v<normalize_t<App<scott::FromChurchList, ChurchLetters>>, normalize_t<Letters>>,
+              "FromChurchList");
+static_assert(std::is_same_v<normalize_t<App<scott::ToChurchList, Letters>>, normalize_t<ChurchLetters>>,
+              "ToChurchList");
+
+namespace {
+
+// ============================================================================
+// Test Runtime Reduction
+// ============================================================================
+
+/// Reduce Term at runtime and compare with its type-level normal form
+template <typename Term>
+auto matches_type_level() -> bool {
+    TermGraph g;
+    GraphReducer reducer(g);
+    return term_equal(reducer.normalize(reify<Term>(g)), reify<normalize_t<Term>>(g));
+}
+
+auto test_runtime() -> bool {
+    return matches_type_level<App<App<scott::Nth, church_numeral_t<5>>, Long>>() &&
+           matches_type_level<App<scott::ToChurchList, Long>>() &&
+           matches_type_level<App<scott::ToChurch, App<scott::FromChurch, church_numeral_t<30>>>>();
+}
+
+} // namespace
+
+int main() {
+    if (!test_runtime()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+import typical.lambda;
+import typical.church;
+import typical.reducer;
+import typical.serialize;
+
+using namespace typical;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+/// A term containing Term twice: Pair Term Term
+template <typename Term>
+using Twice = App<App<Abs<Abs<Abs<App<App<Var<0>, Var<2>>, Var<1>>>>>, Term>, Term>;
+
+template <typename Term>
+auto round_trips(const TermCorpus& corpus, std::size_t root) -> bool {
+    TermGraph g;
+    TermLoader loader(g);
+    return term_equal(loader.load(corpus.root(root)), reify<Term>(g));
+}
+
+auto throws_on_open(std::span<const std::byte> data) -> bool {
+    try {
+        TermCorpus corpus(data);
+        return false;
+    }
+    catch (const std::runtime_error&) {
+        return true;
+    }
+}
+
+// ============================================================================
+// Test Round Trip
+// ============================================================================
+
+auto test_round_trip() -> bool {
+    using Deep = App<Var<300>, Abs<Var<1000>>>;
+    TermWriter writer;
+    writer.add<Id>();
+    writer.add<Omega>();
+    writer.add<Twice<church_numeral_t<40>>>();
+    writer.add<Deep>();
+    const auto data = writer.bytes();
+    const TermCorpus corpus{std::span<const std::byte>(data)};
+    return corpus.size() == 4 && corpus.shared() == 1 && round_trips<Id>(corpus, 0) &&
+           round_trips<Omega>(corpus, 1) && round_trips<Twice<church_numeral_t<40>>>(corpus, 2) &&
+           round_trips<Deep>(corpus, 3);
+}
+
+// ============================================================================
+// Test Sharing
+// ============================================================================
+
+auto test_sharing() -> bool {
+    TermWriter shared;
+    shared.add<Twice<church_numeral_t<200>>>();
+    TermWriter inlined(WriteOptions{UINT32_MAX});
+    inlined.add<Twice<church_numeral_t<200>>>();
+    const auto small = shared.bytes();
+    const auto large = inlined.bytes();
+    if (small.size() * 3 / 2 > large.size()) {
+        return false;
+    }
+
+    // Both occurrences resolve to the same entry and load as one node
+    const TermCorpus corpus{std::span<const std::byte>(small)};
+    const TermCursor pair = corpus.root(0);
+    TermGraph g;
+    TermLoader loader(g);
+    const TermNode* term = loader.load(pair);
+    if (pair.func().arg().entry() != pair.arg().entry() || !pair.arg().entry().has_value() ||
+        term->left->right != term->right) {
+        return false;
+    }
+
+    // A repeated subterm of 2^32 + 1 nodes is still shared rather than wrapping to a small size
+    TermGraph dag;
+    const TermNode* t = dag.var(0);
+    for (int i = 0; i < 31; ++i) {
+        t = dag.app(t, t);
+    }
+    const TermNode* huge = dag.app(t, dag.var(0));
+    TermWriter writer;
+    writer.add(dag.app(huge, huge));
+    const auto bytes = writer.bytes();
+    // The doublings of 15 to 2^31 - 1 nodes, each used twice, and huge
+    return TermCorpus{std::span<const std::byte>(bytes)}.shared() == 28 + 1;
+}
+
+// ============================================================================
+// Test Cursor
+// ============================================================================
+
+auto test_cursor() -> bool {
+    TermWriter writer;
+    writer.add<church_numeral_t<500>>();
+    writer.add<Two>();
+    writer.add<Succ>();
+    const auto data = writer.bytes();
+    const TermCorpus corpus{std::span<const std::byte>(data)};
+
+    std::size_t nodes = 0;
+    visit(corpus.root(0), [&](const TermCursor&) { ++nodes; });
+    return nodes == 1003 && church_value(corpus.root(0)) == 500 && church_value(corpus.root(1)) == 2 &&
+           !church_value(corpus.root(2)).has_value();
+}
+
+// ============================================================================
+// Test File
+// ============================================================================
+
+auto test_file() -> bool {
+    const auto path = std::filesystem::temp_directory_path() / "typical_serialize_tests.tlam";
+    TermWriter writer;
+    writer.add<Twice<church_numeral_t<64>>>();
+    writer.write(path);
+
+    bool ok = false;
+    {
+        const TermCorpus corpus = TermCorpus::open(path);
+        TermGraph g;
+        GraphReducer reducer(g);
+        TermLoader loader(g);
+        ok = corpus.size() == 1 && term_equal(reducer.normalize(loader.load(corpus.root(0))),
+                                              reify<normalize_t<Twice<church_numeral_t<64>>>>(g));
+    }
+    std::filesystem::remove(path);
+    return ok;
+}
+
+// ============================================================================
+// Test Corrupt Input
+// ============================================================================
+
+auto test_corrupt() -> bool {
+    TermWriter writer;
+    writer.add<Twice<church_numeral_t<20>>>();
+    auto data = writer.bytes();
+
+    auto bad_magic = data;
+    bad_magic[0] = std::byte{'X'};
+    auto bad_version = data;
+    bad_version[4] = std::byte{2};
+    auto bad_count = data;
+    bad_count[8] = std::byte{0xff};
+    const std::vector<std::byte> short_header(data.begin(), data.begin() + 10);
+    if (!throws_on_open(bad_magic) || !throws_on_open(bad_version) || !throws_on_open(bad_count) ||
+        !throws_on_open(short_header)) {
+        return false;
+    }
+
+    // A truncated code section is caught when the cursor reaches it
+    data.resize(data.size() - 4);
+    const TermCorpus corpus{std::span<const std::byte>(data)};
+    try {
+        visit(corpus.root(0), [](const TermCursor&) {});
+        return false;
+    }
+    catch (const std::out_of_range&) {
+    }
+
+    // Entry 0 = Abs (Ref 0) refers to itself through a node; visiting or loading it must not loop
+    std::vector<std::byte> cyclic(TermCodec::header_bytes + 16);
+    std::memcpy(cyclic.data(), TermCodec::magic, 4);
+    cyclic[4] = std::byte{TermCodec::version};
+    TermCodec::put_u64(cyclic.data() + 8, 1);
+    TermCodec::put_u64(cyclic.data() + 16, 1);
+    TermCodec::put_u64(cyclic.data() + TermCodec::header_bytes, cyclic.size());
+    TermCodec::put_u64(cyclic.data() + TermCodec::header_bytes + 8, cyclic.size() + 2);
+    // Root: Ref 0. Entry 0: Abs (Ref 0)
+    const std::uint8_t code[] = {TermCodec::op_ref, 0, TermCodec::op_abs, TermCodec::op_ref, 0};
+    for (const std::uint8_t op : code) {
+        cyclic.push_back(static_cast<std::byte>(op));
+    }
+    const TermCorpus looped{std::span<const std::byte>(cyclic)};
+    try {
+        visit(looped.root(0), [](const TermCursor&) {});
+        return false;
+    }
+    catch (const std::out_of_range&) {
+    }
+    try {
+        TermGraph graph;
+        TermLoader(graph).load(looped.root(0));
+        return false;
+    }
+    catch (const std::out_of_range&) {
+        return cyclic.size() == 45;
+    }
+}
+
+} // namespace
+
+int main() {
+    if (!test_round_trip()) {
+        return 1;
+    }
+    if (!test_sharing()) {
+        return 1;
+    }
+    if (!test_cursor()) {
+        return 1;
+    }
+    if (!test_file()) {
+        return 1;
+    }
+    if (!test_corrupt()) {
+        return 1;
+    }
+    return 0;
+}
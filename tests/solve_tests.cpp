@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+import typical.calculus;
+import typical.solve;
+
+using namespace typical;
+
+// x^2 - 2
+using Square = Sub<Mul<X, X>, C_<2>>;
+
+// cos x - x
+using Dottie = Sub<Cos<X>, X>;
+
+// x^2 + 1, no real roots
+using NoRoot = Add<Mul<X, X>, C_<1>>;
+
+// ============================================================================
+// Test Single Roots
+// ============================================================================
+
+static_assert(magnitude(find_root<Square>(1.0).x - 1.4142135623730951) < 1e-15, "Newton finds sqrt 2");
+static_assert(magnitude(find_root<Square, RootMethod::Halley>(-3.0).x + 1.4142135623730951) < 1e-15,
+              "Halley finds -sqrt 2");
+static_assert(find_root<Square, RootMethod::Halley>(3.0).iterations < find_root<Square>(3.0).iterations,
+              "Halley converges in fewer iterations");
+static_assert(!find_root<NoRoot>(0.5, SolveOptions{.max_iterations = 20}).converged, "x^2 + 1 has no real root");
+static_assert(find_root<Square>(1.0, SolveOptions{.max_iterations = 0}).iterations == 0 &&
+                  find_root<Square>(1.0, SolveOptions{.max_iterations = 0}).x == 1.0,
+              "No iterations run at a limit of 0");
+
+namespace {
+
+bool near(double a, double b) { return std::fabs(a - b) <= 1e-12 * (1.0 + std::fabs(b)); }
+
+std::vector<double> spread(std::size_t n, double lo, double hi) {
+    std::vector<double> xs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        xs[i] = lo + (hi - lo) * (static_cast<double>(i) + 0.5) / static_cast<double>(n);
+    }
+    return xs;
+}
+
+// ============================================================================
+// Test Batches
+// ============================================================================
+
+template <typename E, RootMethod Method>
+bool matches_scalar(const std::vector<double>& starts) {
+    std::vector<double> roots(starts.size());
+    const SolveStats stats = find_roots<E, Method>(starts, roots);
+    std::size_t converged = 0;
+    std::size_t iterations = 0;
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        const Root root = find_root<E, Method>(starts[i]);
+        converged += root.converged;
+        iterations += root.iterations;
+        if (root.converged ? !near(roots[i], root.x) : !std::isnan(roots[i])) {
+            return false;
+        }
+    }
+    return stats.points == starts.size() && stats.converged == converged && stats.iterations == iterations;
+}
+
+bool test_square() {
+    // Starts of both signs, near 0 where Newton overshoots far, and a count that leaves a partial block
+    const auto starts = spread(1000, -50.0, 50.0);
+    std::vector<double> roots(starts.size());
+    const SolveStats stats = find_roots<Square, RootMethod::Halley>(starts, roots);
+    if (stats.converged != starts.size() || stats.max_iterations > 12) {
+        return false;
+    }
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        if (!near(roots[i], std::copysign(std::sqrt(2.0), starts[i]))) {
+            return false;
+        }
+    }
+    return matches_scalar<Square, RootMethod::Newton>(starts) && matches_scalar<Square, RootMethod::Halley>(starts);
+}
+
+bool test_transcendental() {
+    const auto starts = spread(700, -0.5, 2.0);
+    std::vector<double> roots(starts.size());
+    const SolveStats stats = find_roots<Dottie>(starts, roots);
+    for (double r : roots) {
+        if (!near(r, 0.7390851332151607)) {
+            return false;
+        }
+    }
+    std::vector<double> fast(starts.size());
+    find_roots<Dottie, RootMethod::Newton, accuracy::Fast>(starts, fast, SolveOptions{.tolerance = 1e-6});
+    for (double r : fast) {
+        if (std::fabs(r - 0.7390851332151607) > 1e-6) {
+            return false;
+        }
+    }
+    return stats.converged == starts.size() && matches_scalar<Dottie, RootMethod::Halley>(starts);
+}
+
+bool test_failures() {
+    // Every lane of NoRoot runs to the iteration limit; the lane at 0 of Square escapes on the first step
+    const auto starts = spread(300, -3.0, 3.0);
+    std::vector<double> roots(starts.size());
+    const SolveStats stats = find_roots<NoRoot>(starts, roots, SolveOptions{.max_iterations = 30});
+    for (double r : roots) {
+        if (!std::isnan(r)) {
+            return false;
+        }
+    }
+    const std::vector<double> zero = {1.0, 0.0, -1.0};
+    std::vector<double> square(3);
+    const SolveStats escaped = find_roots<Square>(zero, square);
+    return stats.converged == 0 && stats.iterations == 30 * starts.size() && escaped.converged == 2 &&
+           std::isnan(square[1]) && near(square[0], std::sqrt(2.0)) && !find_root<Square>(0.0).converged &&
+           !find_root<Square, RootMethod::Halley>(0.0).converged &&
+           matches_scalar<NoRoot, RootMethod::Newton>(starts);
+}
+
+bool test_empty() {
+    const std::vector<double> none;
+    std::vector<double> roots;
+    const SolveStats stats = find_roots<Square>(none, roots);
+    if (stats.points != 0 || stats.iterations != 0) {
+        return false;
+    }
+
+    // A limit of 0 runs no step, as in find_root, so no point converges
+    const auto starts = spread(300, 1.0, 2.0);
+    std::vector<double> unsolved(starts.size(), 0.0);
+    const SolveStats zero = find_roots<Square>(starts, unsolved, SolveOptions{.max_iterations = 0});
+    return zero.converged == 0 && zero.iterations == 0 &&
+           std::all_of(unsolved.begin(), unsolved.end(), [](double r) { return std::isnan(r); });
+}
+
+} // namespace
+
+int main() {
+    if (!test_square() || !test_transcendental() || !test_failures() || !test_empty()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+import typical.calculus;
+import typical.pool;
+import typical.stream;
+
+using namespace typical;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+auto temp_path(const char* name) -> std::filesystem::path {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+void write_column(const std::filesystem::path& path, const std::vector<double>& values) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    for (double v : values) {
+        std::byte bytes[sizeof(double)];
+        store_le(bytes, v);
+        file.write(reinterpret_cast<const char*>(bytes), sizeof bytes);
+    }
+}
+
+auto read_column(const std::filesystem::path& path) -> std::vector<double> {
+    const auto mapped = MappedFile::open_read(path);
+    std::vector<double> values(mapped.size() / sizeof(double));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = load_le(mapped.data() + i * sizeof(double));
+    }
+    return values;
+}
+
+// ============================================================================
+// Test Work-Stealing Pool
+// ============================================================================
+
+auto test_pool() -> bool {
+    WorkStealingPool pool(4);
+    std::atomic<std::size_t> sum{0};
+    pool.parallel_for(0, 10000, 7, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            sum.fetch_add(i, std::memory_order_relaxed);
+        }
+    });
+    if (sum != 10000 * 9999 / 2) {
+        return false;
+    }
+
+    // Tasks submitted from a worker land on its own deque and are stolen by the others
+    std::atomic<int> leaves{0};
+    pool.submit([&] {
+        for (int i = 0; i < 64; ++i) {
+            pool.submit([&] { leaves.fetch_add(1); });
+        }
+    });
+    pool.wait();
+    if (leaves != 64) {
+        return false;
+    }
+
+    // parallel_for from inside a task waits only for its own blocks, even with a single worker
+    WorkStealingPool single(1);
+    std::atomic<std::size_t> nested{0};
+    single.submit([&] {
+        single.parallel_for(0, 100, 3, [&](std::size_t begin, std::size_t end) { nested.fetch_add(end - begin); });
+    });
+    single.wait();
+    return nested == 100;
+}
+
+// ============================================================================
+// Test Streaming Evaluation
+// ============================================================================
+
+auto test_stream() -> bool {
+    using F = Add<Mul<C_<2>, Sin<X>>, C_<1>>;
+
+    const auto in = temp_path("typical_stream_in.f64");
+    const auto out = temp_path("typical_stream_out.f64");
+
+    std::vector<double> xs(100003);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = 0.001 * static_cast<double>(i);
+    }
+    write_column(in, xs);
+
+    StreamOptions options;
+    options.chunk_bytes = 4096;
+    options.threads = 3;
+    const auto stats = stream_evaluate<F>(in, out, options);
+
+    bool ok = stats.samples == xs.size() && stats.threads == 3 && stats.chunks == (xs.size() + 511) / 512;
+    const auto ys = read_column(out);
+    ok = ok && ys.size() == xs.size();
+    for (std::size_t i = 0; ok && i < ys.size(); ++i) {
+        ok = ys[i] == 2.0 * std::sin(xs[i]) + 1.0;
+    }
+
+    std::filesystem::remove(in);
+    std::filesystem::remove(out);
+    return ok;
+}
+
+auto test_empty_stream() -> bool {
+    const auto in = temp_path("typical_stream_empty_in.f64");
+    const auto out = temp_path("typical_stream_empty_out.f64");
+    write_column(in, {});
+
+    const auto stats = stream_evaluate<X>(in, out);
+    const bool ok = stats.samples == 0 && std::filesystem::file_size(out) == 0;
+
+    std::filesystem::remove(in);
+    std::filesystem::remove(out);
+    return ok;
+}
+
+auto test_in_place_stream() -> bool {
+    const auto in = temp_path("typical_stream_in_place.f64");
+    write_column(in, {1.0, 2.0, 3.0});
+
+    // Writing over the input is refused before anything is truncated
+    bool threw = false;
+    try {
+        stream_evaluate<X>(in, in.parent_path() / "." / in.filename());
+    }
+    catch (const std::system_error&) {
+        threw = true;
+    }
+    const bool ok = threw && read_column(in) == std::vector<double>{1.0, 2.0, 3.0};
+
+    std::filesystem::remove(in);
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    if (!test_pool()) {
+        return 1;
+    }
+    if (!test_stream()) {
+        return 1;
+    }
+    if (!test_empty_stream() || !test_in_place_stream()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+import typical.eq;
+import typical.nat;
+import typical.fin;
+import typical.vec;
+
+using namespace typical;
+
+// ============================================================================
+// Test Length Types
+// ============================================================================
+
+using Big = nat::nat_t<1000>;
+
+static_assert(Vec<int, nat::Three>::extent == 3, "Vec<int, nat::Three> should hold three elements");
+static_assert(std::is_same_v<decltype(append(Vec<int, nat::Two>(), Vec<int, nat::Three>())), Vec<int, nat::Five>>,
+              "append should add lengths");
+static_assert(std::is_same_v<decltype(split_at<nat::Two>(Vec<int, nat::Five>())),
+                             std::pair<Vec<int, nat::Two>, Vec<int, nat::Three>>>,
+              "split_at should subtract lengths");
+static_assert(std::is_same_v<decltype(zip(Vec<int, nat::Three>(), Vec<char, nat::Three>())), Vec<std::pair<int, char>, nat::Three>>,
+              "zip should keep the length");
+static_assert(std::is_same_v<decltype(concat(Vec<Vec<int, nat::Three>, nat::Two>())), Vec<int, nat::Six>>,
+              "concat should multiply lengths");
+
+// Mismatched lengths do not type-check
+template <typename A, typename B>
+concept Zippable = requires(A a, B b) { zip(std::move(a), std::move(b)); };
+static_assert(Zippable<Vec<int, nat::Two>, Vec<int, nat::Two>>, "Equal lengths zip");
+static_assert(!Zippable<Vec<int, nat::Two>, Vec<int, nat::Three>>, "Different lengths do not zip");
+
+template <typename K, typename V>
+concept Splittable = requires(V v) { split_at<K>(std::move(v)); };
+static_assert(Splittable<nat::Three, Vec<int, nat::Three>> && !Splittable<nat::Four, Vec<int, nat::Three>>,
+              "split_at needs K <= N");
+
+namespace {
+
+// ============================================================================
+// Test Operations
+// ============================================================================
+
+auto test_operations() -> bool {
+    auto left = Vec<int, nat::Two>::generate([](Fin<nat::Two> i) { return static_cast<int>(i.value()); });
+    auto right = Vec<int, nat::Three>::generate([](Fin<nat::Three> i) { return 10 + static_cast<int>(i.value()); });
+    auto joined = append(std::move(left), std::move(right));
+    const int* joined_buffer = joined.data();
+    if (joined[fin_v<1, nat::Five>] != 1 || joined[fin_v<4, nat::Five>] != 12) {
+        return false;
+    }
+
+    // The sum commutes, so the appended vector can be transported to the other order
+    auto swapped = append(Vec<int, nat::Three>(7), Vec<int, nat::Two>(8));
+    const int* swapped_buffer = swapped.data();
+    using Commuted = nat::AddCommutative<nat::Three, nat::Two>;
+    auto transported = std::move(swapped).transport<nat::add_t<nat::Two, nat::Three>, typename Commuted::Proof::type>();
+    if (transported.data() != swapped_buffer || transported[fin_v<0, nat::Five>] != 7) {
+        return false;
+    }
+
+    auto [front, back] = split_at<nat::Two>(std::move(joined));
+    if (front.data() != joined_buffer || front[fin_v<1, nat::Two>] != 1 || back[fin_v<0, nat::Three>] != 10) {
+        return false;
+    }
+
+    auto names = Vec<std::string, nat::Three>::generate([](Fin<nat::Three> i) { return std::string(i.value() + 1, 'x'); });
+    const auto pairs = zip(std::move(back), std::move(names));
+    if (pairs[fin_v<2, nat::Three>].first != 12 || pairs[fin_v<2, nat::Three>].second != "xxx") {
+        return false;
+    }
+
+    auto rows = Vec<Vec<int, nat::Three>, nat::Two>::generate([](Fin<nat::Two> r) {
+        return Vec<int, nat::Three>::generate([&](Fin<nat::Three> c) { return static_cast<int>(3 * r.value() + c.value()); });
+    });
+    const auto flat = concat(std::move(rows));
+    for (const Fin<nat::Six> i : fin_range<nat::Six>()) {
+        if (flat[i] != static_cast<int>(i.value())) {
+            return false;
+        }
+    }
+
+    if (Vec<int, nat::Three>::check(std::vector<int>{1, 2})) {
+        return false;
+    }
+    const auto checked = Vec<int, nat::Three>::check(std::vector<int>{1, 2, 3});
+    return checked && checked->view()[fin_v<2, nat::Three>] == 3;
+}
+
+/// Element that counts how often it is default-constructed or copied
+struct Counted {
+    static inline int made = 0;
+    int value = 0;
+
+    Counted() { ++made; }
+    explicit Counted(int v) : value(v) {}
+    Counted(const Counted& other) : value(other.value) { ++made; }
+    Counted(Counted&&) noexcept = default;
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) noexcept = default;
+};
+
+auto test_moves() -> bool {
+    // Moves, transports and splits hand buffers over without creating a single element
+    auto left = Vec<Counted, Big>::generate([](Fin<Big> i) { return Counted(static_cast<int>(i.value())); });
+    auto right = Vec<Counted, Big>::generate([](Fin<Big>) { return Counted(-1); });
+    Counted::made = 0;
+    auto joined = append(std::move(left), std::move(right));
+    using Twice = nat::add_t<Big, Big>;
+    using Commuted = nat::AddCommutative<Big, Big>;
+    auto transported = std::move(joined).transport<Twice, typename Commuted::Proof::type>();
+    auto [front, back] = split_at<Big>(std::move(transported));
+    auto moved = std::move(front);
+    if (Counted::made != 0 || moved[fin_v<999, Big>].value != 999 || back[fin_v<0, Big>].value != -1) {
+        return false;
+    }
+
+    // A moved-from Vec can be assigned again
+    front = std::move(back);
+    return front[fin_v<1, Big>].value == -1 && Counted::made == 0;
+}
+
+auto test_batch() -> bool {
+    // One length check at the boundary, none in the pipeline
+    std::vector<double> raw(1000, 0.5);
+    auto batch = Vec<double, Big>::check(std::move(raw));
+    if (!batch) {
+        return false;
+    }
+    auto doubled = append(std::move(*batch), Vec<double, Big>(1.5));
+    auto [head, tail] = split_at<Big>(std::move(doubled));
+    double total = 0.0;
+    for (const auto& [a, b] : zip(std::move(head), std::move(tail))) {
+        total += a * b;
+    }
+    return total == 750.0;
+}
+
+} // namespace
+
+int main() {
+    if (!test_operations() || !test_moves() || !test_batch()) {
+        return 1;
+    }
+    return 0;
+}